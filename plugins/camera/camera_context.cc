@@ -16,24 +16,46 @@
 
 #include "camera_context.h"
 
-#include <sstream>
+#include <algorithm>
+#include <filesystem>
 
 #include <flutter/event_channel.h>
 #include <flutter/event_stream_handler_functions.h>
 #include <flutter/standard_message_codec.h>
 
 #include <libcamera/control_ids.h>
+#include <libcamera/formats.h>
 #include <libcamera/property_ids.h>
 
 #include <utility>
 
 #include <plugins/common/common.h>
+#include <plugins/common/egl/context_guard.h>
 
 namespace camera_plugin {
 
 static constexpr char kPictureCaptureExtension[] = "jpeg";
 static constexpr char kVideoCaptureExtension[] = "mp4";
 
+static constexpr char kResolutionPresetValueLow[] = "low";
+static constexpr char kResolutionPresetValueMedium[] = "medium";
+static constexpr char kResolutionPresetValueHigh[] = "high";
+static constexpr char kResolutionPresetValueVeryHigh[] = "veryHigh";
+static constexpr char kResolutionPresetValueUltraHigh[] = "ultraHigh";
+static constexpr char kResolutionPresetValueMax[] = "max";
+
+// Formats the JPEG worker accepts for the still stream, most preferred first.
+static constexpr libcamera::PixelFormat kStillFormats[] = {
+    libcamera::formats::NV12, libcamera::formats::YUYV,
+    libcamera::formats::BGR888, libcamera::formats::RGB888};
+
+static constexpr char kCaptureErrorCode[] = "capture_failed";
+
+// Requests kept in flight.  The preview holds one while it is drawn and the
+// recorder up to VideoRecorder::kMaxFramesInFlight.
+static constexpr unsigned int kMinBufferCount =
+    4 + VideoRecorder::kMaxFramesInFlight;
+
 using namespace plugin_common;
 
 CameraContext::CameraContext(std::string cameraName,
@@ -81,10 +103,30 @@ CameraContext::CameraContext(std::string cameraName,
 
 CameraContext::~CameraContext() {
   SPDLOG_DEBUG("[camera_plugin] ~CameraContext()");
+  Dispose();
   mCamera->release();
   mCameraState = CAM_STATE_AVAILABLE;
 }
 
+void CameraContext::Dispose() {
+  // Returns every frame held by the encoder before the pool is freed.
+  stopVideoRecording();
+  StopStreaming();
+  if (!mPreview.is_initialized) {
+    return;
+  }
+  texture_registrar_->UnregisterTexture(mPreview.textureId);
+  {
+    std::lock_guard lock(mStreamMutex);
+    texture_registrar_->TextureMakeCurrent();
+    mPreview.renderer.reset();
+    texture_registrar_->TextureClearCurrent();
+  }
+  mPreview.gpu_surface_texture.reset();
+  mPreview.textureId = 0;
+  mPreview.is_initialized = false;
+}
+
 void CameraContext::setCamera(std::shared_ptr<libcamera::Camera> camera) {
   mCamera = std::move(camera);
 }
@@ -112,40 +154,20 @@ std::string CameraContext::Initialize(
       "[camera_plugin] Initialize: cameraId: {}, imageFormatGroup: [{}]",
       camera_id, mImageFormatGroup);
 
-  mPreview.width = 640;
-  mPreview.height = 480;
-
-  /// Setup GL Texture 2D
-  texture_registrar_->TextureMakeCurrent();
-  glGenFramebuffers(1, &mPreview.framebuffer);
-  glBindFramebuffer(GL_FRAMEBUFFER, mPreview.framebuffer);
-
-  glGenTextures(1, &mPreview.textureId);
-  glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
-  glClear(GL_COLOR_BUFFER_BIT);
-
-  glBindTexture(GL_TEXTURE_2D, mPreview.textureId);
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, mPreview.width, mPreview.height, 0,
-               GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
-                         mPreview.textureId, 0);
-
-  if (auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-      status != GL_FRAMEBUFFER_COMPLETE) {
-    spdlog::error("[camera_plugin] FramebufferStatus: 0x{:X}", status);
+  if (!ConfigureStreams()) {
+    return {};
   }
 
-  glFinish();
-
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  const libcamera::StreamConfiguration& stream_config = mConfig->at(0);
+  mPreview.width = static_cast<GLsizei>(stream_config.size.width);
+  mPreview.height = static_cast<GLsizei>(stream_config.size.height);
 
+  texture_registrar_->TextureMakeCurrent();
+  mPreview.renderer = std::make_unique<PreviewRenderer>(
+      stream_config.pixelFormat, mPreview.width, mPreview.height,
+      stream_config.stride);
   texture_registrar_->TextureClearCurrent();
+  mPreview.textureId = mPreview.renderer->textureId;
 
   mPreview.descriptor = {
       .struct_size = sizeof(FlutterDesktopGpuSurfaceDescriptor),
@@ -163,12 +185,16 @@ std::string CameraContext::Initialize(
       kFlutterDesktopGpuSurfaceTypeGlTexture2D,
       [&](size_t /* width */,
           size_t /* height */) -> const FlutterDesktopGpuSurfaceDescriptor* {
-        return &mPreview.descriptor;
+        return ObtainDescriptor();
       });
 
   flutter::TextureVariant texture = *mPreview.gpu_surface_texture;
   texture_registrar_->RegisterTexture(&texture);
-  texture_registrar_->MarkTextureFrameAvailable(mPreview.textureId);
+  mPreview.is_initialized = true;
+
+  if (!StartStreaming()) {
+    spdlog::error("[camera_plugin] Failed to start viewfinder stream");
+  }
 
   auto props = mCamera->properties();
 
@@ -196,63 +222,523 @@ std::string CameraContext::Initialize(
                {flutter::EncodableValue("focusPointSupported"),
                 flutter::EncodableValue(focus_point_supported)}}))));
 
-  mPreview.is_initialized = true;
-
   return channel_name;
 }
 
+libcamera::Size CameraContext::GetPresetSize(
+    const libcamera::StreamConfiguration& config) const {
+  if (mResolutionPreset == kResolutionPresetValueLow) {
+    return {320, 240};
+  }
+  if (mResolutionPreset == kResolutionPresetValueMedium) {
+    return {720, 480};
+  }
+  if (mResolutionPreset == kResolutionPresetValueHigh) {
+    return {1280, 720};
+  }
+  if (mResolutionPreset == kResolutionPresetValueVeryHigh) {
+    return {1920, 1080};
+  }
+  if (mResolutionPreset == kResolutionPresetValueUltraHigh) {
+    return {3840, 2160};
+  }
+  if (mResolutionPreset == kResolutionPresetValueMax) {
+    if (const auto sizes = config.formats().sizes(config.pixelFormat);
+        !sizes.empty()) {
+      return sizes.back();
+    }
+  }
+  return {640, 480};
+}
+
+bool CameraContext::GenerateConfiguration(const bool with_still) {
+  std::vector roles{libcamera::StreamRole::Viewfinder};
+  if (with_still) {
+    roles.push_back(libcamera::StreamRole::StillCapture);
+  }
+  mConfig = mCamera->generateConfiguration(roles);
+  if (!mConfig || mConfig->size() != roles.size()) {
+    return false;
+  }
+
+  libcamera::StreamConfiguration& config = mConfig->at(0);
+
+  // Prefer formats the GPU converts cheaply; RGB covers virtual cameras.
+  const auto formats = config.formats().pixelformats();
+  for (const auto& format :
+       {libcamera::formats::NV12, libcamera::formats::YUYV,
+        libcamera::formats::BGR888, libcamera::formats::RGB888}) {
+    if (std::find(formats.begin(), formats.end(), format) != formats.end()) {
+      config.pixelFormat = format;
+      break;
+    }
+  }
+  config.size = GetPresetSize(config);
+  config.bufferCount = std::max(config.bufferCount, kMinBufferCount);
+
+  if (with_still) {
+    // Stills are taken at the largest size in a format encoded without
+    // conversion.
+    libcamera::StreamConfiguration& still = mConfig->at(1);
+    const auto still_formats = still.formats().pixelformats();
+    for (const auto& format : kStillFormats) {
+      if (std::find(still_formats.begin(), still_formats.end(), format) !=
+          still_formats.end()) {
+        still.pixelFormat = format;
+        break;
+      }
+    }
+    if (const auto sizes = still.formats().sizes(still.pixelFormat);
+        !sizes.empty()) {
+      still.size = sizes.back();
+    }
+  }
+
+  switch (mConfig->validate()) {
+    case libcamera::CameraConfiguration::Valid:
+      break;
+    case libcamera::CameraConfiguration::Adjusted:
+      spdlog::debug("[camera_plugin] Configuration adjusted to {}",
+                    mConfig->at(0).toString());
+      break;
+    case libcamera::CameraConfiguration::Invalid:
+      return false;
+  }
+
+  if (!PreviewRenderer::IsSupported(config.pixelFormat)) {
+    spdlog::error("[camera_plugin] Unsupported viewfinder format: {}",
+                  config.pixelFormat.toString());
+    return false;
+  }
+  return !with_still || JpegWorker::IsSupported(mConfig->at(1).pixelFormat);
+}
+
+bool CameraContext::ConfigureStreams() {
+  // Not every pipeline can run a still stream next to the viewfinder; stills
+  // then come from the viewfinder.
+  const bool with_still = GenerateConfiguration(true);
+  if (!with_still && !GenerateConfiguration(false)) {
+    spdlog::error("[camera_plugin] No viewfinder configuration for {}",
+                  mCamera->id());
+    return false;
+  }
+
+  if (const auto res = mCamera->configure(mConfig.get()); res != 0) {
+    spdlog::error("[camera_plugin] Failed to configure camera: {}",
+                  strerror(-res));
+    return false;
+  }
+  mCameraState = CAM_STATE_CONFIGURED;
+  mViewfinderStream = mConfig->at(0).stream();
+  mStillStream = with_still ? mConfig->at(1).stream() : nullptr;
+
+  spdlog::debug("[camera_plugin] Viewfinder: {}, stride: {}",
+                mConfig->at(0).toString(), mConfig->at(0).stride);
+  if (mStillStream) {
+    spdlog::debug("[camera_plugin] Still: {}, stride: {}",
+                  mConfig->at(1).toString(), mConfig->at(1).stride);
+  }
+  return true;
+}
+
+bool CameraContext::StartStreaming() {
+  if (mCameraState != CAM_STATE_CONFIGURED) {
+    return false;
+  }
+
+  mAllocator = std::make_unique<libcamera::FrameBufferAllocator>(mCamera);
+  if (mAllocator->allocate(mViewfinderStream) < 0) {
+    spdlog::error("[camera_plugin] Failed to allocate buffers");
+    mAllocator.reset();
+    return false;
+  }
+
+  if (mStillStream && mAllocator->allocate(mStillStream) < 0) {
+    spdlog::error("[camera_plugin] Failed to allocate still buffers");
+    StopStreaming();
+    return false;
+  }
+
+  // Viewfinder requests are queued on start; still requests only when a
+  // picture is taken.
+  for (const auto stream : {mViewfinderStream, mStillStream}) {
+    if (stream == nullptr) {
+      continue;
+    }
+    for (const auto& buffer : mAllocator->buffers(stream)) {
+      auto mapped = std::make_unique<MappedFrameBuffer>(buffer.get());
+      if (!mapped->isValid()) {
+        StopStreaming();
+        return false;
+      }
+      mMappedBuffers[buffer.get()] = std::move(mapped);
+
+      auto request = mCamera->createRequest();
+      if (!request || request->addBuffer(stream, buffer.get()) < 0) {
+        spdlog::error("[camera_plugin] Failed to create request");
+        StopStreaming();
+        return false;
+      }
+      if (stream == mStillStream) {
+        mFreeStillRequests.push_back(request.get());
+      }
+      mRequests.push_back(std::move(request));
+    }
+  }
+
+  if (!mJpegWorker) {
+    mJpegWorker = std::make_unique<JpegWorker>();
+  }
+
+  libcamera::ControlList controls(libcamera::controls::controls);
+  if (mFps > 0 && mCamera->controls().find(
+                      &libcamera::controls::FrameDurationLimits) !=
+                      mCamera->controls().end()) {
+    const int64_t frame_time = 1000000 / mFps;
+    controls.set(libcamera::controls::FrameDurationLimits,
+                 libcamera::Span<const int64_t, 2>({frame_time, frame_time}));
+  }
+
+  mCamera->requestCompleted.connect(this, &CameraContext::OnRequestCompleted);
+  if (const auto res = mCamera->start(&controls); res != 0) {
+    spdlog::error("[camera_plugin] Failed to start camera: {}",
+                  strerror(-res));
+    mCamera->requestCompleted.disconnect(this);
+    StopStreaming();
+    return false;
+  }
+  mCameraState = CAM_STATE_RUNNING;
+
+  for (const auto& request : mRequests) {
+    if (request->findBuffer(mViewfinderStream) == nullptr) {
+      continue;
+    }
+    if (const auto res = mCamera->queueRequest(request.get()); res != 0) {
+      spdlog::error("[camera_plugin] Failed to queue request: {}",
+                    strerror(-res));
+    }
+  }
+  return true;
+}
+
+void CameraContext::StopStreaming() {
+  std::lock_guard stream_lock(mStreamMutex);
+  if (mCameraState == CAM_STATE_RUNNING) {
+    mCameraState = CAM_STATE_STOPPING;
+    // Completes every queued request as cancelled before returning.
+    mCamera->stop();
+    mCamera->requestCompleted.disconnect(this);
+    mCameraState = CAM_STATE_CONFIGURED;
+  }
+  // Frames being encoded still reference the mapped buffers.
+  if (mJpegWorker) {
+    mJpegWorker->Flush();
+  }
+
+  std::deque<PendingCapture> captures;
+  {
+    std::lock_guard lock(mFrameMutex);
+    mPendingRequest = nullptr;
+    mRequestHolds.clear();
+    captures.swap(mPendingCaptures);
+    mFreeStillRequests.clear();
+    mStillRequestsQueued = 0;
+  }
+  for (const auto& capture : captures) {
+    capture.result(ErrorOr<std::string>(
+        FlutterError(kCaptureErrorCode, "Camera stopped before capture")));
+  }
+
+  mRequests.clear();
+  mMappedBuffers.clear();
+  if (mAllocator) {
+    mAllocator->free(mViewfinderStream);
+    if (mStillStream) {
+      mAllocator->free(mStillStream);
+    }
+    mAllocator.reset();
+  }
+}
+
+void CameraContext::OnRequestCompleted(libcamera::Request* request) {
+  if (request->status() == libcamera::Request::RequestCancelled) {
+    return;
+  }
+
+  if (mStillStream && request->findBuffer(mStillStream)) {
+    PendingCapture capture;
+    {
+      std::lock_guard lock(mFrameMutex);
+      mStillRequestsQueued--;
+      capture = std::move(mPendingCaptures.front());
+      mPendingCaptures.pop_front();
+    }
+    EncodeCapture(std::move(capture), request, mStillStream,
+                  [this, request] { ReturnStillRequest(request); });
+    return;
+  }
+
+  libcamera::Request* previous;
+  std::shared_ptr<VideoRecorder> recorder;
+  std::deque<PendingCapture> captures;
+  {
+    std::lock_guard lock(mFrameMutex);
+    previous = std::exchange(mPendingRequest, request);
+    recorder = mRecorder;
+    if (!mStillStream) {
+      captures.swap(mPendingCaptures);
+    }
+    mRequestHolds[request] =
+        (recorder ? 2 : 1) + static_cast<int>(captures.size());
+  }
+
+  for (auto& capture : captures) {
+    EncodeCapture(std::move(capture), request, mViewfinderStream,
+                  [this, request] { ReleaseRequest(request); });
+  }
+
+  if (recorder &&
+      !recorder->PushFrame(request->findBuffer(mViewfinderStream),
+                           [this, request] { ReleaseRequest(request); })) {
+    ReleaseRequest(request);
+  }
+
+  // The texture never picked up the older frame; release it straight away.
+  if (previous) {
+    ReleaseRequest(previous);
+  }
+  texture_registrar_->MarkTextureFrameAvailable(mPreview.textureId);
+}
+
+std::vector<libcamera::Request*> CameraContext::TakeStillRequests() {
+  std::vector<libcamera::Request*> requests;
+  while (mStillRequestsQueued < mPendingCaptures.size() &&
+         !mFreeStillRequests.empty()) {
+    requests.push_back(mFreeStillRequests.back());
+    mFreeStillRequests.pop_back();
+    mStillRequestsQueued++;
+  }
+  return requests;
+}
+
+void CameraContext::QueueStillRequests(
+    const std::vector<libcamera::Request*>& requests) {
+  for (const auto request : requests) {
+    RequeueRequest(request);
+  }
+}
+
+void CameraContext::ReturnStillRequest(libcamera::Request* request) {
+  std::vector<libcamera::Request*> requests;
+  {
+    std::lock_guard lock(mFrameMutex);
+    mFreeStillRequests.push_back(request);
+    requests = TakeStillRequests();
+  }
+  QueueStillRequests(requests);
+}
+
+void CameraContext::EncodeCapture(PendingCapture capture,
+                                  libcamera::Request* request,
+                                  libcamera::Stream* stream,
+                                  std::function<void()> release) {
+  const libcamera::FrameBuffer* buffer = request->findBuffer(stream);
+  const auto it = mMappedBuffers.find(buffer);
+  if (it == mMappedBuffers.end() ||
+      buffer->metadata().status != libcamera::FrameMetadata::FrameSuccess) {
+    release();
+    capture.result(ErrorOr<std::string>(
+        FlutterError(kCaptureErrorCode, "Frame capture failed")));
+    return;
+  }
+
+  const libcamera::StreamConfiguration& config = stream->configuration();
+  mJpegWorker->Enqueue({
+      .format = config.pixelFormat,
+      .width = config.size.width,
+      .height = config.size.height,
+      .stride = config.stride,
+      .frame = it->second.get(),
+      .path = std::move(capture.path),
+      .release = std::move(release),
+      .done =
+          [result = std::move(capture.result)](const std::string& path,
+                                               const std::string& error) {
+            if (error.empty()) {
+              result(ErrorOr<std::string>(path));
+            } else {
+              result(ErrorOr<std::string>(
+                  FlutterError(kCaptureErrorCode, error)));
+            }
+          },
+  });
+}
+
+void CameraContext::ReleaseRequest(libcamera::Request* request) {
+  {
+    std::lock_guard lock(mFrameMutex);
+    const auto it = mRequestHolds.find(request);
+    if (it == mRequestHolds.end() || --it->second > 0) {
+      return;
+    }
+    mRequestHolds.erase(it);
+  }
+  RequeueRequest(request);
+}
+
+void CameraContext::RequeueRequest(libcamera::Request* request) {
+  if (mCameraState != CAM_STATE_RUNNING) {
+    return;
+  }
+  request->reuse(libcamera::Request::ReuseBuffers);
+  if (const auto res = mCamera->queueRequest(request); res != 0) {
+    SPDLOG_ERROR("[camera_plugin] Failed to requeue request: {}",
+                 strerror(-res));
+  }
+}
+
+const FlutterDesktopGpuSurfaceDescriptor* CameraContext::ObtainDescriptor() {
+  libcamera::Request* request;
+  {
+    std::lock_guard lock(mFrameMutex);
+    request = std::exchange(mPendingRequest, nullptr);
+  }
+  if (request == nullptr) {
+    return &mPreview.descriptor;
+  }
+
+  std::lock_guard stream_lock(mStreamMutex);
+  // The request pool is freed once streaming stops.
+  if (mCameraState != CAM_STATE_RUNNING) {
+    return &mPreview.descriptor;
+  }
+
+  const libcamera::FrameBuffer* buffer =
+      request->findBuffer(mViewfinderStream);
+  if (const auto it = mMappedBuffers.find(buffer);
+      it != mMappedBuffers.end() && mPreview.renderer) {
+    const auto& mapped = it->second;
+    // Raster thread: rebind the engine's context once the upload is done.
+    const plugin_common_egl::ContextGuard context_guard;
+    texture_registrar_->TextureMakeCurrent();
+    mapped->beginAccess();
+    mPreview.renderer->Render(mapped->planes());
+    mapped->endAccess();
+  }
+
+  ReleaseRequest(request);
+  return &mPreview.descriptor;
+}
+
 std::optional<std::string> CameraContext::GetFilePathForPicture() {
-  std::ostringstream oss;
-  oss << "xdg-user-dir PICTURES";
-  std::string picture_path;
-  if (!Command::Execute(oss.str().c_str(), picture_path)) {
+  const auto picture_path = XdgUserDirs::GetInstance().Get("PICTURES");
+  if (!picture_path.has_value()) {
     return std::nullopt;
   }
-  std::filesystem::path path(StringTools::trim(picture_path, "\n"));
+  std::filesystem::path path(picture_path.value());
   path /= "PhotoCapture_" + TimeTools::GetCurrentTimeString() + "." +
           kPictureCaptureExtension;
   return path;
 }
 
 std::optional<std::string> CameraContext::GetFilePathForVideo() {
-  std::ostringstream oss;
-  oss << "xdg-user-dir VIDEOS";
-  std::string video_path;
-  if (!Command::Execute(oss.str().c_str(), video_path)) {
+  const auto video_path = XdgUserDirs::GetInstance().Get("VIDEOS");
+  if (!video_path.has_value()) {
     return std::nullopt;
   }
-  std::filesystem::path path(StringTools::trim(video_path, "\n"));
+  std::filesystem::path path(video_path.value());
   path /= "VideoCapture_" + TimeTools::GetCurrentTimeString() + "." +
           kVideoCaptureExtension;
   return path;
 }
 
-std::string CameraContext::takePicture() {
-  if (auto filename = GetFilePathForPicture(); filename.has_value()) {
-    return filename.value();
+void CameraContext::takePicture(
+    std::function<void(ErrorOr<std::string> reply)> result) {
+  SPDLOG_DEBUG("[camera_plugin] takePicture");
+  if (mCameraState != CAM_STATE_RUNNING) {
+    result(ErrorOr<std::string>(
+        FlutterError(kCaptureErrorCode, "Camera is not streaming")));
+    return;
+  }
+
+  auto filename = GetFilePathForPicture();
+  if (!filename.has_value()) {
+    result(ErrorOr<std::string>(
+        FlutterError(kCaptureErrorCode, "No pictures directory")));
+    return;
+  }
+
+  std::vector<libcamera::Request*> requests;
+  {
+    std::lock_guard lock(mFrameMutex);
+    mPendingCaptures.push_back(
+        {std::move(filename.value()), std::move(result)});
+    requests = TakeStillRequests();
   }
-  return {};
+  QueueStillRequests(requests);
 }
 
-void CameraContext::startVideoRecording(bool /* enableStream */) {
+bool CameraContext::startVideoRecording(bool /* enableStream */) {
   SPDLOG_DEBUG("[camera_plugin] startVideoRecording");
+  if (mCameraState != CAM_STATE_RUNNING) {
+    spdlog::error("[camera_plugin] Cannot record, camera is not streaming");
+    return false;
+  }
+
+  {
+    std::lock_guard lock(mFrameMutex);
+    if (mRecorder) {
+      spdlog::error("[camera_plugin] Recording already in progress");
+      return false;
+    }
+  }
+
+  const auto filename = GetFilePathForVideo();
+  if (!filename.has_value()) {
+    return false;
+  }
+
+  auto recorder =
+      std::make_shared<VideoRecorder>(mConfig->at(0), mFps, mVideoBitrate);
+  if (!recorder->Start(filename.value())) {
+    return false;
+  }
+
+  // Start and stop both come from the platform thread, so nothing else can
+  // have installed a recorder since the check above.
+  std::lock_guard lock(mFrameMutex);
+  mRecorder = std::move(recorder);
+  return true;
 }
 
 void CameraContext::pauseVideoRecording() {
   SPDLOG_DEBUG("[camera_plugin] pauseVideoRecording");
+  std::lock_guard lock(mFrameMutex);
+  if (mRecorder) {
+    mRecorder->Pause();
+  }
 }
 
 void CameraContext::resumeVideoRecording() {
   SPDLOG_DEBUG("[camera_plugin] resumeVideoRecording");
+  std::lock_guard lock(mFrameMutex);
+  if (mRecorder) {
+    mRecorder->Resume();
+  }
 }
 
 std::string CameraContext::stopVideoRecording() {
-  if (auto filename = GetFilePathForVideo(); filename.has_value()) {
-    SPDLOG_DEBUG("[camera_plugin] stopVideoRecording: [{}]", filename.value());
-    return filename.value();
+  std::shared_ptr<VideoRecorder> recorder;
+  {
+    std::lock_guard lock(mFrameMutex);
+    recorder = std::move(mRecorder);
+  }
+  if (!recorder || !recorder->Stop()) {
+    SPDLOG_DEBUG("[camera_plugin] stopVideoRecording: []");
+    return {};
   }
-  SPDLOG_DEBUG("[camera_plugin] stopVideoRecording: []");
-  return {};
+  SPDLOG_DEBUG("[camera_plugin] stopVideoRecording: [{}]", recorder->path());
+  return recorder->path();
 }
 
 }  // namespace camera_plugin
\ No newline at end of file
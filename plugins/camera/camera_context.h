@@ -16,6 +16,11 @@
 #ifndef FLUTTER_PLUGIN_CAMERA_CONTEXT_H_
 #define FLUTTER_PLUGIN_CAMERA_CONTEXT_H_
 
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+
 #include <flutter/basic_message_channel.h>
 #include <flutter/event_channel.h>
 #include <shell/platform/embedder/embedder.h>
@@ -23,6 +28,11 @@
 #include <libcamera/libcamera.h>
 
 #include "engine.h"
+#include "jpeg_worker.h"
+#include "mapped_frame_buffer.h"
+#include "messages.h"
+#include "preview_renderer.h"
+#include "video_recorder.h"
 
 namespace camera_plugin {
 
@@ -55,22 +65,51 @@ class CameraContext : public flutter::Plugin {
 
   CAM_STATE_T getCameraState() { return mCameraState; }
 
+  /**
+   * @brief Stop streaming and release the preview texture
+   * @return void
+   * @relation
+   * libcamera, flutter
+   */
+  void Dispose();
+
   static std::optional<std::string> GetFilePathForPicture();
 
   static std::optional<std::string> GetFilePathForVideo();
 
-  static std::string takePicture();
+  /**
+   * @brief Capture a still and encode it to JPEG off the calling thread
+   * @param[in] result Receives the file path once the JPEG is written
+   * @return void
+   * @relation
+   * libcamera
+   */
+  void takePicture(std::function<void(ErrorOr<std::string> reply)> result);
+
+  /**
+   * @brief Start encoding the viewfinder stream to a new file
+   * @param[in] enableStream Unused; image streaming is not supported
+   * @return bool
+   * @relation
+   * libcamera, gstreamer
+   */
+  bool startVideoRecording(bool enableStream);
+  void pauseVideoRecording();
+  void resumeVideoRecording();
 
-  static void startVideoRecording(bool enableStream);
-  static void pauseVideoRecording();
-  static void resumeVideoRecording();
-  static std::string stopVideoRecording();
+  /**
+   * @brief Finalize the recording
+   * @return std::string Path of the recorded file, empty on failure
+   * @relation
+   * gstreamer
+   */
+  std::string stopVideoRecording();
 
  private:
   flutter::TextureRegistrar* texture_registrar_{};
   std::unique_ptr<flutter::MethodChannel<>> camera_channel_;
   int64_t camera_id_ = -1;
-  CAM_STATE_T mCameraState;
+  std::atomic<CAM_STATE_T> mCameraState;
 
   // The internal Flutter event channel instance.
   std::unique_ptr<flutter::EventChannel<flutter::EncodableValue>>
@@ -100,16 +139,175 @@ class CameraContext : public flutter::Plugin {
     std::unique_ptr<flutter::EventSink<flutter::EncodableValue>> event_sink;
 
     GLuint textureId{};
-    GLuint framebuffer{};
-    GLuint program;
     GLsizei width, height;
-    GLuint vertex_arr_id_{};
+
+    // Converts viewfinder frames into textureId.
+    std::unique_ptr<PreviewRenderer> renderer;
 
     // The Surface Descriptor sent to Flutter when a texture frame is available.
     std::unique_ptr<flutter::GpuSurfaceTexture> gpu_surface_texture;
     FlutterDesktopGpuSurfaceDescriptor descriptor{};
   } mPreview;
 
+  // Viewfinder stream state
+  std::unique_ptr<libcamera::CameraConfiguration> mConfig;
+  libcamera::Stream* mViewfinderStream{};
+  std::unique_ptr<libcamera::FrameBufferAllocator> mAllocator;
+  std::vector<std::unique_ptr<libcamera::Request>> mRequests;
+  std::map<const libcamera::FrameBuffer*, std::unique_ptr<MappedFrameBuffer>>
+      mMappedBuffers;
+
+  // Held while a frame is rendered and while the stream is torn down.
+  std::mutex mStreamMutex;
+
+  // Latest completed request waiting to be presented.  Older ones are
+  // released as soon as a newer frame arrives.
+  std::mutex mFrameMutex;
+  libcamera::Request* mPendingRequest{};
+
+  // Completed requests are requeued once the preview and the recorder have
+  // both released them.  Guarded by mFrameMutex.
+  std::map<libcamera::Request*, int> mRequestHolds;
+  std::shared_ptr<VideoRecorder> mRecorder;
+
+  // Still capture.  Without a still stream the next viewfinder frame is
+  // captured instead.  Guarded by mFrameMutex.
+  struct PendingCapture {
+    std::string path;
+    std::function<void(ErrorOr<std::string> reply)> result;
+  };
+  libcamera::Stream* mStillStream{};
+  std::vector<libcamera::Request*> mFreeStillRequests;
+  std::deque<PendingCapture> mPendingCaptures;
+  size_t mStillRequestsQueued{};
+  std::unique_ptr<JpegWorker> mJpegWorker;
+
+  /**
+   * @brief Resolve the preview size of the resolution preset
+   * @param[in] config Stream configuration, used for the max preset
+   * @return libcamera::Size
+   * @relation
+   * libcamera
+   */
+  libcamera::Size GetPresetSize(
+      const libcamera::StreamConfiguration& config) const;
+
+  /**
+   * @brief Generate and validate the stream configuration
+   * @param[in] with_still Add a StillCapture stream next to the viewfinder
+   * @return bool
+   * @retval true mConfig holds a usable configuration
+   * @retval false Configuration rejected
+   * @relation
+   * libcamera
+   */
+  bool GenerateConfiguration(bool with_still);
+
+  /**
+   * @brief Configure the viewfinder stream, and a still stream when the
+   * pipeline supports it
+   * @return bool
+   * @retval true Camera configured
+   * @retval false No usable configuration
+   * @relation
+   * libcamera
+   */
+  bool ConfigureStreams();
+
+  /**
+   * @brief Allocate the request pool, start the camera and queue all requests
+   * @return bool
+   * @relation
+   * libcamera
+   */
+  bool StartStreaming();
+
+  /**
+   * @brief Stop the camera and free the request pool
+   * @return void
+   * @relation
+   * libcamera
+   */
+  void StopStreaming();
+
+  /**
+   * @brief libcamera requestCompleted handler, runs on the camera manager
+   * thread
+   * @param[in] request Completed request
+   * @return void
+   * @relation
+   * libcamera
+   */
+  void OnRequestCompleted(libcamera::Request* request);
+
+  /**
+   * @brief Take the free still requests needed by pending captures.  Called
+   * with mFrameMutex held.
+   * @return std::vector<libcamera::Request*> Requests to queue
+   * @relation
+   * libcamera
+   */
+  std::vector<libcamera::Request*> TakeStillRequests();
+
+  /**
+   * @brief Queue still requests if the camera is running
+   * @param[in] requests Requests from TakeStillRequests
+   * @return void
+   * @relation
+   * libcamera
+   */
+  void QueueStillRequests(const std::vector<libcamera::Request*>& requests);
+
+  /**
+   * @brief Return an encoded still request to the pool
+   * @param[in] request Still request
+   * @return void
+   * @relation
+   * libcamera
+   */
+  void ReturnStillRequest(libcamera::Request* request);
+
+  /**
+   * @brief Hand a captured frame to the JPEG worker
+   * @param[in] capture Capture to complete
+   * @param[in] request Completed request holding the frame
+   * @param[in] stream Stream of the frame
+   * @param[in] release Called once the frame has been encoded
+   * @return void
+   * @relation
+   * libcamera
+   */
+  void EncodeCapture(PendingCapture capture,
+                     libcamera::Request* request,
+                     libcamera::Stream* stream,
+                     std::function<void()> release);
+
+  /**
+   * @brief Drop one hold on a request, requeueing it when none remain
+   * @param[in] request Completed request
+   * @return void
+   * @relation
+   * libcamera
+   */
+  void ReleaseRequest(libcamera::Request* request);
+
+  /**
+   * @brief Reuse a request and hand it back to the camera
+   * @param[in] request Request to requeue
+   * @return void
+   * @relation
+   * libcamera
+   */
+  void RequeueRequest(libcamera::Request* request);
+
+  /**
+   * @brief Texture callback: render the latest frame into the preview texture
+   * @return const FlutterDesktopGpuSurfaceDescriptor*
+   * @relation
+   * flutter
+   */
+  const FlutterDesktopGpuSurfaceDescriptor* ObtainDescriptor();
+
   flutter::MethodChannel<>* GetMethodChannel();
 };
 }  // namespace camera_plugin
@@ -30,13 +30,6 @@ namespace camera_plugin {
 
 // TODO static constexpr char kKeyMaxVideoDuration[] = "maxVideoDuration";
 
-// TODO static constexpr char kResolutionPresetValueLow[] = "low";
-// TODO static constexpr char kResolutionPresetValueMedium[] = "medium";
-// TODO static constexpr char kResolutionPresetValueHigh[] = "high";
-// TODO static constexpr char kResolutionPresetValueVeryHigh[] = "veryHigh";
-// TODO static constexpr char kResolutionPresetValueUltraHigh[] = "ultraHigh";
-// TODO static constexpr char kResolutionPresetValueMax[] = "max";
-
 static std::unique_ptr<libcamera::CameraManager> g_camera_manager;
 static std::vector<std::shared_ptr<CameraContext>> g_cameras;
 
@@ -51,6 +44,8 @@ void CameraPlugin::RegisterWithRegistrar(flutter::PluginRegistrar* registrar) {
 CameraPlugin::CameraPlugin(flutter::PluginRegistrar* plugin_registrar,
                            flutter::BinaryMessenger* messenger)
     : registrar_(plugin_registrar), messenger_(messenger) {
+  gst_init(nullptr, nullptr);
+
   g_camera_manager = std::make_unique<libcamera::CameraManager>();
   g_camera_manager->cameraAdded.connect(this, &CameraPlugin::camera_added);
   g_camera_manager->cameraRemoved.connect(this, &CameraPlugin::camera_removed);
@@ -229,8 +224,9 @@ void CameraPlugin::takePicture(
     }
   }
 
-  g_cameras[static_cast<unsigned long>(cameraId - 1)];
-  result(ErrorOr(CameraContext::takePicture()));
+  const auto& camera = g_cameras[static_cast<unsigned long>(cameraId - 1)];
+  // Replies once the JPEG has been written.
+  camera->takePicture(result);
 }
 
 void CameraPlugin::startVideoRecording(
@@ -251,7 +247,10 @@ void CameraPlugin::startVideoRecording(
   }
 
   const auto& camera = g_cameras[static_cast<unsigned long>(cameraId - 1)];
-  camera->startVideoRecording(enableStream);
+  if (!camera->startVideoRecording(enableStream)) {
+    result(FlutterError("recording_failed", "Failed to start recording"));
+    return;
+  }
 
   result(std::nullopt);
 }
@@ -581,8 +580,10 @@ void CameraPlugin::dispose(
       cameraId = std::get<int32_t>(snd);
     }
   }
-  auto camera = g_cameras[static_cast<unsigned long>(cameraId - 1)];
-  camera.reset();
+  const auto& camera = g_cameras[static_cast<unsigned long>(cameraId - 1)];
+  if (camera) {
+    camera->Dispose();
+  }
   SPDLOG_DEBUG("[camera_plugin] dispose: {}", cameraId);
   result(std::nullopt);
 }
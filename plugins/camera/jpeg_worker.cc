@@ -0,0 +1,318 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jpeg_worker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <libcamera/formats.h>
+
+#if defined(ENABLE_JPEG)
+#include <csetjmp>
+#include <cstdio>
+
+#include <jpeglib.h>
+#endif
+
+#include <plugins/common/common.h>
+
+namespace camera_plugin {
+
+namespace {
+
+#if defined(ENABLE_JPEG)
+
+struct ErrorManager {
+  jpeg_error_mgr pub;
+  jmp_buf jump;
+  char message[JMSG_LENGTH_MAX];
+};
+
+// The default handler calls exit().
+void OnJpegError(const j_common_ptr cinfo) {
+  const auto err = reinterpret_cast<ErrorManager*>(cinfo->err);
+  (*cinfo->err->format_message)(cinfo, err->message);
+  longjmp(err->jump, 1);
+}
+
+// Copy count samples spaced step bytes apart, repeating the last one up to
+// padded.
+void CopySamples(JSAMPLE* dst,
+                 const uint8_t* src,
+                 const unsigned int count,
+                 const unsigned int step,
+                 const unsigned int padded) {
+  for (unsigned int x = 0; x < count; x++) {
+    dst[x] = src[x * step];
+  }
+  std::fill(dst + count, dst + padded, dst[count - 1]);
+}
+
+// libjpeg reads raw rows up to the MCU boundary, so every row handed to it
+// is padded to a multiple of 16 samples.
+void WriteNV12(jpeg_compress_struct* cinfo,
+               const JpegWorker::Job& job,
+               const uint8_t* y_plane,
+               const uint8_t* uv_plane,
+               JSAMPLE* scratch,
+               const unsigned int padded_width) {
+  const unsigned int chroma_width = (job.width + 1) / 2;
+  const unsigned int chroma_height = (job.height + 1) / 2;
+  const unsigned int padded_chroma = padded_width / 2;
+  const bool direct_luma = job.stride >= padded_width;
+
+  JSAMPLE* y_scratch = scratch;
+  JSAMPLE* cb_scratch = y_scratch + padded_width * 16;
+  JSAMPLE* cr_scratch = cb_scratch + padded_chroma * 8;
+
+  JSAMPROW y_rows[16];
+  JSAMPROW cb_rows[8];
+  JSAMPROW cr_rows[8];
+  JSAMPARRAY planes[3] = {y_rows, cb_rows, cr_rows};
+
+  for (unsigned int row = 0; row < job.height; row += 16) {
+    for (unsigned int i = 0; i < 16; i++) {
+      const auto src = y_plane + std::min(row + i, job.height - 1) * job.stride;
+      if (direct_luma) {
+        y_rows[i] = const_cast<JSAMPROW>(src);
+      } else {
+        y_rows[i] = y_scratch + i * padded_width;
+        CopySamples(y_rows[i], src, job.width, 1, padded_width);
+      }
+    }
+    for (unsigned int i = 0; i < 8; i++) {
+      const auto src =
+          uv_plane + std::min(row / 2 + i, chroma_height - 1) * job.stride;
+      cb_rows[i] = cb_scratch + i * padded_chroma;
+      cr_rows[i] = cr_scratch + i * padded_chroma;
+      CopySamples(cb_rows[i], src, chroma_width, 2, padded_chroma);
+      CopySamples(cr_rows[i], src + 1, chroma_width, 2, padded_chroma);
+    }
+    jpeg_write_raw_data(cinfo, planes, 16);
+  }
+}
+
+void WriteYUYV(jpeg_compress_struct* cinfo,
+               const JpegWorker::Job& job,
+               const uint8_t* plane,
+               JSAMPLE* scratch,
+               const unsigned int padded_width) {
+  const unsigned int chroma_width = (job.width + 1) / 2;
+  const unsigned int padded_chroma = padded_width / 2;
+
+  JSAMPLE* y_scratch = scratch;
+  JSAMPLE* cb_scratch = y_scratch + padded_width * 8;
+  JSAMPLE* cr_scratch = cb_scratch + padded_chroma * 8;
+
+  JSAMPROW y_rows[8];
+  JSAMPROW cb_rows[8];
+  JSAMPROW cr_rows[8];
+  JSAMPARRAY planes[3] = {y_rows, cb_rows, cr_rows};
+
+  for (unsigned int row = 0; row < job.height; row += 8) {
+    for (unsigned int i = 0; i < 8; i++) {
+      const auto src = plane + std::min(row + i, job.height - 1) * job.stride;
+      y_rows[i] = y_scratch + i * padded_width;
+      cb_rows[i] = cb_scratch + i * padded_chroma;
+      cr_rows[i] = cr_scratch + i * padded_chroma;
+      CopySamples(y_rows[i], src, job.width, 2, padded_width);
+      CopySamples(cb_rows[i], src + 1, chroma_width, 4, padded_chroma);
+      CopySamples(cr_rows[i], src + 3, chroma_width, 4, padded_chroma);
+    }
+    jpeg_write_raw_data(cinfo, planes, 8);
+  }
+}
+
+#endif  // ENABLE_JPEG
+
+}  // namespace
+
+JpegWorker::JpegWorker() : thread_(&JpegWorker::Run, this) {}
+
+JpegWorker::~JpegWorker() {
+  {
+    std::lock_guard lock(mutex_);
+    exit_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+bool JpegWorker::IsSupported(const libcamera::PixelFormat& format) {
+  return format == libcamera::formats::NV12 ||
+         format == libcamera::formats::YUYV ||
+         format == libcamera::formats::RGB888 ||
+         format == libcamera::formats::BGR888;
+}
+
+void JpegWorker::Enqueue(Job job) {
+  {
+    std::lock_guard lock(mutex_);
+    jobs_.push_back(std::move(job));
+  }
+  cv_.notify_one();
+}
+
+void JpegWorker::Flush() {
+  std::unique_lock lock(mutex_);
+  idle_cv_.wait(lock, [this] { return jobs_.empty() && !busy_; });
+}
+
+void JpegWorker::Run() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock lock(mutex_);
+      cv_.wait(lock, [this] { return exit_ || !jobs_.empty(); });
+      // Pending jobs hold camera buffers; finish them before exiting.
+      if (jobs_.empty()) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+      busy_ = true;
+    }
+
+    std::string error;
+    job.frame->beginAccess();
+    const bool result = Encode(job, error);
+    job.frame->endAccess();
+    job.release();
+
+    if (result) {
+      SPDLOG_DEBUG("[camera_plugin] Picture saved: {}", job.path);
+      job.done(job.path, {});
+    } else {
+      spdlog::error("[camera_plugin] Picture capture failed: {}", error);
+      job.done({}, error);
+    }
+
+    {
+      std::lock_guard lock(mutex_);
+      busy_ = false;
+    }
+    idle_cv_.notify_all();
+  }
+}
+
+bool JpegWorker::Encode(const Job& job, std::string& error) {
+#if defined(ENABLE_JPEG)
+  const auto& planes = job.frame->planes();
+  if (planes.empty() || !IsSupported(job.format)) {
+    error = "Unsupported frame format " + job.format.toString();
+    return false;
+  }
+
+  FILE* file = fopen(job.path.c_str(), "wb");
+  if (file == nullptr) {
+    error = "Failed to open " + job.path + ": " + strerror(errno);
+    return false;
+  }
+
+  // Allocated up front; nothing with a destructor may live past setjmp.
+  const unsigned int padded_width = (job.width + 15) & ~15u;
+  std::vector<JSAMPLE> scratch(padded_width * 16 * 2);
+
+  jpeg_compress_struct cinfo{};
+  ErrorManager err{};
+  cinfo.err = jpeg_std_error(&err.pub);
+  err.pub.error_exit = OnJpegError;
+  if (setjmp(err.jump)) {
+    jpeg_destroy_compress(&cinfo);
+    fclose(file);
+    error = err.message;
+    return false;
+  }
+
+  jpeg_create_compress(&cinfo);
+  jpeg_stdio_dest(&cinfo, file);
+  cinfo.image_width = job.width;
+  cinfo.image_height = job.height;
+  cinfo.input_components = 3;
+
+  if (job.format == libcamera::formats::NV12 ||
+      job.format == libcamera::formats::YUYV) {
+    // Raw YCbCr input skips color conversion and downsampling.
+    cinfo.in_color_space = JCS_YCbCr;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_colorspace(&cinfo, JCS_YCbCr);
+    cinfo.raw_data_in = TRUE;
+#if JPEG_LIB_VERSION >= 70
+    cinfo.do_fancy_downsampling = FALSE;
+#endif
+    cinfo.comp_info[0].h_samp_factor = 2;
+    cinfo.comp_info[0].v_samp_factor =
+        job.format == libcamera::formats::NV12 ? 2 : 1;
+    for (int i = 1; i < 3; i++) {
+      cinfo.comp_info[i].h_samp_factor = 1;
+      cinfo.comp_info[i].v_samp_factor = 1;
+    }
+  } else {
+#if defined(JCS_EXTENSIONS)
+    // DRM RGB888 is stored B, G, R in memory, BGR888 R, G, B.
+    cinfo.in_color_space =
+        job.format == libcamera::formats::RGB888 ? JCS_EXT_BGR : JCS_EXT_RGB;
+#else
+    cinfo.in_color_space = JCS_RGB;
+#endif
+    jpeg_set_defaults(&cinfo);
+  }
+  jpeg_set_quality(&cinfo, kQuality, TRUE);
+  jpeg_start_compress(&cinfo, TRUE);
+
+  if (job.format == libcamera::formats::NV12) {
+    const uint8_t* y_plane = planes[0].data();
+    const uint8_t* uv_plane = planes.size() >= 2
+                                  ? planes[1].data()
+                                  : y_plane + job.stride * job.height;
+    WriteNV12(&cinfo, job, y_plane, uv_plane, scratch.data(), padded_width);
+  } else if (job.format == libcamera::formats::YUYV) {
+    WriteYUYV(&cinfo, job, planes[0].data(), scratch.data(), padded_width);
+  } else {
+    for (unsigned int row = 0; row < job.height; row++) {
+      const uint8_t* src = planes[0].data() + row * job.stride;
+#if defined(JCS_EXTENSIONS)
+      JSAMPROW row_pointer = const_cast<JSAMPROW>(src);
+#else
+      JSAMPROW row_pointer = scratch.data();
+      const bool swap = job.format == libcamera::formats::RGB888;
+      for (unsigned int x = 0; x < job.width; x++) {
+        row_pointer[x * 3] = src[x * 3 + (swap ? 2 : 0)];
+        row_pointer[x * 3 + 1] = src[x * 3 + 1];
+        row_pointer[x * 3 + 2] = src[x * 3 + (swap ? 0 : 2)];
+      }
+#endif
+      jpeg_write_scanlines(&cinfo, &row_pointer, 1);
+    }
+  }
+
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+  if (fclose(file) != 0) {
+    error = "Failed to write " + job.path + ": " + strerror(errno);
+    return false;
+  }
+  return true;
+#else
+  (void)job;
+  error = "Built without JPEG support";
+  return false;
+#endif
+}
+
+}  // namespace camera_plugin
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLUTTER_PLUGIN_CAMERA_JPEG_WORKER_H_
+#define FLUTTER_PLUGIN_CAMERA_JPEG_WORKER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <libcamera/pixel_format.h>
+
+#include "mapped_frame_buffer.h"
+
+namespace camera_plugin {
+
+/**
+ * @brief Encodes captured frames to JPEG files on a dedicated thread, so
+ * neither the camera manager thread nor the platform thread waits on it.
+ */
+class JpegWorker {
+ public:
+  static constexpr int kQuality = 90;
+
+  struct Job {
+    libcamera::PixelFormat format;
+    unsigned int width;
+    unsigned int height;
+    unsigned int stride;
+    // Frame to encode, owned by the camera until release is called.
+    const MappedFrameBuffer* frame;
+    std::string path;
+    // Called once the frame is no longer needed, before done.
+    std::function<void()> release;
+    // Called with the file path, or an empty path and an error message.
+    std::function<void(const std::string& path, const std::string& error)>
+        done;
+  };
+
+  JpegWorker();
+  ~JpegWorker();
+
+  // Disallow copy and assign.
+  JpegWorker(const JpegWorker&) = delete;
+  JpegWorker& operator=(const JpegWorker&) = delete;
+
+  /**
+   * @brief Returns true if the format can be encoded
+   * @param[in] format libcamera pixel format
+   * @return bool
+   * @relation
+   * libcamera
+   */
+  static bool IsSupported(const libcamera::PixelFormat& format);
+
+  /**
+   * @brief Queue a frame for encoding
+   * @param[in] job Frame and completion callbacks
+   * @return void
+   * @relation
+   * internal
+   */
+  void Enqueue(Job job);
+
+  /**
+   * @brief Wait for every queued job to finish
+   * @return void
+   * @relation
+   * internal
+   */
+  void Flush();
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable idle_cv_;
+  std::deque<Job> jobs_;
+  bool busy_{};
+  bool exit_{};
+  std::thread thread_;
+
+  void Run();
+
+  /**
+   * @brief Encode a frame to a JPEG file
+   * @param[in] job Frame to encode
+   * @param[out] error Error message on failure
+   * @return bool
+   * @relation
+   * internal
+   */
+  static bool Encode(const Job& job, std::string& error);
+};
+
+}  // namespace camera_plugin
+
+#endif  // FLUTTER_PLUGIN_CAMERA_JPEG_WORKER_H_
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapped_frame_buffer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+
+#include <linux/dma-buf.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <plugins/common/common.h>
+
+namespace camera_plugin {
+
+MappedFrameBuffer::MappedFrameBuffer(const libcamera::FrameBuffer* buffer) {
+  // Size each mapping to cover every plane that lives in the same dmabuf.
+  std::map<int, size_t> lengths;
+  for (const auto& plane : buffer->planes()) {
+    const int fd = plane.fd.get();
+    const size_t end = plane.offset + plane.length;
+    lengths[fd] = std::max(lengths[fd], end);
+  }
+
+  for (const auto& [fd, length] : lengths) {
+    const off_t size = lseek(fd, 0, SEEK_END);
+    if (size != -1 && static_cast<size_t>(size) < length) {
+      spdlog::error("[camera_plugin] dmabuf {} too small: {} < {}", fd, size,
+                    length);
+      return;
+    }
+    void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      spdlog::error("[camera_plugin] Failed to mmap plane: {}",
+                    strerror(errno));
+      return;
+    }
+    maps_.push_back({fd, address, length});
+  }
+
+  for (const auto& plane : buffer->planes()) {
+    const int fd = plane.fd.get();
+    const auto it = std::find_if(maps_.begin(), maps_.end(),
+                                 [fd](const Mapping& m) { return m.fd == fd; });
+    planes_.emplace_back(static_cast<uint8_t*>(it->address) + plane.offset,
+                         plane.length);
+  }
+}
+
+MappedFrameBuffer::~MappedFrameBuffer() {
+  for (const auto& [fd, address, length] : maps_) {
+    munmap(address, length);
+  }
+}
+
+void MappedFrameBuffer::beginAccess() const {
+  sync(DMA_BUF_SYNC_START | DMA_BUF_SYNC_READ);
+}
+
+void MappedFrameBuffer::endAccess() const {
+  sync(DMA_BUF_SYNC_END | DMA_BUF_SYNC_READ);
+}
+
+void MappedFrameBuffer::sync(const uint64_t flags) const {
+  dma_buf_sync sync{flags};
+  for (const auto& map : maps_) {
+    // Not every exporter implements the ioctl; ignore ENOTTY.
+    ioctl(map.fd, DMA_BUF_IOCTL_SYNC, &sync);
+  }
+}
+
+}  // namespace camera_plugin
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLUTTER_PLUGIN_CAMERA_MAPPED_FRAME_BUFFER_H_
+#define FLUTTER_PLUGIN_CAMERA_MAPPED_FRAME_BUFFER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <libcamera/framebuffer.h>
+#include <libcamera/base/span.h>
+
+namespace camera_plugin {
+
+/**
+ * @brief CPU mapping of the planes of a libcamera FrameBuffer.
+ *
+ * Planes sharing a dmabuf are mapped once.  Buffers are mapped when the
+ * allocator creates them and stay mapped for the lifetime of the stream, so
+ * no mmap is done per frame.
+ */
+class MappedFrameBuffer {
+ public:
+  explicit MappedFrameBuffer(const libcamera::FrameBuffer* buffer);
+  ~MappedFrameBuffer();
+
+  // Disallow copy and assign.
+  MappedFrameBuffer(const MappedFrameBuffer&) = delete;
+  MappedFrameBuffer& operator=(const MappedFrameBuffer&) = delete;
+
+  [[nodiscard]] bool isValid() const { return !planes_.empty(); }
+
+  [[nodiscard]] const std::vector<libcamera::Span<uint8_t>>& planes() const {
+    return planes_;
+  }
+
+  /**
+   * @brief Begin CPU access, making device writes visible
+   * @return void
+   * @relation
+   * libcamera
+   */
+  void beginAccess() const;
+
+  /**
+   * @brief End CPU access started with beginAccess
+   * @return void
+   * @relation
+   * libcamera
+   */
+  void endAccess() const;
+
+ private:
+  struct Mapping {
+    int fd;
+    void* address;
+    size_t length;
+  };
+
+  std::vector<Mapping> maps_;
+  std::vector<libcamera::Span<uint8_t>> planes_;
+
+  void sync(uint64_t flags) const;
+};
+
+}  // namespace camera_plugin
+
+#endif  // FLUTTER_PLUGIN_CAMERA_MAPPED_FRAME_BUFFER_H_
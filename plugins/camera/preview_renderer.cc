@@ -0,0 +1,372 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "preview_renderer.h"
+
+#include <cstring>
+
+#include <libcamera/formats.h>
+
+#include <plugins/common/common.h>
+
+namespace camera_plugin {
+
+namespace {
+
+const GLchar* kVertexSource = R"glsl(
+  #version 300 es
+  precision highp float;
+  layout(location = 0) in vec2 position;
+  layout(location = 1) in vec2 texcoord;
+  out vec2 Texcoord;
+  void main() {
+    Texcoord = texcoord;
+    gl_Position = vec4(position, 0.0, 1.0);
+  }
+)glsl";
+
+// BT.601 limited range.
+const GLchar* kNV12FragmentSource = R"glsl(
+  #version 300 es
+  precision highp float;
+  in vec2 Texcoord;
+  uniform sampler2D textureY;
+  uniform sampler2D textureUV;
+  layout(location = 0) out vec4 fragColor;
+  void main() {
+    vec2 coord = vec2(Texcoord.x, 1.0 - Texcoord.y);
+    float y = 1.164 * (texture(textureY, coord).r - 0.0625);
+    vec2 uv = texture(textureUV, coord).rg - 0.5;
+    fragColor = vec4(clamp(y + 1.596 * uv.y, 0.0, 1.0),
+                     clamp(y - 0.392 * uv.x - 0.813 * uv.y, 0.0, 1.0),
+                     clamp(y + 2.017 * uv.x, 0.0, 1.0),
+                     1.0);
+  }
+)glsl";
+
+// Each RGBA texel holds two pixels: Y0 U Y1 V.
+const GLchar* kYUYVFragmentSource = R"glsl(
+  #version 300 es
+  precision highp float;
+  in vec2 Texcoord;
+  uniform sampler2D textureYUYV;
+  uniform int frameWidth;
+  layout(location = 0) out vec4 fragColor;
+  void main() {
+    ivec2 size = textureSize(textureYUYV, 0);
+    vec2 coord = vec2(Texcoord.x, 1.0 - Texcoord.y);
+    int x = clamp(int(coord.x * float(frameWidth)), 0, frameWidth - 1);
+    int row = clamp(int(coord.y * float(size.y)), 0, size.y - 1);
+    vec4 texel = texelFetch(textureYUYV, ivec2(x / 2, row), 0);
+    float y = 1.164 * (((x & 1) == 0 ? texel.r : texel.b) - 0.0625);
+    vec2 uv = texel.ga - 0.5;
+    fragColor = vec4(clamp(y + 1.596 * uv.y, 0.0, 1.0),
+                     clamp(y - 0.392 * uv.x - 0.813 * uv.y, 0.0, 1.0),
+                     clamp(y + 2.017 * uv.x, 0.0, 1.0),
+                     1.0);
+  }
+)glsl";
+
+const GLchar* kRGBFragmentSource = R"glsl(
+  #version 300 es
+  precision highp float;
+  in vec2 Texcoord;
+  uniform sampler2D textureRGB;
+  uniform bool swapRB;
+  layout(location = 0) out vec4 fragColor;
+  void main() {
+    vec3 rgb = texture(textureRGB, vec2(Texcoord.x, 1.0 - Texcoord.y)).rgb;
+    fragColor = vec4(swapRB ? rgb.bgr : rgb, 1.0);
+  }
+)glsl";
+
+void SetTextureParameters(const GLint filter) {
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+}  // namespace
+
+PreviewRenderer::PreviewRenderer(const libcamera::PixelFormat& format,
+                                 const GLsizei _width,
+                                 const GLsizei _height,
+                                 const unsigned int stride)
+    : width(_width), height(_height), format_(format), stride_(stride) {
+  glGenFramebuffers(1, &framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+  glGenTextures(1, &textureId);
+  glBindTexture(GL_TEXTURE_2D, textureId);
+  SetTextureParameters(GL_LINEAR);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
+               GL_UNSIGNED_BYTE, nullptr);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         textureId, 0);
+
+  if (auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+      status != GL_FRAMEBUFFER_COMPLETE) {
+    spdlog::error("[camera_plugin] FramebufferStatus: 0x{:X}", status);
+  }
+
+  glViewport(0, 0, width, height);
+  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  CreateSourceTextures();
+
+  // Full screen quad; the vertex array keeps the attribute bindings.
+  glGenVertexArrays(1, &vertex_arr_id_);
+  glBindVertexArray(vertex_arr_id_);
+
+  glGenBuffers(1, &vertex_buffer_);
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+  static constexpr GLfloat vertex_buffer_data[] = {
+      -1.0f, 1.0f,  1.0f,  1.0f,  1.0f,  -1.0f,
+      1.0f,  -1.0f, -1.0f, -1.0f, -1.0f, 1.0f,
+  };
+  glBufferData(GL_ARRAY_BUFFER, sizeof(vertex_buffer_data), vertex_buffer_data,
+               GL_STATIC_DRAW);
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+  glGenBuffers(1, &coord_buffer_);
+  glBindBuffer(GL_ARRAY_BUFFER, coord_buffer_);
+  static constexpr GLfloat coord_buffer_data[] = {
+      0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+  };
+  glBufferData(GL_ARRAY_BUFFER, sizeof(coord_buffer_data), coord_buffer_data,
+               GL_STATIC_DRAW);
+  glEnableVertexAttribArray(1);
+  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindVertexArray(0);
+
+  glFinish();
+}
+
+PreviewRenderer::~PreviewRenderer() {
+  glDeleteBuffers(1, &coord_buffer_);
+  glDeleteBuffers(1, &vertex_buffer_);
+  glDeleteVertexArrays(1, &vertex_arr_id_);
+  glDeleteProgram(program_);
+  glDeleteTextures(2, &innerTexture_[0]);
+  glDeleteTextures(1, &textureId);
+  glDeleteFramebuffers(1, &framebuffer);
+}
+
+bool PreviewRenderer::IsSupported(const libcamera::PixelFormat& format) {
+  return format == libcamera::formats::NV12 ||
+         format == libcamera::formats::YUYV ||
+         format == libcamera::formats::RGB888 ||
+         format == libcamera::formats::BGR888;
+}
+
+void PreviewRenderer::CreateSourceTextures() {
+  glGenTextures(2, &innerTexture_[0]);
+
+  if (format_ == libcamera::formats::NV12) {
+    program_ = LoadShaders(kNV12FragmentSource);
+    glUseProgram(program_);
+    glUniform1i(glGetUniformLocation(program_, "textureY"), 0);
+    glUniform1i(glGetUniformLocation(program_, "textureUV"), 1);
+
+    glBindTexture(GL_TEXTURE_2D, innerTexture_[0]);
+    SetTextureParameters(GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED,
+                 GL_UNSIGNED_BYTE, nullptr);
+
+    glBindTexture(GL_TEXTURE_2D, innerTexture_[1]);
+    SetTextureParameters(GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG8, width / 2, height / 2, 0, GL_RG,
+                 GL_UNSIGNED_BYTE, nullptr);
+  } else if (format_ == libcamera::formats::YUYV) {
+    program_ = LoadShaders(kYUYVFragmentSource);
+    glUseProgram(program_);
+    glUniform1i(glGetUniformLocation(program_, "textureYUYV"), 0);
+    glUniform1i(glGetUniformLocation(program_, "frameWidth"), width);
+
+    // Pixel pairs are picked with texelFetch, so filtering must be off.
+    glBindTexture(GL_TEXTURE_2D, innerTexture_[0]);
+    SetTextureParameters(GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width / 2, height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, nullptr);
+  } else {
+    program_ = LoadShaders(kRGBFragmentSource);
+    glUseProgram(program_);
+    glUniform1i(glGetUniformLocation(program_, "textureRGB"), 0);
+    // DRM RGB888 is stored B, G, R in memory.
+    glUniform1i(glGetUniformLocation(program_, "swapRB"),
+                format_ == libcamera::formats::RGB888);
+
+    glBindTexture(GL_TEXTURE_2D, innerTexture_[0]);
+    SetTextureParameters(GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB,
+                 GL_UNSIGNED_BYTE, nullptr);
+  }
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glUseProgram(0);
+}
+
+bool PreviewRenderer::Render(
+    const std::vector<libcamera::Span<uint8_t>>& planes) {
+  if (planes.empty() || program_ == 0) {
+    return false;
+  }
+
+  const size_t frame_rows = static_cast<size_t>(height);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  if (format_ == libcamera::formats::NV12) {
+    const uint8_t* y = planes[0].data();
+    const uint8_t* uv;
+    if (planes.size() >= 2) {
+      uv = planes[1].data();
+    } else if (planes[0].size() >= stride_ * frame_rows * 3 / 2) {
+      // Contiguous single plane buffer
+      uv = y + stride_ * frame_rows;
+    } else {
+      SPDLOG_ERROR("[camera_plugin] NV12 frame too small: {}",
+                   planes[0].size());
+      return false;
+    }
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, innerTexture_[0]);
+    UploadRows(width, height, GL_RED, 1, y);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, innerTexture_[1]);
+    UploadRows(width / 2, height / 2, GL_RG, 2, uv);
+  } else if (format_ == libcamera::formats::YUYV) {
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, innerTexture_[0]);
+    UploadRows(width / 2, height, GL_RGBA, 4, planes[0].data());
+  } else {
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, innerTexture_[0]);
+    UploadRows(width, height, GL_RGB, 3, planes[0].data());
+  }
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+  Draw();
+  return true;
+}
+
+void PreviewRenderer::UploadRows(const GLsizei rows_width,
+                                 const GLsizei rows,
+                                 const GLenum format,
+                                 const unsigned int bytes_per_pixel,
+                                 const uint8_t* data) {
+  // GL_UNPACK_ROW_LENGTH counts whole pixels, so it can only describe
+  // strides that are a multiple of the pixel size.  Anything else (e.g. 24
+  // bit RGB padded to 64 bytes) is repacked into tight rows first.
+  if (stride_ % bytes_per_pixel == 0) {
+    glPixelStorei(GL_UNPACK_ROW_LENGTH,
+                  static_cast<GLint>(stride_ / bytes_per_pixel));
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, rows_width, rows, format,
+                    GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    return;
+  }
+
+  const size_t row_bytes = static_cast<size_t>(rows_width) * bytes_per_pixel;
+  repack_.resize(row_bytes * static_cast<size_t>(rows));
+  for (GLsizei row = 0; row < rows; row++) {
+    std::memcpy(repack_.data() + row_bytes * static_cast<size_t>(row),
+                data + static_cast<size_t>(stride_) * row, row_bytes);
+  }
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, rows_width, rows, format,
+                  GL_UNSIGNED_BYTE, repack_.data());
+}
+
+void PreviewRenderer::Draw() const {
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glViewport(0, 0, width, height);
+  glUseProgram(program_);
+  glBindVertexArray(vertex_arr_id_);
+
+  glDrawArrays(GL_TRIANGLES, 0, 6);
+
+  glBindVertexArray(0);
+  glUseProgram(0);
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  glFinish();
+}
+
+GLuint PreviewRenderer::LoadShaders(const GLchar* fsource) {
+  GLint result;
+  GLsizei length;
+  GLchar info[1000]{};
+
+  const GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+  glShaderSource(vertex_shader, 1, &kVertexSource, nullptr);
+  glCompileShader(vertex_shader);
+  glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &result);
+  if (result == GL_FALSE) {
+    glGetShaderInfoLog(vertex_shader, sizeof(info), &length, info);
+    spdlog::error("[camera_plugin] Failed to compile {}", info);
+    glDeleteShader(vertex_shader);
+    return 0;
+  }
+
+  const GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+  glShaderSource(fragment_shader, 1, &fsource, nullptr);
+  glCompileShader(fragment_shader);
+  glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &result);
+  if (result == GL_FALSE) {
+    glGetShaderInfoLog(fragment_shader, sizeof(info), &length, info);
+    spdlog::error("[camera_plugin] Failed to compile {}", info);
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+    return 0;
+  }
+
+  const GLuint program = glCreateProgram();
+  glAttachShader(program, vertex_shader);
+  glAttachShader(program, fragment_shader);
+  glLinkProgram(program);
+
+  glGetProgramiv(program, GL_LINK_STATUS, &result);
+  if (result == GL_FALSE) {
+    glGetProgramInfoLog(program, sizeof(info), &length, info);
+    spdlog::error("[camera_plugin] Failed to link {}", info);
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+    glDeleteProgram(program);
+    return 0;
+  }
+
+  glDetachShader(program, vertex_shader);
+  glDetachShader(program, fragment_shader);
+  glDeleteShader(vertex_shader);
+  glDeleteShader(fragment_shader);
+  return program;
+}
+
+}  // namespace camera_plugin
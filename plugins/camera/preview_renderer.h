@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLUTTER_PLUGIN_CAMERA_PREVIEW_RENDERER_H_
+#define FLUTTER_PLUGIN_CAMERA_PREVIEW_RENDERER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <GLES3/gl3.h>
+
+#include <libcamera/base/span.h>
+#include <libcamera/pixel_format.h>
+
+namespace camera_plugin {
+
+/**
+ * @brief Converts viewfinder frames into the RGBA texture presented to
+ * Flutter.  YUV to RGB conversion is done by a fragment shader; the CPU only
+ * uploads the planes as they were produced by the camera.
+ *
+ * Supported formats are NV12, YUYV and the packed 24-bit RGB formats emitted
+ * by virtual cameras such as vimc.
+ *
+ * All methods must be called with the texture registrar context current.
+ */
+class PreviewRenderer {
+ public:
+  PreviewRenderer(const libcamera::PixelFormat& format,
+                  GLsizei width,
+                  GLsizei height,
+                  unsigned int stride);
+  ~PreviewRenderer();
+
+  // Disallow copy and assign.
+  PreviewRenderer(const PreviewRenderer&) = delete;
+  PreviewRenderer& operator=(const PreviewRenderer&) = delete;
+
+  /**
+   * @brief Returns true if frames of this format can be rendered
+   * @param[in] format libcamera pixel format
+   * @return bool
+   * @relation
+   * libcamera
+   */
+  static bool IsSupported(const libcamera::PixelFormat& format);
+
+  /**
+   * @brief Upload a frame and convert it into the output texture
+   * @param[in] planes Mapped planes of the frame
+   * @return bool
+   * @retval true Output texture updated
+   * @retval false Frame layout does not match the configured stream
+   * @relation
+   * flutter
+   */
+  bool Render(const std::vector<libcamera::Span<uint8_t>>& planes);
+
+  GLuint textureId{};
+  GLuint framebuffer{};
+  GLsizei width;
+  GLsizei height;
+
+ private:
+  libcamera::PixelFormat format_;
+  unsigned int stride_;
+
+  GLuint program_{};
+  GLuint vertex_arr_id_{};
+  GLuint vertex_buffer_{};
+  GLuint coord_buffer_{};
+  GLuint innerTexture_[2]{};
+
+  // Scratch rows for strides GL can't describe, see UploadRows().
+  std::vector<uint8_t> repack_;
+
+  void CreateSourceTextures();
+  void UploadRows(GLsizei rows_width,
+                  GLsizei rows,
+                  GLenum format,
+                  unsigned int bytes_per_pixel,
+                  const uint8_t* data);
+  void Draw() const;
+
+  static GLuint LoadShaders(const GLchar* fsource);
+};
+
+}  // namespace camera_plugin
+
+#endif  // FLUTTER_PLUGIN_CAMERA_PREVIEW_RENDERER_H_
@@ -0,0 +1,362 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "video_recorder.h"
+
+#include <algorithm>
+#include <map>
+
+#include <libcamera/formats.h>
+
+extern "C" {
+#include <gst/allocators/gstdmabuf.h>
+#include <gst/app/gstappsrc.h>
+}
+
+#include <plugins/common/common.h>
+
+namespace camera_plugin {
+
+namespace {
+
+// Encoders in order of preference.
+constexpr const char* kEncoders[] = {"v4l2h264enc", "vah264enc",
+                                     "vaapih264enc", "x264enc"};
+
+constexpr GstClockTime kStopTimeout = 5 * GST_SECOND;
+
+GstVideoFormat ToGstVideoFormat(const libcamera::PixelFormat& format) {
+  if (format == libcamera::formats::NV12) {
+    return GST_VIDEO_FORMAT_NV12;
+  }
+  if (format == libcamera::formats::YUYV) {
+    return GST_VIDEO_FORMAT_YUY2;
+  }
+  // DRM RGB888 is stored B, G, R in memory, BGR888 R, G, B.
+  if (format == libcamera::formats::RGB888) {
+    return GST_VIDEO_FORMAT_BGR;
+  }
+  if (format == libcamera::formats::BGR888) {
+    return GST_VIDEO_FORMAT_RGB;
+  }
+  return GST_VIDEO_FORMAT_UNKNOWN;
+}
+
+}  // namespace
+
+VideoRecorder::VideoRecorder(const libcamera::StreamConfiguration& config,
+                             const int64_t fps,
+                             const int64_t bitrate)
+    : fps_(fps),
+      bitrate_(bitrate),
+      allocator_(gst_dmabuf_allocator_new()),
+      frame_duration_(fps > 0 ? GST_SECOND / static_cast<GstClockTime>(fps)
+                              : GST_SECOND / 30) {
+  gst_video_info_set_format(&info_, ToGstVideoFormat(config.pixelFormat),
+                            config.size.width, config.size.height);
+  if (fps_ > 0) {
+    GST_VIDEO_INFO_FPS_N(&info_) = static_cast<gint>(fps_);
+    GST_VIDEO_INFO_FPS_D(&info_) = 1;
+  }
+
+  // The camera pads rows; the luma stride applies to every plane of the
+  // formats produced by the viewfinder.
+  for (guint i = 0; i < GST_VIDEO_INFO_N_PLANES(&info_); i++) {
+    GST_VIDEO_INFO_PLANE_STRIDE(&info_, i) = static_cast<gint>(config.stride);
+  }
+  if (GST_VIDEO_INFO_N_PLANES(&info_) == 2) {
+    GST_VIDEO_INFO_PLANE_OFFSET(&info_, 1) =
+        static_cast<gsize>(config.stride) * config.size.height;
+  }
+}
+
+VideoRecorder::~VideoRecorder() {
+  Stop();
+  gst_object_unref(allocator_);
+}
+
+GstElement* VideoRecorder::CreateEncoder() const {
+  for (const auto name : kEncoders) {
+    GstElementFactory* factory = gst_element_factory_find(name);
+    if (factory == nullptr) {
+      continue;
+    }
+    GstElement* encoder = gst_element_factory_create(factory, "encoder");
+    gst_object_unref(factory);
+    if (encoder == nullptr) {
+      continue;
+    }
+
+    // Hardware encoders are registered even when the device is missing.
+    if (gst_element_set_state(encoder, GST_STATE_READY) ==
+        GST_STATE_CHANGE_FAILURE) {
+      SPDLOG_DEBUG("[camera_plugin] Encoder {} not usable", name);
+      gst_element_set_state(encoder, GST_STATE_NULL);
+      gst_object_unref(encoder);
+      continue;
+    }
+    gst_element_set_state(encoder, GST_STATE_NULL);
+
+    if (g_str_has_prefix(name, "x264")) {
+      gst_util_set_object_arg(G_OBJECT(encoder), "tune", "zerolatency");
+      gst_util_set_object_arg(G_OBJECT(encoder), "speed-preset", "superfast");
+    }
+    if (bitrate_ > 0) {
+      if (g_str_has_prefix(name, "v4l2")) {
+        GstStructure* controls =
+            gst_structure_new("controls", "video_bitrate", G_TYPE_INT,
+                              static_cast<gint>(bitrate_), nullptr);
+        g_object_set(encoder, "extra-controls", controls, nullptr);
+        gst_structure_free(controls);
+      } else {
+        // x264enc and the VA encoders take kbit/s.
+        g_object_set(encoder, "bitrate", static_cast<guint>(bitrate_ / 1000),
+                     nullptr);
+      }
+    }
+
+    spdlog::debug("[camera_plugin] Video encoder: {}", name);
+    return encoder;
+  }
+  return nullptr;
+}
+
+bool VideoRecorder::Start(const std::string& path) {
+  if (pipeline_) {
+    return false;
+  }
+  if (GST_VIDEO_INFO_FORMAT(&info_) == GST_VIDEO_FORMAT_UNKNOWN) {
+    spdlog::error("[camera_plugin] Unsupported recording format");
+    return false;
+  }
+
+  GstElement* encoder = CreateEncoder();
+  if (encoder == nullptr) {
+    spdlog::error("[camera_plugin] No usable H.264 encoder");
+    return false;
+  }
+
+  pipeline_ = gst_pipeline_new("camera-recorder");
+  appsrc_ = gst_element_factory_make("appsrc", "src");
+  // Passthrough unless the encoder does not accept the camera format.
+  GstElement* convert = gst_element_factory_make("videoconvert", nullptr);
+  GstElement* parse = gst_element_factory_make("h264parse", nullptr);
+  GstElement* mux = gst_element_factory_make("mp4mux", nullptr);
+  GstElement* sink = gst_element_factory_make("filesink", nullptr);
+  if (!appsrc_ || !convert || !parse || !mux || !sink) {
+    spdlog::error(
+        "[camera_plugin] Failed to create recording pipeline.  May be a "
+        "missing runtime package");
+    for (const auto element : {appsrc_, convert, parse, mux, sink}) {
+      if (element) {
+        gst_object_unref(element);
+      }
+    }
+    gst_object_unref(encoder);
+    gst_object_unref(pipeline_);
+    pipeline_ = nullptr;
+    appsrc_ = nullptr;
+    return false;
+  }
+
+  GstCaps* caps = gst_video_info_to_caps(&info_);
+  g_object_set(appsrc_, "caps", caps, "is-live", TRUE, "format",
+               GST_FORMAT_TIME, "do-timestamp", FALSE, nullptr);
+  gst_caps_unref(caps);
+  g_object_set(sink, "location", path.c_str(), nullptr);
+
+  gst_bin_add_many(GST_BIN(pipeline_), appsrc_, convert, encoder, parse, mux,
+                   sink, nullptr);
+  if (!gst_element_link_many(appsrc_, convert, encoder, parse, mux, sink,
+                             nullptr)) {
+    spdlog::error("[camera_plugin] Failed to link recording pipeline");
+    gst_object_unref(pipeline_);
+    pipeline_ = nullptr;
+    appsrc_ = nullptr;
+    return false;
+  }
+
+  if (gst_element_set_state(pipeline_, GST_STATE_PLAYING) ==
+      GST_STATE_CHANGE_FAILURE) {
+    spdlog::error("[camera_plugin] Failed to start recording pipeline");
+    gst_element_set_state(pipeline_, GST_STATE_NULL);
+    gst_object_unref(pipeline_);
+    pipeline_ = nullptr;
+    appsrc_ = nullptr;
+    return false;
+  }
+
+  std::lock_guard lock(mutex_);
+  path_ = path;
+  running_ = true;
+  paused_ = false;
+  resumed_ = false;
+  base_timestamp_ = -1;
+  timestamp_offset_ = 0;
+  last_pts_ = GST_CLOCK_TIME_NONE;
+  return true;
+}
+
+bool VideoRecorder::PushFrame(const libcamera::FrameBuffer* buffer,
+                              std::function<void()> release) {
+  GstBuffer* gst_buffer;
+  {
+    std::lock_guard lock(mutex_);
+    if (!running_ || paused_ || in_flight_ >= kMaxFramesInFlight) {
+      return false;
+    }
+
+    const auto timestamp = static_cast<int64_t>(buffer->metadata().timestamp);
+    if (base_timestamp_ < 0) {
+      base_timestamp_ = timestamp;
+    }
+    auto pts = timestamp - base_timestamp_ - timestamp_offset_;
+    if (resumed_) {
+      // Close the gap left by the pause; the segment stays continuous.
+      if (GST_CLOCK_TIME_IS_VALID(last_pts_)) {
+        const auto next = static_cast<int64_t>(last_pts_ + frame_duration_);
+        timestamp_offset_ += pts - next;
+        pts = next;
+      }
+      resumed_ = false;
+    }
+    if (pts < 0 || (GST_CLOCK_TIME_IS_VALID(last_pts_) &&
+                    static_cast<GstClockTime>(pts) <= last_pts_)) {
+      return false;
+    }
+
+    // One memory per dmabuf; planes sharing a dmabuf become offsets into it.
+    gst_buffer = gst_buffer_new();
+    std::map<int, gsize> lengths;
+    for (const auto& plane : buffer->planes()) {
+      const int fd = plane.fd.get();
+      lengths[fd] = std::max(lengths[fd],
+                             static_cast<gsize>(plane.offset + plane.length));
+    }
+    std::map<int, gsize> memory_offsets;
+    gsize total = 0;
+    for (const auto& [fd, length] : lengths) {
+      // libcamera owns the fd for the lifetime of the allocator.
+      gst_buffer_append_memory(gst_buffer,
+                               gst_dmabuf_allocator_alloc_with_flags(
+                                   allocator_, fd, length,
+                                   GST_FD_MEMORY_FLAG_DONT_CLOSE));
+      memory_offsets[fd] = total;
+      total += length;
+    }
+
+    gsize offsets[GST_VIDEO_MAX_PLANES]{};
+    gint strides[GST_VIDEO_MAX_PLANES]{};
+    const guint n_planes = GST_VIDEO_INFO_N_PLANES(&info_);
+    const auto& planes = buffer->planes();
+    for (guint i = 0; i < n_planes; i++) {
+      strides[i] = GST_VIDEO_INFO_PLANE_STRIDE(&info_, i);
+      if (i < planes.size()) {
+        offsets[i] = memory_offsets[planes[i].fd.get()] + planes[i].offset;
+      } else {
+        // Contiguous single plane buffer
+        offsets[i] = offsets[0] + GST_VIDEO_INFO_PLANE_OFFSET(&info_, i);
+      }
+    }
+    gst_buffer_add_video_meta_full(
+        gst_buffer, GST_VIDEO_FRAME_FLAG_NONE, GST_VIDEO_INFO_FORMAT(&info_),
+        GST_VIDEO_INFO_WIDTH(&info_), GST_VIDEO_INFO_HEIGHT(&info_), n_planes,
+        offsets, strides);
+
+    GST_BUFFER_PTS(gst_buffer) = static_cast<GstClockTime>(pts);
+    GST_BUFFER_DURATION(gst_buffer) = frame_duration_;
+    last_pts_ = static_cast<GstClockTime>(pts);
+    in_flight_++;
+  }
+
+  gst_mini_object_weak_ref(GST_MINI_OBJECT(gst_buffer), OnBufferFinalized,
+                           new FrameRelease{this, std::move(release)});
+
+  // The weak ref fires even if the push fails, so the request is returned.
+  if (const auto ret =
+          gst_app_src_push_buffer(GST_APP_SRC(appsrc_), gst_buffer);
+      ret != GST_FLOW_OK) {
+    SPDLOG_DEBUG("[camera_plugin] push-buffer: {}", gst_flow_get_name(ret));
+  }
+  return true;
+}
+
+void VideoRecorder::OnBufferFinalized(const gpointer user_data,
+                                      GstMiniObject* /* obj */) {
+  const auto frame = static_cast<FrameRelease*>(user_data);
+  {
+    std::lock_guard lock(frame->recorder->mutex_);
+    frame->recorder->in_flight_--;
+  }
+  frame->release();
+  delete frame;
+}
+
+void VideoRecorder::Pause() {
+  std::lock_guard lock(mutex_);
+  paused_ = true;
+}
+
+void VideoRecorder::Resume() {
+  std::lock_guard lock(mutex_);
+  if (paused_) {
+    paused_ = false;
+    resumed_ = true;
+  }
+}
+
+bool VideoRecorder::Stop() {
+  {
+    std::lock_guard lock(mutex_);
+    if (!running_) {
+      return false;
+    }
+    running_ = false;
+  }
+
+  // mp4mux writes the moov atom on EOS.
+  gst_app_src_end_of_stream(GST_APP_SRC(appsrc_));
+
+  bool result = false;
+  GstBus* bus = gst_element_get_bus(pipeline_);
+  if (GstMessage* msg = gst_bus_timed_pop_filtered(
+          bus, kStopTimeout,
+          static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR))) {
+    if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_EOS) {
+      result = true;
+    } else {
+      GError* err;
+      gchar* debug;
+      gst_message_parse_error(msg, &err, &debug);
+      spdlog::error("[camera_plugin] Recording failed: {}", err->message);
+      g_error_free(err);
+      g_free(debug);
+    }
+    gst_message_unref(msg);
+  } else {
+    spdlog::error("[camera_plugin] Timed out finalizing {}", path_);
+  }
+  gst_object_unref(bus);
+
+  // Releases every frame still held by the pipeline.
+  gst_element_set_state(pipeline_, GST_STATE_NULL);
+  gst_object_unref(pipeline_);
+  pipeline_ = nullptr;
+  appsrc_ = nullptr;
+  return result;
+}
+
+}  // namespace camera_plugin
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLUTTER_PLUGIN_CAMERA_VIDEO_RECORDER_H_
+#define FLUTTER_PLUGIN_CAMERA_VIDEO_RECORDER_H_
+
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include <libcamera/framebuffer.h>
+#include <libcamera/stream.h>
+
+extern "C" {
+#include <gst/gst.h>
+#include <gst/video/video.h>
+}
+
+namespace camera_plugin {
+
+/**
+ * @brief Encodes viewfinder frames into an MP4 file.
+ *
+ * Frames are handed to an appsrc as DMA-BUF memory, so nothing is copied on
+ * the way to the encoder.  V4L2 and VA hardware encoders are preferred over
+ * x264.  Pausing drops frames and shifts the timestamps of later frames, so
+ * the encoder keeps running and the file has no gap.
+ */
+class VideoRecorder {
+ public:
+  /// Frames owned by the encoder at once.  Newer frames are dropped beyond
+  /// this so the camera request pool is never drained.
+  static constexpr unsigned int kMaxFramesInFlight = 2;
+
+  VideoRecorder(const libcamera::StreamConfiguration& config,
+                int64_t fps,
+                int64_t bitrate);
+  ~VideoRecorder();
+
+  // Disallow copy and assign.
+  VideoRecorder(const VideoRecorder&) = delete;
+  VideoRecorder& operator=(const VideoRecorder&) = delete;
+
+  /**
+   * @brief Build the encode pipeline and start it
+   * @param[in] path Output file
+   * @return bool
+   * @relation
+   * gstreamer
+   */
+  bool Start(const std::string& path);
+
+  /**
+   * @brief Queue a frame for encoding
+   * @param[in] buffer Completed viewfinder buffer
+   * @param[in] release Called once the encoder no longer needs the buffer
+   * @return bool
+   * @retval true Frame queued, release will be called later
+   * @retval false Frame dropped, release is not called
+   * @relation
+   * gstreamer
+   */
+  bool PushFrame(const libcamera::FrameBuffer* buffer,
+                 std::function<void()> release);
+
+  /**
+   * @brief Drop incoming frames until Resume
+   * @return void
+   */
+  void Pause();
+
+  /**
+   * @brief Continue encoding after Pause
+   * @return void
+   */
+  void Resume();
+
+  /**
+   * @brief Finalize the file and tear down the pipeline
+   * @return bool
+   * @retval true File written
+   * @retval false Pipeline reported an error
+   * @relation
+   * gstreamer
+   */
+  bool Stop();
+
+  [[nodiscard]] const std::string& path() const { return path_; }
+
+ private:
+  GstVideoInfo info_{};
+  int64_t fps_;
+  int64_t bitrate_;
+  std::string path_;
+
+  GstElement* pipeline_{};
+  GstElement* appsrc_{};
+  GstAllocator* allocator_{};
+
+  std::mutex mutex_;
+  bool running_{};
+  bool paused_{};
+  bool resumed_{};
+  unsigned int in_flight_{};
+  int64_t base_timestamp_ = -1;
+  int64_t timestamp_offset_{};
+  GstClockTime last_pts_ = GST_CLOCK_TIME_NONE;
+  GstClockTime frame_duration_;
+
+  /**
+   * @brief Select the preferred usable H.264 encoder
+   * @return GstElement* New encoder element, nullptr if none is usable
+   * @relation
+   * gstreamer
+   */
+  GstElement* CreateEncoder() const;
+
+  struct FrameRelease {
+    VideoRecorder* recorder;
+    std::function<void()> release;
+  };
+
+  static void OnBufferFinalized(gpointer user_data, GstMiniObject* obj);
+};
+
+}  // namespace camera_plugin
+
+#endif  // FLUTTER_PLUGIN_CAMERA_VIDEO_RECORDER_H_
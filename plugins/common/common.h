@@ -26,5 +26,6 @@
 #include "tools/encodable.h"
 #include "tools/hexdump.h"
 #include "uuid/uuidxx.h"
+#include "xdg/user_dirs.h"
 
 #endif  // FLUTTER_PLUGIN_COMMON_COMMON_H_
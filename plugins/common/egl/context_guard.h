@@ -0,0 +1,65 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLUGINS_COMMON_EGL_CONTEXT_GUARD_H_
+#define PLUGINS_COMMON_EGL_CONTEXT_GUARD_H_
+
+#include <EGL/egl.h>
+
+namespace plugin_common_egl {
+
+// Saves the EGL display, surfaces and context bound on the calling thread
+// and rebinds them when it goes out of scope.
+//
+// Texture callbacks (ObtainDescriptor) run on the raster thread with the
+// engine's context bound. Making the texture context current and then
+// clearing it would leave the engine without a context for the rest of the
+// frame, so take one of these before TextureMakeCurrent() instead of
+// calling TextureClearCurrent().
+class ContextGuard {
+ public:
+  ContextGuard()
+      : display_(eglGetCurrentDisplay()),
+        draw_(eglGetCurrentSurface(EGL_DRAW)),
+        read_(eglGetCurrentSurface(EGL_READ)),
+        context_(eglGetCurrentContext()) {}
+
+  ~ContextGuard() {
+    if (display_ != EGL_NO_DISPLAY && context_ != EGL_NO_CONTEXT) {
+      eglMakeCurrent(display_, draw_, read_, context_);
+      return;
+    }
+    // Nothing was bound before; release whatever the scope bound.
+    if (const EGLDisplay current = eglGetCurrentDisplay();
+        current != EGL_NO_DISPLAY) {
+      eglMakeCurrent(current, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+  }
+
+  // Prevent copying.
+  ContextGuard(ContextGuard const&) = delete;
+  ContextGuard& operator=(ContextGuard const&) = delete;
+
+ private:
+  const EGLDisplay display_;
+  const EGLSurface draw_;
+  const EGLSurface read_;
+  const EGLContext context_;
+};
+
+}  // namespace plugin_common_egl
+
+#endif  // PLUGINS_COMMON_EGL_CONTEXT_GUARD_H_
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "user_dirs.h"
+
+#include <cstring>
+#include <fstream>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "../logging.h"
+#include "../string/string_tools.h"
+
+namespace plugin_common {
+
+static constexpr char kUserDirsFile[] = "user-dirs.dirs";
+static constexpr char kHomeVariable[] = "$HOME";
+static constexpr char kWhitespace[] = " \t\r\n";
+
+XdgUserDirs& XdgUserDirs::GetInstance() {
+  static XdgUserDirs instance;
+  return instance;
+}
+
+XdgUserDirs::XdgUserDirs() {
+  if (const char* home = getenv("HOME")) {
+    home_ = home;
+  }
+  if (const char* config = getenv("XDG_CONFIG_HOME");
+      config != nullptr && config[0] == '/') {
+    config_dir_ = config;
+  } else if (!home_.empty()) {
+    config_dir_ = home_ + "/.config";
+  }
+
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ == -1) {
+    spdlog::warn("[XdgUserDirs] inotify unavailable: {}", strerror(errno));
+    return;
+  }
+  ArmWatch();
+}
+
+void XdgUserDirs::ArmWatch() {
+  // Watch the directory; xdg-user-dirs-update replaces the file.
+  watch_fd_ = inotify_add_watch(inotify_fd_, config_dir_.c_str(),
+                                IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM |
+                                    IN_CREATE | IN_DELETE | IN_DELETE_SELF |
+                                    IN_MOVE_SELF);
+  if (watch_fd_ == -1) {
+    SPDLOG_DEBUG("[XdgUserDirs] Not watching {}, checking mtime: {}",
+                 config_dir_, strerror(errno));
+  }
+}
+
+XdgUserDirs::~XdgUserDirs() {
+  if (inotify_fd_ != -1) {
+    close(inotify_fd_);
+  }
+}
+
+std::optional<std::string> XdgUserDirs::Get(const std::string& name) {
+  std::lock_guard lock(mutex_);
+  PollChanges();
+  if (stale_) {
+    Load();
+  }
+
+  if (const auto it = dirs_.find(name); it != dirs_.end()) {
+    return it->second;
+  }
+  if (home_.empty()) {
+    return std::nullopt;
+  }
+  if (name == "DESKTOP") {
+    return home_ + "/Desktop";
+  }
+  return home_;
+}
+
+void XdgUserDirs::PollChanges() {
+  if (watch_fd_ == -1) {
+    // A missing file keeps the zero inode and mtime.
+    struct stat st {};
+    if (!config_dir_.empty()) {
+      stat((config_dir_ + "/" + kUserDirsFile).c_str(), &st);
+    }
+    if (st.st_ino != inode_ || st.st_mtim.tv_sec != mtime_.tv_sec ||
+        st.st_mtim.tv_nsec != mtime_.tv_nsec) {
+      inode_ = st.st_ino;
+      mtime_ = st.st_mtim;
+      stale_ = true;
+    }
+    return;
+  }
+
+  alignas(inotify_event) char buffer[4096];
+  ssize_t length;
+  bool lost_watch = false;
+  while ((length = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+    for (const char* ptr = buffer; ptr < buffer + length;) {
+      const auto event = reinterpret_cast<const inotify_event*>(ptr);
+      if ((event->mask & IN_Q_OVERFLOW) ||
+          (event->len && std::strcmp(event->name, kUserDirsFile) == 0)) {
+        stale_ = true;
+      }
+      // The directory itself was deleted or moved away; the kernel drops
+      // the watch with IN_IGNORED.
+      if (event->wd == watch_fd_ &&
+          (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))) {
+        lost_watch = true;
+      }
+      ptr += sizeof(inotify_event) + event->len;
+    }
+  }
+
+  if (lost_watch) {
+    stale_ = true;
+    inotify_rm_watch(inotify_fd_, watch_fd_);
+    // Falls back to checking the mtime if the directory is not back yet.
+    ArmWatch();
+    if (watch_fd_ == -1) {
+      inode_ = {};
+      mtime_ = {};
+    }
+  }
+}
+
+void XdgUserDirs::Load() {
+  stale_ = false;
+  dirs_.clear();
+  if (config_dir_.empty()) {
+    return;
+  }
+
+  std::ifstream file(config_dir_ + "/" + kUserDirsFile);
+  std::string line;
+  while (std::getline(file, line)) {
+    StringTools::trim(line, kWhitespace);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    // XDG_<NAME>_DIR="$HOME/<path>" or XDG_<NAME>_DIR="/<path>"
+    const auto equals = line.find('=');
+    if (equals == std::string::npos) {
+      continue;
+    }
+    std::string key = line.substr(0, equals);
+    StringTools::trim(key, kWhitespace);
+    if (key.size() <= 8 || key.compare(0, 4, "XDG_") != 0 ||
+        key.compare(key.size() - 4, 4, "_DIR") != 0) {
+      continue;
+    }
+
+    std::string value = line.substr(equals + 1);
+    StringTools::trim(value, kWhitespace);
+    if (value.size() < 2 || value.front() != '"' || value.back() != '"') {
+      continue;
+    }
+    std::string path;
+    for (size_t i = 1; i + 1 < value.size(); i++) {
+      if (value[i] == '\\' && i + 2 < value.size()) {
+        i++;
+      }
+      path.push_back(value[i]);
+    }
+
+    if (path.compare(0, sizeof(kHomeVariable) - 1, kHomeVariable) == 0) {
+      path = home_ + path.substr(sizeof(kHomeVariable) - 1);
+    } else if (path.empty() || path[0] != '/') {
+      continue;
+    }
+
+    dirs_[key.substr(4, key.size() - 8)] = std::move(path);
+  }
+
+  SPDLOG_DEBUG("[XdgUserDirs] Loaded {} entries", dirs_.size());
+}
+
+}  // namespace plugin_common
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLUGINS_COMMON_XDG_USER_DIRS_H_
+#define PLUGINS_COMMON_XDG_USER_DIRS_H_
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include <sys/stat.h>
+
+namespace plugin_common {
+
+/**
+ * @brief In-process equivalent of the xdg-user-dir command.
+ *
+ * user-dirs.dirs is parsed once and re-parsed only when inotify reports a
+ * change to it, so lookups never spawn a process.  Without an inotify watch,
+ * or once the watched directory is deleted or moved, each lookup compares
+ * the file's inode and mtime instead.
+ */
+class XdgUserDirs {
+ public:
+  ~XdgUserDirs();
+
+  // Returns the shared XdgUserDirs instance.
+  static XdgUserDirs& GetInstance();
+
+  /**
+   * @brief Resolve a user directory
+   * @param[in] name Directory name without prefix, e.g. "PICTURES", "VIDEOS"
+   * @return std::optional<std::string>
+   * @retval Directory path.  Unset directories resolve like xdg-user-dir:
+   * DESKTOP to $HOME/Desktop, anything else to $HOME.
+   * @retval std::nullopt $HOME is not set
+   * @relation
+   * internal
+   */
+  std::optional<std::string> Get(const std::string& name);
+
+  // Prevent copying.
+  XdgUserDirs(XdgUserDirs const&) = delete;
+  XdgUserDirs& operator=(XdgUserDirs const&) = delete;
+
+ protected:
+  // Clients should always use GetInstance().
+  XdgUserDirs();
+
+ private:
+  std::mutex mutex_;
+  std::string home_;
+  std::string config_dir_;
+  std::map<std::string, std::string> dirs_;
+  int inotify_fd_ = -1;
+  int watch_fd_ = -1;
+  bool stale_ = true;
+  // Identity of the parsed file, for when there is no inotify watch.
+  ino_t inode_{};
+  timespec mtime_{};
+
+  /**
+   * @brief Watch the config directory, leaving watch_fd_ at -1 on failure
+   * @return void
+   * @relation
+   * internal
+   */
+  void ArmWatch();
+
+  /**
+   * @brief Drain pending inotify events, or without a watch stat the file,
+   * marking the cache stale on change
+   * @return void
+   * @relation
+   * internal
+   */
+  void PollChanges();
+
+  /**
+   * @brief Parse user-dirs.dirs into dirs_
+   * @return void
+   * @relation
+   * internal
+   */
+  void Load();
+};
+
+}  // namespace plugin_common
+
+#endif  // PLUGINS_COMMON_XDG_USER_DIRS_H_
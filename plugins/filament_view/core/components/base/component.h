@@ -39,8 +39,11 @@ class Component {
 
   [[nodiscard]] virtual size_t GetTypeID() const = 0;
 
+  // typeid().hash_code() hashes the mangled name on every call, so derived
+  // classes cache it.
   [[nodiscard]] static size_t StaticGetTypeID() {
-    return typeid(Component).hash_code();
+    static const size_t typeID = typeid(Component).hash_code();
+    return typeID;
   }
 
   virtual ~Component() = default;
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace plugin_filament_view {
+
+// Sparse set of the components of type T a system iterates every frame,
+// keyed by the owning entity's pool index (EntityObject::nGetPoolIndex).
+// The system inserts on entity registration and erases on unregistration,
+// so the pool holds exactly the components it updates.
+//
+// Components stay individually allocated and owned by their entity (shapes
+// keep weak_ptrs to them), so this is a dense array of pointers: it saves
+// the GUID map walk and the per-entity component search, not cache misses
+// on the components themselves. Only Animation is pooled; transforms and
+// collidables are not walked per frame (collision queries read the
+// ray_batch SoA arrays instead).
+//
+// Insert, erase and lookup are O(1); erase swaps the last element into the
+// hole, so iteration order is not stable.
+template <typename T>
+class ComponentPool {
+ public:
+  static ComponentPool& GetInstance() {
+    static ComponentPool pool;
+    return pool;
+  }
+
+  ComponentPool(const ComponentPool&) = delete;
+  ComponentPool& operator=(const ComponentPool&) = delete;
+
+  void vInsert(const uint32_t nEntityIndex, T* poComponent) {
+    std::lock_guard lock(m_oMutex);
+    if (nEntityIndex >= m_vecSparse.size()) {
+      m_vecSparse.resize(nEntityIndex + 1, kInvalidIndex);
+    }
+
+    // An entity holds one component per type; a second add replaces it.
+    if (const uint32_t nDense = m_vecSparse[nEntityIndex];
+        nDense != kInvalidIndex) {
+      m_vecComponents[nDense] = poComponent;
+      return;
+    }
+
+    m_vecSparse[nEntityIndex] = static_cast<uint32_t>(m_vecComponents.size());
+    m_vecComponents.push_back(poComponent);
+    m_vecDenseToEntity.push_back(nEntityIndex);
+  }
+
+  void vErase(const uint32_t nEntityIndex) {
+    std::lock_guard lock(m_oMutex);
+    if (nEntityIndex >= m_vecSparse.size() ||
+        m_vecSparse[nEntityIndex] == kInvalidIndex) {
+      return;
+    }
+
+    const uint32_t nDense = m_vecSparse[nEntityIndex];
+    const uint32_t nLast = static_cast<uint32_t>(m_vecComponents.size() - 1);
+    if (nDense != nLast) {
+      m_vecComponents[nDense] = m_vecComponents[nLast];
+      m_vecDenseToEntity[nDense] = m_vecDenseToEntity[nLast];
+      m_vecSparse[m_vecDenseToEntity[nDense]] = nDense;
+    }
+
+    m_vecComponents.pop_back();
+    m_vecDenseToEntity.pop_back();
+    m_vecSparse[nEntityIndex] = kInvalidIndex;
+  }
+
+  [[nodiscard]] size_t nSize() {
+    std::lock_guard lock(m_oMutex);
+    return m_vecComponents.size();
+  }
+
+  // Calls fn(T&) for every component in dense order. The pool
+  // is locked for the duration, so fn must not add or remove components of
+  // this type.
+  template <typename Fn>
+  void vForEach(Fn&& fn) {
+    std::lock_guard lock(m_oMutex);
+    for (size_t i = 0; i < m_vecComponents.size(); ++i) {
+      fn(*m_vecComponents[i]);
+    }
+  }
+
+ private:
+  static constexpr uint32_t kInvalidIndex =
+      std::numeric_limits<uint32_t>::max();
+
+  ComponentPool() = default;
+
+  // Entities are created on the platform thread during scene setup while
+  // systems iterate on the Filament API thread.
+  std::mutex m_oMutex;
+
+  // Entity pool index -> dense index.
+  std::vector<uint32_t> m_vecSparse;
+  // Dense arrays, index aligned.
+  std::vector<T*> m_vecComponents;
+  std::vector<uint32_t> m_vecDenseToEntity;
+};
+
+}  // namespace plugin_filament_view
@@ -33,7 +33,10 @@ class Animation final : public Component {
 
   void DebugPrint(const std::string& tabPrefix) const override;
 
-  static size_t StaticGetTypeID() { return typeid(Animation).hash_code(); }
+  static size_t StaticGetTypeID() {
+    static const size_t typeID = typeid(Animation).hash_code();
+    return typeID;
+  }
 
   [[nodiscard]] size_t GetTypeID() const override { return StaticGetTypeID(); }
 
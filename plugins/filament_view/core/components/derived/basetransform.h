@@ -67,7 +67,10 @@ class BaseTransform : public Component {
 
   void DebugPrint(const std::string& tabPrefix) const override;
 
-  static size_t StaticGetTypeID() { return typeid(BaseTransform).hash_code(); }
+  static size_t StaticGetTypeID() {
+    static const size_t typeID = typeid(BaseTransform).hash_code();
+    return typeID;
+  }
 
   [[nodiscard]] size_t GetTypeID() const override { return StaticGetTypeID(); }
 
@@ -122,6 +122,31 @@ void Collidable::DebugPrint(const std::string& tabPrefix) const {
                 m_f3ExtentsSize.y, m_f3ExtentsSize.z);
 }
 
+////////////////////////////////////////////////////////////////////////////
+Aabb Collidable::GetWorldAabb() const {
+  const filament::math::float3& center = m_f3CenterPosition;
+
+  filament::math::float3 halfExtents;
+  switch (m_eShapeType) {
+    case ShapeType::Sphere:
+      // Matches bDoesIntersect, where extents.x is the radius.
+      halfExtents = {m_f3ExtentsSize.x, m_f3ExtentsSize.x, m_f3ExtentsSize.x};
+      break;
+    case ShapeType::Cube:
+      halfExtents = m_f3ExtentsSize * 0.5f;
+      break;
+    case ShapeType::Plane:
+      // Y-up quad, flat in y.
+      halfExtents = {m_f3ExtentsSize.x * 0.5f, 0.0f, m_f3ExtentsSize.z * 0.5f};
+      break;
+    default:
+      halfExtents = {0.0f, 0.0f, 0.0f};
+      break;
+  }
+
+  return {center - halfExtents, center + halfExtents};
+}
+
 ////////////////////////////////////////////////////////////////////////////
 bool Collidable::bDoesIntersect(const Ray& ray,
                                 filament::math::float3& hitPosition) const {
@@ -150,7 +175,6 @@ bool Collidable::bDoesIntersect(const Ray& ray,
       if (float discriminant = b * b - 4 * a * c; discriminant > 0) {
         if (float t = (-b - sqrt(discriminant)) / (2.0f * a); t > 0) {
           hitPosition = rayOrigin + t * rayDirection;
-          SPDLOG_INFO("Collided with sphere {}", GetOwner()->GetGlobalGuid());
           return true;  // Ray hits the sphere
         }
       }
@@ -197,7 +221,6 @@ bool Collidable::bDoesIntersect(const Ray& ray,
 
       if (tmin > 0) {
         hitPosition = rayOrigin + tmin * rayDirection;
-        SPDLOG_INFO("Collided with cube {}", GetOwner()->GetGlobalGuid());
         return true;  // Ray hits the cube
       }
       break;
@@ -219,7 +242,6 @@ bool Collidable::bDoesIntersect(const Ray& ray,
           if (filament::math::float3 localHit = hitPosition - center;
               fabs(localHit.x) <= extents.x * 0.5f &&
               fabs(localHit.z) <= extents.z * 0.5f) {
-            SPDLOG_INFO("Collided with quad {}", GetOwner()->GetGlobalGuid());
             return true;  // Ray hits the quad
           }
         }
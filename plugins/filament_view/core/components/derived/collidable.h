@@ -19,6 +19,7 @@
 
 #include <core/components/base/component.h>
 #include <core/include/shapetypes.h>
+#include <core/scene/geometry/aabb_tree.h>
 #include <core/scene/geometry/ray.h>
 
 namespace plugin_filament_view {
@@ -83,7 +84,14 @@ class Collidable : public Component {
   bool bDoesIntersect(const Ray& ray,
                       ::filament::math::float3& hitPosition) const;
 
-  static size_t StaticGetTypeID() { return typeid(Collidable).hash_code(); }
+  // World space box around the shape, used to place it in the collision
+  // system's BVH.
+  [[nodiscard]] Aabb GetWorldAabb() const;
+
+  static size_t StaticGetTypeID() {
+    static const size_t typeID = typeid(Collidable).hash_code();
+    return typeID;
+  }
 
   [[nodiscard]] size_t GetTypeID() const override { return StaticGetTypeID(); }
 
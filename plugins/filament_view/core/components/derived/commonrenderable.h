@@ -53,7 +53,8 @@ class CommonRenderable : public Component {
   void DebugPrint(const std::string& tabPrefix) const override;
 
   static size_t StaticGetTypeID() {
-    return typeid(CommonRenderable).hash_code();
+    static const size_t typeID = typeid(CommonRenderable).hash_code();
+    return typeID;
   }
 
   [[nodiscard]] size_t GetTypeID() const override { return StaticGetTypeID(); }
@@ -99,7 +99,10 @@ class Light : public Component {
 
   void DebugPrint(const std::string& tabPrefix) const override;
 
-  static size_t StaticGetTypeID() { return typeid(Light).hash_code(); }
+  static size_t StaticGetTypeID() {
+    static const size_t typeID = typeid(Light).hash_code();
+    return typeID;
+  }
 
   [[nodiscard]] size_t GetTypeID() const override { return StaticGetTypeID(); }
 
@@ -74,7 +74,8 @@ class MaterialDefinitions : public Component {
   void DebugPrint(const std::string& tabPrefix) const override;
 
   static size_t StaticGetTypeID() {
-    return typeid(MaterialDefinitions).hash_code();
+    static const size_t typeID = typeid(MaterialDefinitions).hash_code();
+    return typeID;
   }
 
   [[nodiscard]] size_t GetTypeID() const override { return StaticGetTypeID(); }
@@ -15,6 +15,8 @@
  */
 #include "entityobject.h"
 
+#include <algorithm>
+#include <core/components/base/component_pool.h>
 #include <core/components/derived/animation.h>
 #include <core/components/derived/light.h>
 #include <core/include/literals.h>
@@ -24,17 +26,61 @@
 #include <core/systems/ecsystems_manager.h>
 #include <core/utils/uuidGenerator.h>
 #include <plugins/common/common.h>
+#include <mutex>
 #include <utility>
 
 namespace plugin_filament_view {
 
+namespace {
+
+// Pool indices are recycled so the ComponentPool sparse tables stay sized to
+// the peak live entity count rather than every entity ever created.
+std::mutex poolIndexMutex;
+std::vector<uint32_t> freePoolIndices;
+uint32_t nextPoolIndex = 0;
+
+uint32_t nAcquirePoolIndex() {
+  std::lock_guard lock(poolIndexMutex);
+  if (freePoolIndices.empty()) {
+    return nextPoolIndex++;
+  }
+  const uint32_t index = freePoolIndices.back();
+  freePoolIndices.pop_back();
+  return index;
+}
+
+void vReleasePoolIndex(const uint32_t index) {
+  std::lock_guard lock(poolIndexMutex);
+  freePoolIndices.push_back(index);
+}
+
+}  // namespace
+
 /////////////////////////////////////////////////////////////////////////////////////////
 EntityObject::EntityObject(std::string name)
-    : global_guid_(generateUUID()), name_(std::move(name)) {}
+    : global_guid_(generateUUID()),
+      name_(std::move(name)),
+      m_nPoolIndex(nAcquirePoolIndex()) {}
 
 /////////////////////////////////////////////////////////////////////////////////////////
 EntityObject::EntityObject(std::string name, std::string global_guid)
-    : global_guid_(std::move(global_guid)), name_(std::move(name)) {}
+    : global_guid_(std::move(global_guid)),
+      name_(std::move(name)),
+      m_nPoolIndex(nAcquirePoolIndex()) {}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+EntityObject::~EntityObject() {
+  vUnregisterEntity();
+
+  for (const auto& component : components_) {
+    vRemoveFromComponentPool(component->GetTypeID());
+  }
+
+  // smart ptrs in components deleted on clear.
+  components_.clear();
+
+  vReleasePoolIndex(m_nPoolIndex);
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////
 void EntityObject::vOverrideName(const std::string& name) {
@@ -92,7 +138,7 @@ void EntityObject::vUnregisterEntity() {
 
   const auto objectLocatorSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<EntityObjectLocatorSystem>(
-          EntityObjectLocatorSystem::StaticGetTypeID(), "vRegisterEntity");
+          "vRegisterEntity");
 
   objectLocatorSystem->vUnregisterEntityObject(shared_from_this());
 
@@ -107,7 +153,7 @@ void EntityObject::vRegisterEntity() {
 
   const auto objectLocatorSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<EntityObjectLocatorSystem>(
-          EntityObjectLocatorSystem::StaticGetTypeID(), "vRegisterEntity");
+          "vRegisterEntity");
 
   objectLocatorSystem->vRegisterEntityObject(shared_from_this());
 
@@ -130,12 +176,14 @@ void EntityObject::vShallowCopyComponentToOther(size_t staticTypeID,
 void EntityObject::vAddComponent(std::shared_ptr<Component> component,
                                  const bool bAutoAddToSystems) {
   component->entityOwner_ = this;
+  // Added first, so systems can look the component up on registration.
+  components_.push_back(component);
 
   if (bAutoAddToSystems) {
     if (component->GetTypeID() == Light::StaticGetTypeID()) {
       const auto lightSystem =
           ECSystemManager::GetInstance()->poGetSystemAs<LightSystem>(
-              LightSystem::StaticGetTypeID(), __FUNCTION__);
+              __FUNCTION__);
 
       lightSystem->vRegisterEntityObject(shared_from_this());
     }
@@ -143,13 +191,29 @@ void EntityObject::vAddComponent(std::shared_ptr<Component> component,
     if (component->GetTypeID() == Animation::StaticGetTypeID()) {
       const auto animationSystem =
           ECSystemManager::GetInstance()->poGetSystemAs<AnimationSystem>(
-              AnimationSystem::StaticGetTypeID(), "loadModelGltf");
+              "loadModelGltf");
 
       animationSystem->vRegisterEntityObject(shared_from_this());
     }
   }
+}
 
-  components_.emplace_back(std::move(component));
+/////////////////////////////////////////////////////////////////////////////////////////
+void EntityObject::vRemoveComponent(const size_t staticTypeID) {
+  vRemoveFromComponentPool(staticTypeID);
+
+  components_.erase(std::remove_if(components_.begin(), components_.end(),
+                                   [&](auto& item) {
+                                     return item->GetTypeID() == staticTypeID;
+                                   }),
+                    components_.end());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+void EntityObject::vRemoveFromComponentPool(const size_t staticTypeID) const {
+  if (staticTypeID == Animation::StaticGetTypeID()) {
+    ComponentPool<Animation>::GetInstance().vErase(m_nPoolIndex);
+  }
 }
 
 }  // namespace plugin_filament_view
\ No newline at end of file
@@ -16,6 +16,8 @@
 #pragma once
 
 #include <encodable_value.h>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -55,6 +57,10 @@ class EntityObject : public std::enable_shared_from_this<EntityObject> {
     return global_guid_;
   }
 
+  // Stable small index used to key this entity in the ComponentPool<T>
+  // sparse sets. Recycled once the entity is destroyed.
+  [[nodiscard]] uint32_t nGetPoolIndex() const { return m_nPoolIndex; }
+
   EntityObject(const EntityObject&) = delete;
   EntityObject& operator=(const EntityObject&) = delete;
 
@@ -74,12 +80,7 @@ class EntityObject : public std::enable_shared_from_this<EntityObject> {
   // creating objects that are GUID created in non-native code.
   EntityObject(std::string name, std::string global_guid);
 
-  virtual ~EntityObject() {
-    vUnregisterEntity();
-
-    // smart ptrs in components deleted on clear.
-    components_.clear();
-  }
+  virtual ~EntityObject();
 
   virtual void DebugPrint() const = 0;
 
@@ -88,13 +89,7 @@ class EntityObject : public std::enable_shared_from_this<EntityObject> {
   void vAddComponent(std::shared_ptr<Component> component,
                      bool bAutoAddToSystems = true);
 
-  void vRemoveComponent(size_t staticTypeID) {
-    components_.erase(std::remove_if(components_.begin(), components_.end(),
-                                     [&](auto& item) {
-                                       return item->GetTypeID() == staticTypeID;
-                                     }),
-                      components_.end());
-  }
+  void vRemoveComponent(size_t staticTypeID);
 
   // Pass in the <DerivedClass>::StaticGetTypeID()
   // Returns component if valid, nullptr if not found.
@@ -118,6 +113,30 @@ class EntityObject : public std::enable_shared_from_this<EntityObject> {
     return nullptr;
   }
 
+  // Typed lookup; the type id match guarantees the dynamic type, so no
+  // dynamic_cast is needed. Returns nullptr if not found.
+  template <typename T>
+  [[nodiscard]] T* poGetComponent() const {
+    const size_t staticTypeID = T::StaticGetTypeID();
+    for (const auto& item : components_) {
+      if (item->GetTypeID() == staticTypeID) {
+        return static_cast<T*>(item.get());
+      }
+    }
+    return nullptr;
+  }
+
+  template <typename T>
+  [[nodiscard]] std::shared_ptr<T> GetComponent() const {
+    const size_t staticTypeID = T::StaticGetTypeID();
+    for (const auto& item : components_) {
+      if (item->GetTypeID() == staticTypeID) {
+        return std::static_pointer_cast<T>(item);
+      }
+    }
+    return nullptr;
+  }
+
   void vDebugPrintComponents() const;
 
   // finds the size_t staticTypeID in the component list
@@ -133,6 +152,8 @@ class EntityObject : public std::enable_shared_from_this<EntityObject> {
 
   bool m_bAlreadyRegistered{};
 
+  uint32_t m_nPoolIndex;
+
   // Look, if you're calling this, its expected your name clashing checking
   // yourself. This isn't done for you. Please dont have 100 'my_sphere'.
   // You're gonna have a bad time.
@@ -142,10 +163,13 @@ class EntityObject : public std::enable_shared_from_this<EntityObject> {
   void vOverrideName(const std::string& name);
   void vOverrideGlobalGuid(const std::string& global_guid);
 
+  // Drops the component from its ComponentPool<T>, if a system pooled it
+  // when the entity was registered (animations).
+  void vRemoveFromComponentPool(size_t staticTypeID) const;
+
   // Vector for now, we shouldn't be adding and removing
-  // components frequently during runtime.
-  //
-  // In the future this is probably a map<type, vector_or_list<Comp*>>
+  // components frequently during runtime. Per-type iteration goes through
+  // the ComponentPool<T> dense arrays instead.
   std::vector<std::shared_ptr<Component>> components_;
 };
 }  // namespace plugin_filament_view
\ No newline at end of file
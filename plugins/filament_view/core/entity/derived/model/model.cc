@@ -46,6 +46,10 @@ Model::Model(std::string assetPath,
       kRenderable_IsPrimaryAssetToInstanceFrom,
       &m_bIsPrimaryAssetToInstanceFrom, params, false);
 
+  Deserialize::DecodeParameterWithDefault(kRenderable_ExpectedInstanceCount,
+                                          &m_nExpectedInstanceCount, params,
+                                          0);
+
   DeserializeNameAndGlobalGuid(params);
 }
 
@@ -165,7 +169,7 @@ void Model::DebugPrint() const {
 void Model::vLoadMaterialDefinitionsToMaterialInstance() {
   const auto materialSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<MaterialSystem>(
-          MaterialSystem::StaticGetTypeID(), "BaseShape::vBuildRenderable");
+          "BaseShape::vBuildRenderable");
 
   if (materialSystem == nullptr) {
     spdlog::error("Failed to get material system.");
@@ -218,7 +222,6 @@ void Model::vChangeMaterialDefinitions(const flutter::EncodableMap& params,
   // now, reload / rebuild the material?
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(),
           "BaseShape::vChangeMaterialDefinitions");
 
   // If your entity has multiple primitives, you’ll need to call
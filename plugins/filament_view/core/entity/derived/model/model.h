@@ -79,6 +79,13 @@ class Model : public RenderableEntityObject {
   [[nodiscard]] bool bIsPrimaryAssetToInstanceFrom() const {
     return m_bIsPrimaryAssetToInstanceFrom;
   }
+
+  // How many models are expected to share this asset, including this one.
+  // Lets the first load create every instance at once; 0 if unknown.
+  [[nodiscard]] int32_t nGetExpectedInstanceCount() const {
+    return m_nExpectedInstanceCount;
+  }
+
   [[nodiscard]] filament::Aabb poGetBoundingBox() {
     if (m_poAsset != nullptr) {
       return m_poAsset->getBoundingBox();
@@ -103,6 +110,7 @@ class Model : public RenderableEntityObject {
   // used for instancing objects.
   bool m_bShouldKeepAssetDataInMemory = false;
   bool m_bIsPrimaryAssetToInstanceFrom = false;
+  int32_t m_nExpectedInstanceCount = 0;
 
   void DebugPrint() const override;
 
@@ -111,7 +111,7 @@ BaseShape::~BaseShape() {
 void BaseShape::vDestroyBuffers() {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "BaseShape::vDestroyBuffers");
+          "BaseShape::vDestroyBuffers");
   const auto filamentEngine = filamentSystem->getFilamentEngine();
 
   if (m_poMaterialInstance.getStatus() == Status::Success &&
@@ -165,7 +165,7 @@ void BaseShape::CloneToOther(BaseShape& other) const {
 void BaseShape::vLoadMaterialDefinitionsToMaterialInstance() {
   const auto materialSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<MaterialSystem>(
-          MaterialSystem::StaticGetTypeID(), "BaseShape::vBuildRenderable");
+          "BaseShape::vBuildRenderable");
 
   if (materialSystem == nullptr) {
     spdlog::error("Failed to get material system.");
@@ -237,7 +237,6 @@ void BaseShape::vRemoveEntityFromScene() const {
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(),
           "BaseShape::vRemoveEntityFromScene");
 
   filamentSystem->getFilamentScene()->removeEntities(m_poEntity.get(), 1);
@@ -253,7 +252,6 @@ void BaseShape::vAddEntityToScene() const {
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(),
           "BaseShape::vRemoveEntityFromScene");
   filamentSystem->getFilamentScene()->addEntity(*m_poEntity);
 }
@@ -312,7 +310,6 @@ void BaseShape::vChangeMaterialDefinitions(
   // now, reload / rebuild the material?
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(),
           "BaseShape::vChangeMaterialDefinitions");
 
   // If your entity has multiple primitives, you’ll need to call
@@ -14,11 +14,9 @@
  * limitations under the License.
  */
 
+#include <core/utils/asset_buffer.h>
 #include <plugins/common/common.h>
 #include <filesystem>
-#include <fstream>
-#include <optional>
-#include <vector>
 
 namespace plugin_filament_view {
 
@@ -37,66 +35,22 @@ inline bool isValidFilePath(const std::filesystem::path& path) {
   return true;
 }
 
-inline std::vector<uint8_t> createBuffer(std::ifstream& file,
-                                         const std::size_t size) {
-  std::vector<uint8_t> buffer(size);
-  if (!file.read(reinterpret_cast<char*>(buffer.data()),
-                 static_cast<long>(buffer.size()))) {
-    buffer.clear();
-  }
-  return buffer;
-}
-
-inline std::optional<std::ifstream> readFileContent(
-    const std::filesystem::path& path) {
-  std::ifstream file(path, std::ios::binary | std::ios::ate);
-  if (!file.is_open()) {
-    spdlog::error("[{}] Failed to open", path.c_str());
-    return {};
-  }
-  return file;
-}
-
-inline std::vector<uint8_t> returnErrorMessageAndBuffer(
-    const std::filesystem::path& path,
-    const std::string& message) {
-  spdlog::error("[{}] {}", path.c_str(), message);
-  return {};
-}
-
-inline std::vector<uint8_t> readBinaryFile(const std::string& dependent_path,
-                                           const std::string& main_path) {
+// Maps the asset rather than copying it to the heap; see AssetBuffer.
+inline AssetBuffer mapBinaryFile(
+    const std::string& dependent_path,
+    const std::string& main_path,
+    const AssetBuffer::eAccessPattern ePattern =
+        AssetBuffer::eAccessPattern::Sequential) {
   const std::filesystem::path filePath =
       getAbsolutePath(dependent_path, main_path);
 
   if (!isValidFilePath(filePath)) {
-    return returnErrorMessageAndBuffer(filePath, "Invalid path");
-  }
-
-  std::optional<std::ifstream> optionalFile = readFileContent(filePath);
-  if (!optionalFile.has_value()) {
-    return returnErrorMessageAndBuffer(filePath, "Failed to open");
+    spdlog::error("[{}] Invalid path", filePath.c_str());
+    return {};
   }
 
   SPDLOG_INFO("Reading: {}/{}", main_path, dependent_path);
-
-  std::ifstream& file = optionalFile.value();
-  const auto end = file.tellg();
-  file.seekg(0, std::ios::beg);
-  const auto size = static_cast<std::size_t>(end - file.tellg());
-
-  if (size == 0) {
-    SPDLOG_ERROR("Size was 0 reading {}", filePath.c_str());
-    return returnErrorMessageAndBuffer(filePath, "Empty file");
-  }
-
-  std::vector<uint8_t> buffer = createBuffer(file, size);
-  if (buffer.empty()) {
-    SPDLOG_ERROR("buffer was empty reading {}", filePath.c_str());
-    return returnErrorMessageAndBuffer(filePath, "Failed to read");
-  }
-
-  return buffer;
+  return AssetBuffer::Map(filePath, ePattern);
 }
 
 }  // namespace plugin_filament_view
@@ -209,9 +209,16 @@ enum CollisionEventType {
   eFromNonNative,
   eNativeOnTouchBegin,
   eNativeOnTouchHeld,
-  eNativeOnTouchEnd
+  eNativeOnTouchEnd,
+  eNativeOnHover
 };
 
+// Batched picks, one event per frame covering every pointer picked that frame
+static constexpr char kCollisionPickEvent[] = "collision_pick_event";
+static constexpr char kCollisionPickCount[] = "collision_pick_count";
+static constexpr char kCollisionPickResult[] = "collision_pick_result_";
+static constexpr char kCollisionPickPointerId[] = "collision_pick_pointer_id";
+
 static constexpr char kAnimationEvent[] = "animation_event";
 static constexpr char kAnimationEventType[] = "animation_event_type";
 enum AnimationEventType {
@@ -238,5 +245,7 @@ static constexpr char kRenderable_KeepAssetInMemory[] =
     "should_keep_asset_in_memory";
 static constexpr char kRenderable_IsPrimaryAssetToInstanceFrom[] =
     "is_primary_to_instance_from";
+static constexpr char kRenderable_ExpectedInstanceCount[] =
+    "expected_instance_count";
 
 }  // namespace plugin_filament_view
@@ -47,7 +47,7 @@ void CameraManager::setDefaultFilamentCamera() {
 
   auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "CameraManager::setDefaultCamera");
+          "CameraManager::setDefaultCamera");
   const auto engine = filamentSystem->getFilamentEngine();
 
   auto fview = m_poOwner->getFilamentView();
@@ -261,7 +261,7 @@ void CameraManager::updateCameraManipulator(const Camera* cameraInfo) {
 
   auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "CameraManager::setDefaultCamera");
+          "CameraManager::setDefaultCamera");
 
   const auto viewport = m_poOwner->getFilamentView()->getViewport();
   manipulatorBuilder.viewport(static_cast<int>(viewport.width),
@@ -452,7 +452,7 @@ void CameraManager::destroyCamera() const {
   SPDLOG_DEBUG("++CameraManager::destroyCamera");
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "destroyCamera");
+          "destroyCamera");
   const auto engine = filamentSystem->getFilamentEngine();
 
   engine->destroyCameraComponent(cameraEntity_);
@@ -505,21 +505,34 @@ Ray CameraManager::oGetRayInformationFromOnTouchPosition(
 ////////////////////////////////////////////////////////////////////////////
 std::pair<filament::math::float3, filament::math::float3>
 CameraManager::aGetRayInformationFromOnTouchPosition(TouchPair touch) const {
+  return aGetRayInformationFromScreenPosition(static_cast<float>(touch.x()),
+                                              static_cast<float>(touch.y()));
+}
+
+////////////////////////////////////////////////////////////////////////////
+Ray CameraManager::oGetRayInformationFromScreenPosition(const float x,
+                                                        const float y) const {
+  auto [fst, snd] = aGetRayInformationFromScreenPosition(x, y);
+  constexpr float defaultLength = 1000.0f;
+  Ray returnRay(fst, snd, defaultLength);
+  return returnRay;
+}
+
+////////////////////////////////////////////////////////////////////////////
+std::pair<filament::math::float3, filament::math::float3>
+CameraManager::aGetRayInformationFromScreenPosition(const float x,
+                                                    const float y) const {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(),
-          "CameraManager::aGetRayInformationFromOnTouchPosition");
+          "CameraManager::aGetRayInformationFromScreenPosition");
 
   const auto viewport = m_poOwner->getFilamentView()->getViewport();
 
   // Note at time of writing on a 800*600 resolution this seems like the 10%
   // edges aren't super accurate this might need to be looked at more.
 
-  float ndcX = (2.0f * static_cast<float>(touch.x())) /  // NOLINT
-                   static_cast<float>(viewport.width) -  // NOLINT
-               1.0f;
-  float ndcY = 1.0f - (2.0f * static_cast<float>(touch.y())) /  // NOLINT
-                          static_cast<float>(viewport.height);  // NOLINT
+  float ndcX = (2.0f * x) / static_cast<float>(viewport.width) - 1.0f;
+  float ndcY = 1.0f - (2.0f * y) / static_cast<float>(viewport.height);
   ndcY = -ndcY;
 
   filament::math::vec4<float> rayClip(ndcX, ndcY, -1.0f, 1.0f);
@@ -564,7 +577,7 @@ void CameraManager::onAction(int32_t action,
 
   auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "CameraManager::setDefaultCamera");
+          "CameraManager::setDefaultCamera");
 
   const auto viewport = m_poOwner->getFilamentView()->getViewport();
   auto touch =
@@ -713,7 +726,6 @@ void CameraManager::updateCameraProjection() {
 float CameraManager::calculateAspectRatio() const {
   auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(),
           "CameraManager::aGetRayInformationFromOnTouchPosition");
 
   const auto viewport = m_poOwner->getFilamentView()->getViewport();
@@ -99,6 +99,13 @@ class CameraManager {
   [[nodiscard]] Ray oGetRayInformationFromOnTouchPosition(
       TouchPair touch) const;
 
+  // Same as above for a single point, in the flipped-y space TouchPair uses.
+  [[nodiscard]] std::pair<filament::math::float3, filament::math::float3>
+  aGetRayInformationFromScreenPosition(float x, float y) const;
+
+  [[nodiscard]] Ray oGetRayInformationFromScreenPosition(float x,
+                                                         float y) const;
+
   void vResetInertiaCameraToDefaultValues();
 
  private:
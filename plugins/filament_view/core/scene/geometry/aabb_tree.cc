@@ -0,0 +1,273 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "aabb_tree.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace plugin_filament_view {
+
+////////////////////////////////////////////////////////////////////////////
+Aabb Aabb::Union(const Aabb& a, const Aabb& b) {
+  return {{std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y),
+           std::min(a.min.z, b.min.z)},
+          {std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y),
+           std::max(a.max.z, b.max.z)}};
+}
+
+////////////////////////////////////////////////////////////////////////////
+float Aabb::fRayEntry(const ::filament::math::float3& origin,
+                      const ::filament::math::float3& invDir) const {
+  // Axis parallel rays give +-inf here, which the min / max below handle.
+  const float tx1 = (min.x - origin.x) * invDir.x;
+  const float tx2 = (max.x - origin.x) * invDir.x;
+  const float ty1 = (min.y - origin.y) * invDir.y;
+  const float ty2 = (max.y - origin.y) * invDir.y;
+  const float tz1 = (min.z - origin.z) * invDir.z;
+  const float tz2 = (max.z - origin.z) * invDir.z;
+
+  const float tNear = std::max({std::min(tx1, tx2), std::min(ty1, ty2),
+                                std::min(tz1, tz2)});
+  const float tFar = std::min({std::max(tx1, tx2), std::max(ty1, ty2),
+                               std::max(tz1, tz2)});
+
+  if (tFar < 0 || tNear > tFar) {
+    return -1.0f;
+  }
+  return std::max(tNear, 0.0f);
+}
+
+////////////////////////////////////////////////////////////////////////////
+int32_t AabbTree::nAllocateNode() {
+  if (freeList_ == kNullNode) {
+    nodes_.emplace_back();
+    freeList_ = static_cast<int32_t>(nodes_.size() - 1);
+  }
+
+  const int32_t node = freeList_;
+  freeList_ = nodes_[node].parentOrNext;
+  nodes_[node] = Node{};
+  nodes_[node].height = 0;
+  return node;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AabbTree::vFreeNode(const int32_t node) {
+  nodes_[node].parentOrNext = freeList_;
+  nodes_[node].height = -1;
+  nodes_[node].poEntity = nullptr;
+  freeList_ = node;
+}
+
+////////////////////////////////////////////////////////////////////////////
+int32_t AabbTree::nInsert(const Aabb& box, EntityObject* poEntity) {
+  const int32_t leaf = nAllocateNode();
+  const ::filament::math::float3 margin = {kFatMargin, kFatMargin, kFatMargin};
+  nodes_[leaf].box = {box.min - margin, box.max + margin};
+  nodes_[leaf].poEntity = poEntity;
+
+  vInsertLeaf(leaf);
+  return leaf;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AabbTree::vRemove(const int32_t leaf) {
+  assert(leaf >= 0 && leaf < static_cast<int32_t>(nodes_.size()));
+  assert(nodes_[leaf].bIsLeaf());
+
+  vRemoveLeaf(leaf);
+  vFreeNode(leaf);
+}
+
+////////////////////////////////////////////////////////////////////////////
+bool AabbTree::bMove(const int32_t leaf, const Aabb& box) {
+  assert(nodes_[leaf].bIsLeaf());
+
+  if (nodes_[leaf].box.bContains(box)) {
+    return false;
+  }
+
+  vRemoveLeaf(leaf);
+  const ::filament::math::float3 margin = {kFatMargin, kFatMargin, kFatMargin};
+  nodes_[leaf].box = {box.min - margin, box.max + margin};
+  vInsertLeaf(leaf);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AabbTree::vClear() {
+  nodes_.clear();
+  root_ = kNullNode;
+  freeList_ = kNullNode;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AabbTree::vInsertLeaf(const int32_t leaf) {
+  if (root_ == kNullNode) {
+    root_ = leaf;
+    nodes_[root_].parentOrNext = kNullNode;
+    return;
+  }
+
+  // Descend towards the sibling with the lowest surface area cost.
+  const Aabb leafBox = nodes_[leaf].box;
+  int32_t index = root_;
+  while (!nodes_[index].bIsLeaf()) {
+    const Node& node = nodes_[index];
+    const float area = node.box.fSurfaceArea();
+    const float combinedArea = Aabb::Union(node.box, leafBox).fSurfaceArea();
+
+    // Cost of making a new parent for this node and the leaf.
+    const float cost = 2.0f * combinedArea;
+    // Minimum cost of pushing the leaf further down the tree.
+    const float inheritanceCost = 2.0f * (combinedArea - area);
+
+    auto childCost = [&](const int32_t child) {
+      const Aabb box = Aabb::Union(leafBox, nodes_[child].box);
+      if (nodes_[child].bIsLeaf()) {
+        return box.fSurfaceArea() + inheritanceCost;
+      }
+      return box.fSurfaceArea() - nodes_[child].box.fSurfaceArea() +
+             inheritanceCost;
+    };
+
+    const float cost1 = childCost(node.child1);
+    const float cost2 = childCost(node.child2);
+    if (cost < cost1 && cost < cost2) {
+      break;
+    }
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+
+  const int32_t sibling = index;
+  const int32_t oldParent = nodes_[sibling].parentOrNext;
+  const int32_t newParent = nAllocateNode();
+  nodes_[newParent].parentOrNext = oldParent;
+  nodes_[newParent].box = Aabb::Union(leafBox, nodes_[sibling].box);
+  nodes_[newParent].height = nodes_[sibling].height + 1;
+  nodes_[newParent].child1 = sibling;
+  nodes_[newParent].child2 = leaf;
+  nodes_[sibling].parentOrNext = newParent;
+  nodes_[leaf].parentOrNext = newParent;
+
+  if (oldParent == kNullNode) {
+    root_ = newParent;
+  } else if (nodes_[oldParent].child1 == sibling) {
+    nodes_[oldParent].child1 = newParent;
+  } else {
+    nodes_[oldParent].child2 = newParent;
+  }
+
+  vRefitAncestors(nodes_[leaf].parentOrNext);
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AabbTree::vRemoveLeaf(const int32_t leaf) {
+  if (leaf == root_) {
+    root_ = kNullNode;
+    return;
+  }
+
+  const int32_t parent = nodes_[leaf].parentOrNext;
+  const int32_t grandParent = nodes_[parent].parentOrNext;
+  const int32_t sibling = nodes_[parent].child1 == leaf
+                              ? nodes_[parent].child2
+                              : nodes_[parent].child1;
+
+  if (grandParent == kNullNode) {
+    root_ = sibling;
+    nodes_[sibling].parentOrNext = kNullNode;
+    vFreeNode(parent);
+    return;
+  }
+
+  // Splice the sibling into the grandparent in place of the parent.
+  if (nodes_[grandParent].child1 == parent) {
+    nodes_[grandParent].child1 = sibling;
+  } else {
+    nodes_[grandParent].child2 = sibling;
+  }
+  nodes_[sibling].parentOrNext = grandParent;
+  vFreeNode(parent);
+
+  vRefitAncestors(grandParent);
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AabbTree::vRefitAncestors(int32_t node) {
+  while (node != kNullNode) {
+    node = nBalance(node);
+
+    Node& n = nodes_[node];
+    n.height = 1 + std::max(nodes_[n.child1].height, nodes_[n.child2].height);
+    n.box = Aabb::Union(nodes_[n.child1].box, nodes_[n.child2].box);
+
+    node = n.parentOrNext;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+int32_t AabbTree::nBalance(const int32_t a) {
+  if (nodes_[a].bIsLeaf() || nodes_[a].height < 2) {
+    return a;
+  }
+
+  const int32_t b = nodes_[a].child1;
+  const int32_t c = nodes_[a].child2;
+  const int32_t balance = nodes_[c].height - nodes_[b].height;
+  if (balance >= -1 && balance <= 1) {
+    return a;
+  }
+
+  // Promote the taller child (up) and hang a under it; the taller of up's
+  // children stays with up, the shorter moves to a.
+  const int32_t up = balance > 1 ? c : b;
+  const int32_t stay = balance > 1 ? b : c;
+  const int32_t f = nodes_[up].child1;
+  const int32_t g = nodes_[up].child2;
+
+  nodes_[up].child1 = a;
+  nodes_[up].parentOrNext = nodes_[a].parentOrNext;
+  nodes_[a].parentOrNext = up;
+
+  if (const int32_t upParent = nodes_[up].parentOrNext;
+      upParent == kNullNode) {
+    root_ = up;
+  } else if (nodes_[upParent].child1 == a) {
+    nodes_[upParent].child1 = up;
+  } else {
+    nodes_[upParent].child2 = up;
+  }
+
+  const bool bKeepF = nodes_[f].height > nodes_[g].height;
+  const int32_t keep = bKeepF ? f : g;
+  const int32_t give = bKeepF ? g : f;
+
+  nodes_[up].child2 = keep;
+  nodes_[a].child1 = stay;
+  nodes_[a].child2 = give;
+  nodes_[give].parentOrNext = a;
+
+  nodes_[a].box = Aabb::Union(nodes_[stay].box, nodes_[give].box);
+  nodes_[a].height =
+      1 + std::max(nodes_[stay].height, nodes_[give].height);
+  nodes_[up].box = Aabb::Union(nodes_[a].box, nodes_[keep].box);
+  nodes_[up].height = 1 + std::max(nodes_[a].height, nodes_[keep].height);
+
+  return up;
+}
+
+}  // namespace plugin_filament_view
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <queue>
+#include <vector>
+
+#include <math/vec3.h>
+
+namespace plugin_filament_view {
+class EntityObject;
+
+struct Aabb {
+  ::filament::math::float3 min;
+  ::filament::math::float3 max;
+
+  [[nodiscard]] bool bContains(const Aabb& other) const {
+    return min.x <= other.min.x && min.y <= other.min.y &&
+           min.z <= other.min.z && other.max.x <= max.x &&
+           other.max.y <= max.y && other.max.z <= max.z;
+  }
+
+  [[nodiscard]] float fSurfaceArea() const {
+    const auto d = max - min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+  }
+
+  [[nodiscard]] static Aabb Union(const Aabb& a, const Aabb& b);
+
+  // Slab test. Returns the parametric distance along the ray at which it
+  // enters the box (0 if the origin is inside), or a negative value on a
+  // miss.
+  [[nodiscard]] float fRayEntry(const ::filament::math::float3& origin,
+                                const ::filament::math::float3& invDir) const;
+};
+
+// Dynamic bounding volume hierarchy over entity AABBs. Leaves store a
+// fattened box, so small moves only need a containment check rather than a
+// reinsert; inserts pick the sibling by surface area cost and the tree is
+// kept balanced with rotations, so depth stays O(log n).
+//
+// Not thread safe; owned and used by the CollisionSystem on the Filament API
+// thread.
+class AabbTree {
+ public:
+  static constexpr int32_t kNullNode = -1;
+
+  // Leaf boxes are grown by this much on every side.
+  static constexpr float kFatMargin = 0.1f;
+
+  AabbTree() = default;
+
+  // Returns the leaf id, stable until vRemove.
+  int32_t nInsert(const Aabb& box, EntityObject* poEntity);
+  void vRemove(int32_t leaf);
+
+  // Updates a leaf after its entity moved. Returns true if the leaf had to be
+  // reinserted, false if the fat box still contains the new one.
+  bool bMove(int32_t leaf, const Aabb& box);
+
+  void vClear();
+
+  [[nodiscard]] int32_t nGetHeight() const {
+    return root_ == kNullNode ? 0 : nodes_[root_].height;
+  }
+
+  // Walks the leaves the ray can reach in increasing distance order.
+  // leafTest(EntityObject*, float& t) returns true on an exact hit and sets
+  // its distance along the ray; onHit(EntityObject*, float t) is then called
+  // for every hit in ascending t, so no post sort is needed. Returning false
+  // from onHit stops the walk.
+  template <typename LeafTest, typename OnHit>
+  void vRaycast(const ::filament::math::float3& origin,
+                const ::filament::math::float3& direction,
+                LeafTest&& leafTest,
+                OnHit&& onHit) const;
+
+ private:
+  struct Node {
+    Aabb box;
+    EntityObject* poEntity = nullptr;
+    // Parent while allocated, next free node otherwise.
+    int32_t parentOrNext = kNullNode;
+    int32_t child1 = kNullNode;
+    int32_t child2 = kNullNode;
+    // Leaf = 0, free = -1.
+    int32_t height = -1;
+
+    [[nodiscard]] bool bIsLeaf() const { return child1 == kNullNode; }
+  };
+
+  int32_t root_ = kNullNode;
+  int32_t freeList_ = kNullNode;
+  std::vector<Node> nodes_;
+
+  int32_t nAllocateNode();
+  void vFreeNode(int32_t node);
+
+  void vInsertLeaf(int32_t leaf);
+  void vRemoveLeaf(int32_t leaf);
+
+  // Rotates around node a if its children heights differ by more than one.
+  // Returns the new root of the subtree.
+  int32_t nBalance(int32_t a);
+
+  // Walk from node up to the root refitting boxes and heights.
+  void vRefitAncestors(int32_t node);
+};
+
+////////////////////////////////////////////////////////////////////////////
+template <typename LeafTest, typename OnHit>
+void AabbTree::vRaycast(const ::filament::math::float3& origin,
+                        const ::filament::math::float3& direction,
+                        LeafTest&& leafTest,
+                        OnHit&& onHit) const {
+  if (root_ == kNullNode) {
+    return;
+  }
+
+  const ::filament::math::float3 invDir = {
+      1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z};
+
+  // Nodes are queued by entry distance and confirmed hits by hit distance.
+  // A hit popped from the queue is closer than anything still queued, since
+  // nothing in an unopened box can be hit before the box is entered.
+  struct Item {
+    float t;
+    int32_t node;
+    bool bIsHit;
+    bool operator>(const Item& other) const { return t > other.t; }
+  };
+  std::priority_queue<Item, std::vector<Item>, std::greater<>> queue;
+
+  if (const float t = nodes_[root_].box.fRayEntry(origin, invDir); t >= 0) {
+    queue.push({t, root_, false});
+  }
+
+  while (!queue.empty()) {
+    const Item item = queue.top();
+    queue.pop();
+    const Node& node = nodes_[item.node];
+
+    if (item.bIsHit) {
+      if (!onHit(node.poEntity, item.t)) {
+        return;
+      }
+      continue;
+    }
+
+    if (node.bIsLeaf()) {
+      if (float t; leafTest(node.poEntity, t)) {
+        queue.push({t, item.node, true});
+      }
+      continue;
+    }
+
+    for (const int32_t child : {node.child1, node.child2}) {
+      if (const float t = nodes_[child].box.fRayEntry(origin, invDir);
+          t >= 0) {
+        queue.push({t, child, false});
+      }
+    }
+  }
+}
+
+}  // namespace plugin_filament_view
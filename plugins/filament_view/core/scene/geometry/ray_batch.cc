@@ -0,0 +1,460 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ray_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RAY_BATCH_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RAY_BATCH_NEON 1
+#endif
+
+namespace plugin_filament_view {
+
+namespace {
+
+// Padding lanes hold NaN, which fails every comparison below, so they never
+// report a hit.
+constexpr float kPad = std::numeric_limits<float>::quiet_NaN();
+
+// Grows the SoA arrays a whole block at a time so the kernels can always load
+// full vectors.
+template <typename... Arrays>
+void vReserveSlot(const size_t index, Arrays&... arrays) {
+  if (((index >= arrays.size()) || ...)) {
+    (arrays.resize(index + RayBatch::kLanes, kPad), ...);
+  }
+}
+
+// Moves the last slot into slot and pads the vacated lane, keeping the
+// arrays their padded size. Returns the id that moved, if any.
+template <typename... Arrays>
+uint32_t nSwapRemove(const uint32_t slot,
+                     std::vector<uint32_t>& ids,
+                     Arrays&... arrays) {
+  const auto last = static_cast<uint32_t>(ids.size() - 1);
+  uint32_t moved = kNoRayBatchId;
+  if (slot != last) {
+    ((arrays[slot] = arrays[last]), ...);
+    ids[slot] = ids[last];
+    moved = ids[slot];
+  }
+  ((arrays[last] = kPad), ...);
+  ids.pop_back();
+  return moved;
+}
+
+// Minimal 4 lane float vector over the available instruction set.
+#if RAY_BATCH_SSE2
+using F4 = __m128;
+inline F4 Load(const float* p) {
+  return _mm_loadu_ps(p);
+}
+inline F4 Set(const float v) {
+  return _mm_set1_ps(v);
+}
+inline F4 Add(const F4 a, const F4 b) {
+  return _mm_add_ps(a, b);
+}
+inline F4 Sub(const F4 a, const F4 b) {
+  return _mm_sub_ps(a, b);
+}
+inline F4 Mul(const F4 a, const F4 b) {
+  return _mm_mul_ps(a, b);
+}
+inline F4 Min(const F4 a, const F4 b) {
+  return _mm_min_ps(a, b);
+}
+inline F4 Max(const F4 a, const F4 b) {
+  return _mm_max_ps(a, b);
+}
+inline F4 Sqrt(const F4 a) {
+  return _mm_sqrt_ps(a);
+}
+inline F4 Abs(const F4 a) {
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+}
+inline F4 Gt(const F4 a, const F4 b) {
+  return _mm_cmpgt_ps(a, b);
+}
+inline F4 Ge(const F4 a, const F4 b) {
+  return _mm_cmpge_ps(a, b);
+}
+inline F4 Le(const F4 a, const F4 b) {
+  return _mm_cmple_ps(a, b);
+}
+inline F4 And(const F4 a, const F4 b) {
+  return _mm_and_ps(a, b);
+}
+inline unsigned Mask(const F4 m) {
+  return static_cast<unsigned>(_mm_movemask_ps(m));
+}
+inline void Store(float* p, const F4 a) {
+  _mm_storeu_ps(p, a);
+}
+#elif RAY_BATCH_NEON
+using F4 = float32x4_t;
+inline F4 Load(const float* p) {
+  return vld1q_f32(p);
+}
+inline F4 Set(const float v) {
+  return vdupq_n_f32(v);
+}
+inline F4 Add(const F4 a, const F4 b) {
+  return vaddq_f32(a, b);
+}
+inline F4 Sub(const F4 a, const F4 b) {
+  return vsubq_f32(a, b);
+}
+inline F4 Mul(const F4 a, const F4 b) {
+  return vmulq_f32(a, b);
+}
+inline F4 Min(const F4 a, const F4 b) {
+  return vminq_f32(a, b);
+}
+inline F4 Max(const F4 a, const F4 b) {
+  return vmaxq_f32(a, b);
+}
+inline F4 Sqrt(const F4 a) {
+  return vsqrtq_f32(a);
+}
+inline F4 Abs(const F4 a) {
+  return vabsq_f32(a);
+}
+inline F4 Gt(const F4 a, const F4 b) {
+  return vreinterpretq_f32_u32(vcgtq_f32(a, b));
+}
+inline F4 Ge(const F4 a, const F4 b) {
+  return vreinterpretq_f32_u32(vcgeq_f32(a, b));
+}
+inline F4 Le(const F4 a, const F4 b) {
+  return vreinterpretq_f32_u32(vcleq_f32(a, b));
+}
+inline F4 And(const F4 a, const F4 b) {
+  return vreinterpretq_f32_u32(
+      vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+inline unsigned Mask(const F4 m) {
+  const uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(m), 31);
+  return vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) |
+         (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3);
+}
+inline void Store(float* p, const F4 a) {
+  vst1q_f32(p, a);
+}
+#else
+struct F4 {
+  float v[4];
+};
+template <typename Op>
+inline F4 Map(const F4 a, const F4 b, Op op) {
+  return {{op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]),
+           op(a.v[3], b.v[3])}};
+}
+inline F4 Load(const float* p) {
+  return {{p[0], p[1], p[2], p[3]}};
+}
+inline F4 Set(const float v) {
+  return {{v, v, v, v}};
+}
+inline F4 Add(const F4 a, const F4 b) {
+  return Map(a, b, [](float x, float y) { return x + y; });
+}
+inline F4 Sub(const F4 a, const F4 b) {
+  return Map(a, b, [](float x, float y) { return x - y; });
+}
+inline F4 Mul(const F4 a, const F4 b) {
+  return Map(a, b, [](float x, float y) { return x * y; });
+}
+inline F4 Min(const F4 a, const F4 b) {
+  return Map(a, b, [](float x, float y) { return x < y ? x : y; });
+}
+inline F4 Max(const F4 a, const F4 b) {
+  return Map(a, b, [](float x, float y) { return x > y ? x : y; });
+}
+inline F4 Sqrt(const F4 a) {
+  return {{std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]),
+           std::sqrt(a.v[3])}};
+}
+inline F4 Abs(const F4 a) {
+  return {{std::fabs(a.v[0]), std::fabs(a.v[1]), std::fabs(a.v[2]),
+           std::fabs(a.v[3])}};
+}
+inline F4 Gt(const F4 a, const F4 b) {
+  return Map(a, b, [](float x, float y) { return x > y ? 1.0f : 0.0f; });
+}
+inline F4 Ge(const F4 a, const F4 b) {
+  return Map(a, b, [](float x, float y) { return x >= y ? 1.0f : 0.0f; });
+}
+inline F4 Le(const F4 a, const F4 b) {
+  return Map(a, b, [](float x, float y) { return x <= y ? 1.0f : 0.0f; });
+}
+inline F4 And(const F4 a, const F4 b) {
+  return Map(a, b, [](float x, float y) { return x * y; });
+}
+inline unsigned Mask(const F4 m) {
+  return (m.v[0] != 0.0f ? 1u : 0u) | (m.v[1] != 0.0f ? 2u : 0u) |
+         (m.v[2] != 0.0f ? 4u : 0u) | (m.v[3] != 0.0f ? 8u : 0u);
+}
+inline void Store(float* p, const F4 a) {
+  std::copy(a.v, a.v + 4, p);
+}
+#endif
+
+// Emits the lanes set in mask, skipping padding past count.
+inline void vEmitHits(const unsigned mask,
+                      const F4 t,
+                      const size_t base,
+                      const std::vector<uint32_t>& ids,
+                      std::vector<RayBatchHit>& hits) {
+  if (mask == 0) {
+    return;
+  }
+  alignas(16) float lanes[RayBatch::kLanes];
+  Store(lanes, t);
+  for (size_t lane = 0; lane < RayBatch::kLanes; ++lane) {
+    if ((mask & (1u << lane)) != 0 && base + lane < ids.size()) {
+      hits.push_back({ids[base + lane], lanes[lane]});
+    }
+  }
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////
+uint32_t SphereBatch::nAdd(const uint32_t id,
+                           const ::filament::math::float3& center,
+                           const float radius) {
+  const auto slot = static_cast<uint32_t>(ids_.size());
+  vReserveSlot(slot, cx_, cy_, cz_, r2_);
+  ids_.push_back(id);
+  vSet(slot, center, radius);
+  return slot;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void SphereBatch::vSet(const uint32_t slot,
+                       const ::filament::math::float3& center,
+                       const float radius) {
+  cx_[slot] = center.x;
+  cy_[slot] = center.y;
+  cz_[slot] = center.z;
+  r2_[slot] = radius * radius;
+}
+
+////////////////////////////////////////////////////////////////////////////
+uint32_t SphereBatch::nRemove(const uint32_t slot) {
+  return nSwapRemove(slot, ids_, cx_, cy_, cz_, r2_);
+}
+
+////////////////////////////////////////////////////////////////////////////
+void SphereBatch::vClear() {
+  cx_.clear();
+  cy_.clear();
+  cz_.clear();
+  r2_.clear();
+  ids_.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////
+uint32_t AabbBatch::nAdd(const uint32_t id,
+                         const ::filament::math::float3& min,
+                         const ::filament::math::float3& max) {
+  const auto slot = static_cast<uint32_t>(ids_.size());
+  vReserveSlot(slot, minX_, minY_, minZ_, maxX_, maxY_, maxZ_);
+  ids_.push_back(id);
+  vSet(slot, min, max);
+  return slot;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AabbBatch::vSet(const uint32_t slot,
+                     const ::filament::math::float3& min,
+                     const ::filament::math::float3& max) {
+  minX_[slot] = min.x;
+  minY_[slot] = min.y;
+  minZ_[slot] = min.z;
+  maxX_[slot] = max.x;
+  maxY_[slot] = max.y;
+  maxZ_[slot] = max.z;
+}
+
+////////////////////////////////////////////////////////////////////////////
+uint32_t AabbBatch::nRemove(const uint32_t slot) {
+  return nSwapRemove(slot, ids_, minX_, minY_, minZ_, maxX_, maxY_, maxZ_);
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AabbBatch::vClear() {
+  minX_.clear();
+  minY_.clear();
+  minZ_.clear();
+  maxX_.clear();
+  maxY_.clear();
+  maxZ_.clear();
+  ids_.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////
+uint32_t PlaneBatch::nAdd(const uint32_t id,
+                          const ::filament::math::float3& center,
+                          const float halfWidth,
+                          const float halfDepth) {
+  const auto slot = static_cast<uint32_t>(ids_.size());
+  vReserveSlot(slot, cx_, cy_, cz_, hx_, hz_);
+  ids_.push_back(id);
+  vSet(slot, center, halfWidth, halfDepth);
+  return slot;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void PlaneBatch::vSet(const uint32_t slot,
+                      const ::filament::math::float3& center,
+                      const float halfWidth,
+                      const float halfDepth) {
+  cx_[slot] = center.x;
+  cy_[slot] = center.y;
+  cz_[slot] = center.z;
+  hx_[slot] = halfWidth;
+  hz_[slot] = halfDepth;
+}
+
+////////////////////////////////////////////////////////////////////////////
+uint32_t PlaneBatch::nRemove(const uint32_t slot) {
+  return nSwapRemove(slot, ids_, cx_, cy_, cz_, hx_, hz_);
+}
+
+////////////////////////////////////////////////////////////////////////////
+void PlaneBatch::vClear() {
+  cx_.clear();
+  cy_.clear();
+  cz_.clear();
+  hx_.clear();
+  hz_.clear();
+  ids_.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////
+void RayBatch::vIntersect(const ::filament::math::float3& origin,
+                          const ::filament::math::float3& direction,
+                          const SphereBatch& spheres,
+                          std::vector<RayBatchHit>& hits) {
+  // Half-b form of the quadratic: t = (-b - sqrt(b^2 - a*c)) / a.
+  const float a = direction.x * direction.x + direction.y * direction.y +
+                  direction.z * direction.z;
+  if (!(a > 0.0f)) {
+    return;
+  }
+
+  const F4 ox = Set(origin.x), oy = Set(origin.y), oz = Set(origin.z);
+  const F4 dx = Set(direction.x), dy = Set(direction.y),
+           dz = Set(direction.z);
+  const F4 va = Set(a), invA = Set(1.0f / a), zero = Set(0.0f);
+
+  for (size_t i = 0; i < spheres.ids_.size(); i += kLanes) {
+    const F4 ocx = Sub(ox, Load(&spheres.cx_[i]));
+    const F4 ocy = Sub(oy, Load(&spheres.cy_[i]));
+    const F4 ocz = Sub(oz, Load(&spheres.cz_[i]));
+
+    const F4 b = Add(Add(Mul(ocx, dx), Mul(ocy, dy)), Mul(ocz, dz));
+    const F4 c = Sub(Add(Add(Mul(ocx, ocx), Mul(ocy, ocy)), Mul(ocz, ocz)),
+                     Load(&spheres.r2_[i]));
+    const F4 disc = Sub(Mul(b, b), Mul(va, c));
+
+    const F4 hasRoot = Gt(disc, zero);
+    // Lanes without a root take sqrt of a negative; they are masked out.
+    const F4 t = Mul(Sub(Sub(zero, b), Sqrt(Max(disc, zero))), invA);
+
+    vEmitHits(Mask(And(hasRoot, Gt(t, zero))), t, i, spheres.ids_, hits);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+void RayBatch::vIntersect(const ::filament::math::float3& origin,
+                          const ::filament::math::float3& direction,
+                          const AabbBatch& boxes,
+                          std::vector<RayBatchHit>& hits) {
+  // Axis parallel rays give +-inf, which the slab min / max handle.
+  const F4 ox = Set(origin.x), oy = Set(origin.y), oz = Set(origin.z);
+  const F4 ix = Set(1.0f / direction.x), iy = Set(1.0f / direction.y),
+           iz = Set(1.0f / direction.z);
+  const F4 zero = Set(0.0f);
+
+  for (size_t i = 0; i < boxes.ids_.size(); i += kLanes) {
+    const F4 tx1 = Mul(Sub(Load(&boxes.minX_[i]), ox), ix);
+    const F4 tx2 = Mul(Sub(Load(&boxes.maxX_[i]), ox), ix);
+    const F4 ty1 = Mul(Sub(Load(&boxes.minY_[i]), oy), iy);
+    const F4 ty2 = Mul(Sub(Load(&boxes.maxY_[i]), oy), iy);
+    const F4 tz1 = Mul(Sub(Load(&boxes.minZ_[i]), oz), iz);
+    const F4 tz2 = Mul(Sub(Load(&boxes.maxZ_[i]), oz), iz);
+
+    const F4 tNear =
+        Max(Max(Min(tx1, tx2), Min(ty1, ty2)), Min(tz1, tz2));
+    const F4 tFar = Min(Min(Max(tx1, tx2), Max(ty1, ty2)), Max(tz1, tz2));
+
+    // Like bDoesIntersect, a ray starting inside the box does not hit it.
+    vEmitHits(Mask(And(Le(tNear, tFar), Gt(tNear, zero))), tNear, i,
+              boxes.ids_, hits);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+void RayBatch::vIntersect(const ::filament::math::float3& origin,
+                          const ::filament::math::float3& direction,
+                          const PlaneBatch& planes,
+                          std::vector<RayBatchHit>& hits) {
+  // Every plane faces +Y, so a ray parallel to the XZ plane misses them all.
+  if (std::fabs(direction.y) <= 1e-6f) {
+    return;
+  }
+
+  const F4 ox = Set(origin.x), oy = Set(origin.y), oz = Set(origin.z);
+  const F4 dx = Set(direction.x), dz = Set(direction.z);
+  const F4 invDy = Set(1.0f / direction.y), zero = Set(0.0f);
+
+  for (size_t i = 0; i < planes.ids_.size(); i += kLanes) {
+    const F4 t = Mul(Sub(Load(&planes.cy_[i]), oy), invDy);
+    const F4 localX = Sub(Add(ox, Mul(t, dx)), Load(&planes.cx_[i]));
+    const F4 localZ = Sub(Add(oz, Mul(t, dz)), Load(&planes.cz_[i]));
+
+    const F4 inside = And(Le(Abs(localX), Load(&planes.hx_[i])),
+                          Le(Abs(localZ), Load(&planes.hz_[i])));
+    vEmitHits(Mask(And(Ge(t, zero), inside)), t, i, planes.ids_, hits);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+void RayBatch::vSortNearestFirst(std::vector<RayBatchHit>& hits,
+                                 const size_t maxHits) {
+  const auto nearer = [](const RayBatchHit& a, const RayBatchHit& b) {
+    return a.t < b.t;
+  };
+  if (maxHits < hits.size()) {
+    std::partial_sort(hits.begin(),
+                      hits.begin() + static_cast<std::ptrdiff_t>(maxHits),
+                      hits.end(), nearer);
+    hits.resize(maxHits);
+  } else {
+    std::sort(hits.begin(), hits.end(), nearer);
+  }
+}
+
+}  // namespace plugin_filament_view
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <math/vec3.h>
+
+namespace plugin_filament_view {
+
+// Packed structure-of-arrays primitive sets for testing one ray against many
+// shapes at a time. Arrays are padded to the kernel width; ids map a slot
+// back to whatever the caller packed (e.g. an index into its entity list).
+//
+// nAdd returns the slot the shape went into. vSet overwrites a slot in place
+// and nRemove moves the last slot into the hole, so callers that keep an
+// id -> slot lookup can patch single shapes without repacking the batch.
+//
+// The tests match Collidable::bDoesIntersect: spheres use extents.x as the
+// radius and miss when the origin is inside, cubes are axis aligned boxes,
+// planes are Y-up quads sized by extents.x / extents.z.
+struct RayBatchHit {
+  uint32_t id;
+  float t;
+};
+
+// Returned by nRemove when no slot had to move.
+inline constexpr uint32_t kNoRayBatchId = std::numeric_limits<uint32_t>::max();
+
+class SphereBatch {
+ public:
+  uint32_t nAdd(uint32_t id,
+               const ::filament::math::float3& center,
+               float radius);
+  void vSet(uint32_t slot,
+            const ::filament::math::float3& center,
+            float radius);
+  // Returns the id now at slot, or kNoRayBatchId if slot was the last one.
+  uint32_t nRemove(uint32_t slot);
+  void vClear();
+  [[nodiscard]] size_t nSize() const { return ids_.size(); }
+
+ private:
+  friend class RayBatch;
+  std::vector<float> cx_, cy_, cz_, r2_;
+  std::vector<uint32_t> ids_;
+};
+
+class AabbBatch {
+ public:
+  uint32_t nAdd(uint32_t id,
+               const ::filament::math::float3& min,
+               const ::filament::math::float3& max);
+  void vSet(uint32_t slot,
+            const ::filament::math::float3& min,
+            const ::filament::math::float3& max);
+  // Returns the id now at slot, or kNoRayBatchId if slot was the last one.
+  uint32_t nRemove(uint32_t slot);
+  void vClear();
+  [[nodiscard]] size_t nSize() const { return ids_.size(); }
+
+ private:
+  friend class RayBatch;
+  std::vector<float> minX_, minY_, minZ_, maxX_, maxY_, maxZ_;
+  std::vector<uint32_t> ids_;
+};
+
+class PlaneBatch {
+ public:
+  uint32_t nAdd(uint32_t id,
+               const ::filament::math::float3& center,
+               float halfWidth,
+               float halfDepth);
+  void vSet(uint32_t slot,
+            const ::filament::math::float3& center,
+            float halfWidth,
+            float halfDepth);
+  // Returns the id now at slot, or kNoRayBatchId if slot was the last one.
+  uint32_t nRemove(uint32_t slot);
+  void vClear();
+  [[nodiscard]] size_t nSize() const { return ids_.size(); }
+
+ private:
+  friend class RayBatch;
+  std::vector<float> cx_, cy_, cz_, hx_, hz_;
+  std::vector<uint32_t> ids_;
+};
+
+// Batched ray kernels. Four lanes wide with SSE2 on x86-64 and NEON on
+// aarch64, both baseline for those targets; scalar elsewhere.
+class RayBatch {
+ public:
+  // Appends every hit of the ray against the batch to hits, unordered.
+  static void vIntersect(const ::filament::math::float3& origin,
+                         const ::filament::math::float3& direction,
+                         const SphereBatch& spheres,
+                         std::vector<RayBatchHit>& hits);
+  static void vIntersect(const ::filament::math::float3& origin,
+                         const ::filament::math::float3& direction,
+                         const AabbBatch& boxes,
+                         std::vector<RayBatchHit>& hits);
+  static void vIntersect(const ::filament::math::float3& origin,
+                         const ::filament::math::float3& direction,
+                         const PlaneBatch& planes,
+                         std::vector<RayBatchHit>& hits);
+
+  // Orders hits nearest first. With maxHits set, only that many nearest are
+  // kept and ordered, which is all picking usually needs.
+  static void vSortNearestFirst(std::vector<RayBatchHit>& hits,
+                                size_t maxHits = SIZE_MAX);
+
+  static constexpr size_t kLanes = 4;
+};
+
+}  // namespace plugin_filament_view
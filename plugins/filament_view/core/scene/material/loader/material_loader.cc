@@ -19,7 +19,6 @@
 #include <core/include/literals.h>
 #include <core/systems/derived/filament_system.h>
 #include <core/systems/ecsystems_manager.h>
-#include <plugins/common/curl_client/curl_client.h>
 
 namespace plugin_filament_view {
 
@@ -35,12 +34,12 @@ Resource<filament::Material*> MaterialLoader::loadMaterialFromAsset(
     const std::string& path) {
   const auto assetPath =
       ECSystemManager::GetInstance()->getConfigValue<std::string>(kAssetPath);
-  const auto buffer = readBinaryFile(path, assetPath);
+  const auto buffer = mapBinaryFile(path, assetPath);
 
   if (!buffer.empty()) {
     const auto filamentSystem =
         ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-            FilamentSystem::StaticGetTypeID(), "loadMaterialFromAsset");
+            "loadMaterialFromAsset");
     const auto engine = filamentSystem->getFilamentEngine();
 
     const auto material = filament::Material::Builder()
@@ -57,29 +56,22 @@ Resource<filament::Material*> MaterialLoader::loadMaterialFromAsset(
 
 ////////////////////////////////////////////////////////////////////////////
 Resource<filament::Material*> MaterialLoader::loadMaterialFromUrl(
-    const std::string& url) {
-  plugin_common_curl::CurlClient client;
-  // TODO client.Init(url);
-  const std::vector<uint8_t> buffer = client.RetrieveContentAsVector();
-  if (client.GetCode() != CURLE_OK) {
+    const std::string& url,
+    const AssetBuffer& buffer) {
+  if (buffer.empty()) {
     return Resource<filament::Material*>::Error(
         "Failed to load material from " + url);
   }
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "loadMaterialFromUrl");
+          "loadMaterialFromUrl");
   const auto engine = filamentSystem->getFilamentEngine();
 
-  if (!buffer.empty()) {
-    const auto material = filament::Material::Builder()
-                              .package(buffer.data(), buffer.size())
-                              .build(*engine);
-    return Resource<filament::Material*>::Success(material);
-  }
-
-  return Resource<filament::Material*>::Error(
-      "Could not load material from asset.");
+  const auto material = filament::Material::Builder()
+                            .package(buffer.data(), buffer.size())
+                            .build(*engine);
+  return Resource<filament::Material*>::Success(material);
 }
 
 ////////////////////////////////////////////////////////////////////////////
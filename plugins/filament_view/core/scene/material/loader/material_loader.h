@@ -16,6 +16,7 @@
 #pragma once
 
 #include <core/include/resource.h>
+#include <core/utils/asset_buffer.h>
 #include <filament/Material.h>
 #include <future>
 
@@ -29,8 +30,11 @@ class MaterialLoader {
   static Resource<::filament::Material*> loadMaterialFromAsset(
       const std::string& path);
 
+  // Builds a material from bytes already downloaded from url. Fetch them
+  // with AssetCache on the asset I/O pool, never on the Filament strand.
   static Resource<::filament::Material*> loadMaterialFromUrl(
-      const std::string& url);
+      const std::string& url,
+      const AssetBuffer& buffer);
 
   // Disallow copy and assign.
   MaterialLoader(const MaterialLoader&) = delete;
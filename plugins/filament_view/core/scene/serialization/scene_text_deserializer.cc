@@ -15,12 +15,14 @@
  */
 #include "scene_text_deserializer.h"
 
+#include <core/components/derived/material_definitions.h>
 #include <core/entity/derived/nonrenderable_entityobject.h>
 #include <core/include/literals.h>
 #include <core/systems/derived/collision_system.h>
 #include <core/systems/derived/entityobject_locator_system.h>
 #include <core/systems/derived/indirect_light_system.h>
 #include <core/systems/derived/light_system.h>
+#include <core/systems/derived/material_system.h>
 #include <core/systems/derived/model_system.h>
 #include <core/systems/derived/shape_system.h>
 #include <core/systems/derived/skybox_system.h>
@@ -223,29 +225,47 @@ void SceneTextDeserializer::setUpShapes() {
   SPDLOG_TRACE("{} {}", __FUNCTION__, __LINE__);
 
   const auto shapeSystem =
-      ECSystemManager::GetInstance()->poGetSystemAs<ShapeSystem>(
-          ShapeSystem::StaticGetTypeID(), "setUpShapes");
+      ECSystemManager::GetInstance()->poGetSystemAs<ShapeSystem>("setUpShapes");
   const auto collisionSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<CollisionSystem>(
-          CollisionSystem::StaticGetTypeID(), "setUpShapes");
+          "setUpShapes");
+  const auto materialSystem =
+      ECSystemManager::GetInstance()->poGetSystemAs<MaterialSystem>(
+          "setUpShapes");
 
-  if (shapeSystem == nullptr || collisionSystem == nullptr) {
+  if (shapeSystem == nullptr || collisionSystem == nullptr ||
+      materialSystem == nullptr) {
     spdlog::error(
-        "[SceneTextDeserializer] Error.ShapeSystem or collisionSystem is null");
+        "[SceneTextDeserializer] Error.ShapeSystem, collisionSystem or "
+        "materialSystem is null");
     return;
   }
 
+  std::vector<std::string> materialUrls;
   for (const auto& shape : shapes_) {
-    if (shape->HasComponentByStaticTypeID(Collidable::StaticGetTypeID())) {
-      if (collisionSystem != nullptr) {
-        collisionSystem->vAddCollidable(shape.get());
-      }
+    if (const auto materialDefinitions = shape->GetComponentByStaticTypeID(
+            MaterialDefinitions::StaticGetTypeID())) {
+      materialUrls.push_back(
+          dynamic_cast<const MaterialDefinitions*>(materialDefinitions.get())
+              ->szGetMaterialURLPath());
     }
   }
 
-  shapeSystem->addShapesToScene(&shapes_);
-
+  // Shapes are built once their URL materials are downloaded, so building
+  // never waits on the network.
+  auto pendingShapes = std::make_shared<decltype(shapes_)>(std::move(shapes_));
   shapes_.clear();
+  materialSystem->vFetchUrlMaterials(
+      materialUrls, [shapeSystem, collisionSystem, pendingShapes] {
+        for (const auto& shape : *pendingShapes) {
+          if (shape->HasComponentByStaticTypeID(
+                  Collidable::StaticGetTypeID())) {
+            collisionSystem->vAddCollidable(shape.get());
+          }
+        }
+
+        shapeSystem->addShapesToScene(pendingShapes.get());
+      });
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -255,8 +275,7 @@ void SceneTextDeserializer::loadModel(std::shared_ptr<Model>& model) {
 
   post(strand, [model = std::move(model)]() mutable {
     const auto modelSystem =
-        ECSystemManager::GetInstance()->poGetSystemAs<ModelSystem>(
-            ModelSystem::StaticGetTypeID(), "loadModel");
+        ECSystemManager::GetInstance()->poGetSystemAs<ModelSystem>("loadModel");
 
     if (modelSystem == nullptr) {
       spdlog::error("Unable to find the model system.");
@@ -293,8 +312,7 @@ void SceneTextDeserializer::setUpSkybox() const {
   // Todo move to a message.
 
   auto skyboxSystem =
-      ECSystemManager::GetInstance()->poGetSystemAs<SkyboxSystem>(
-          SkyboxSystem::StaticGetTypeID(), __FUNCTION__);
+      ECSystemManager::GetInstance()->poGetSystemAs<SkyboxSystem>(__FUNCTION__);
 
   if (!skybox_) {
     SkyboxSystem::setDefaultSkybox();
@@ -334,8 +352,7 @@ void SceneTextDeserializer::setUpSkybox() const {
 //////////////////////////////////////////////////////////////////////////////////////////
 void SceneTextDeserializer::setUpLights() {
   const auto lightSystem =
-      ECSystemManager::GetInstance()->poGetSystemAs<LightSystem>(
-          LightSystem::StaticGetTypeID(), __FUNCTION__);
+      ECSystemManager::GetInstance()->poGetSystemAs<LightSystem>(__FUNCTION__);
 
   // Note, this introduces a fire and forget functionality for entities
   // there's no "one" owner system, but its propagated to whomever cares for it.
@@ -365,7 +382,7 @@ void SceneTextDeserializer::setUpIndirectLight() const {
   // Todo move to a message.
   auto indirectlightSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<IndirectLightSystem>(
-          IndirectLightSystem::StaticGetTypeID(), __FUNCTION__);
+          __FUNCTION__);
 
   if (!indirect_light_) {
     // This was called in the constructor of indirectLightManager_ anyway.
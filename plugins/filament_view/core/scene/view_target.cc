@@ -30,6 +30,7 @@
 #include <view/flutter_view.h>
 #include <wayland/display.h>
 #include <asio/post.hpp>
+#include <limits>
 #include <utility>
 
 using flutter::EncodableList;
@@ -72,7 +73,7 @@ ViewTarget::~ViewTarget() {
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "~ViewTarget");
+          "~ViewTarget");
   const auto engine = filamentSystem->getFilamentEngine();
 
   engine->destroy(fview_);
@@ -154,7 +155,7 @@ void ViewTarget::InitializeFilamentInternals(const uint32_t width,
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "ViewTarget::Initialize");
+          "ViewTarget::Initialize");
 
   const auto engine = filamentSystem->getFilamentEngine();
   fswapChain_ = engine->createSwapChain(&native_window_);
@@ -171,7 +172,7 @@ void ViewTarget::setupView(uint32_t width, uint32_t height) {
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), __FUNCTION__);
+          __FUNCTION__);
 
   fview_->setScene(filamentSystem->getFilamentScene());
 
@@ -345,7 +346,7 @@ void ViewTarget::vChangeQualitySettings(
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "Change Quality Settings");
+          "Change Quality Settings");
 
   // Now apply the settings to the Filament engine and view
   applySettings(filamentSystem->getFilamentEngine(), settings, fview_);
@@ -364,7 +365,7 @@ void ViewTarget::SendFrameViewCallback(
 
   const auto viewTargetSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<ViewTargetSystem>(
-          ViewTargetSystem::StaticGetTypeID(), __FUNCTION__);
+          __FUNCTION__);
 
   viewTargetSystem->vSendDataToEventChannel(encodableMap);
 }
@@ -407,7 +408,7 @@ void ViewTarget::DrawFrame(const uint32_t time) {
   // Render the scene, unless the renderer wants to skip the frame.
   if (const auto filamentSystem =
           ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-              FilamentSystem::StaticGetTypeID(), "DrawFrame");
+              "DrawFrame");
       filamentSystem->getFilamentRenderer()->beginFrame(fswapChain_, time)) {
     // Note you might want render time and gameplay time to be different
     // but for smooth animation you don't. (physics would be simulated w/o
@@ -461,6 +462,9 @@ void ViewTarget::OnFrame(void* data,
       wl_callback_destroy(callback);
     }
 
+    // Update the systems in step with the display before drawing.
+    ECSystemManager::GetInstance()->vOnFrameCallback();
+
     obj->DrawFrame(time);
 
     obj->callback_ = wl_surface_frame(obj->surface_);
@@ -502,19 +506,22 @@ void ViewTarget::resize(const double width, const double height) {
 void ViewTarget::vOnTouch(const int32_t action,
                           const int32_t point_count,
                           const size_t point_data_size,
-                          const double* point_data) const {
-  auto filamentSystem =
-      ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), __FUNCTION__);
-
-  // if action is 0, then on 'first' touch, cast ray from camera;
-  const auto viewport = fview_->getViewport();
-  const auto touch =
-      TouchPair(point_count, point_data_size, point_data, viewport.height);
-
+                          const double* point_data) {
+  // Android MotionEvent actions; the pointer index of a secondary pointer
+  // going down or up is in the second byte.
   static constexpr int ACTION_DOWN = 0;
+  static constexpr int ACTION_UP = 1;
+  static constexpr int ACTION_CANCEL = 3;
+  static constexpr int ACTION_POINTER_DOWN = 5;
+  static constexpr int ACTION_POINTER_UP = 6;
+  const int32_t actionMasked = action & 0xff;
+  const int32_t actionIndex = (action >> 8) & 0xff;
 
-  if (action == ACTION_DOWN) {
+  // if action is 0, then on 'first' touch, cast ray from camera;
+  if (actionMasked == ACTION_DOWN && cameraManager_) {
+    const auto viewport = fview_->getViewport();
+    const auto touch =
+        TouchPair(point_count, point_data_size, point_data, viewport.height);
     const auto rayInfo =
         cameraManager_->oGetRayInformationFromOnTouchPosition(touch);
 
@@ -522,6 +529,8 @@ void ViewTarget::vOnTouch(const int32_t action,
     rayInformation.addData(ECSMessageType::DebugLine, rayInfo);
     ECSystemManager::GetInstance()->vRouteMessage(rayInformation);
 
+    // The collision event Dart listeners receive on touch-down, kept next to
+    // the pick events below.
     ECSMessage collisionRequest;
     collisionRequest.addData(ECSMessageType::CollisionRequest, rayInfo);
     collisionRequest.addData(ECSMessageType::CollisionRequestRequestor,
@@ -531,8 +540,114 @@ void ViewTarget::vOnTouch(const int32_t action,
     ECSystemManager::GetInstance()->vRouteMessage(collisionRequest);
   }
 
+  // Every action goes through the batched picker, one pick per pointer.
+  const auto points = vecTrackPointers(actionMasked, actionIndex, point_count,
+                                       point_data_size, point_data);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const bool bIsActionPointer = static_cast<int32_t>(i) == actionIndex;
+    CollisionEventType eType = eNativeOnTouchHeld;
+    if (actionMasked == ACTION_DOWN ||
+        (actionMasked == ACTION_POINTER_DOWN && bIsActionPointer)) {
+      eType = eNativeOnTouchBegin;
+    } else if (actionMasked == ACTION_UP || actionMasked == ACTION_CANCEL ||
+               (actionMasked == ACTION_POINTER_UP && bIsActionPointer)) {
+      eType = eNativeOnTouchEnd;
+    }
+    vQueuePickPoints({points[i]}, eType);
+  }
+
+  // Lifted pointers don't take part in matching the next event.
+  if (actionMasked == ACTION_UP || actionMasked == ACTION_CANCEL) {
+    m_vecTrackedPointers.clear();
+  } else if (actionMasked == ACTION_POINTER_UP &&
+             static_cast<size_t>(actionIndex) < m_vecTrackedPointers.size()) {
+    m_vecTrackedPointers.erase(m_vecTrackedPointers.begin() + actionIndex);
+  }
+
   if (cameraManager_) {
     cameraManager_->onAction(action, point_count, point_data_size, point_data);
   }
 }
+
+////////////////////////////////////////////////////////////////////////////
+std::vector<ViewTarget::PickPoint> ViewTarget::vecTrackPointers(
+    const int32_t actionMasked,
+    const int32_t actionIndex,
+    const int32_t point_count,
+    const size_t point_data_size,
+    const double* point_data) {
+  static constexpr int ACTION_DOWN = 0;
+  static constexpr int ACTION_POINTER_DOWN = 5;
+  // point_data is the flattened AndroidPointerCoords of each pointer:
+  // orientation, pressure, size, toolMajor, toolMinor, touchMajor,
+  // touchMinor, x, y.
+  static constexpr size_t kPointerCoordsSize = 9;
+  static constexpr size_t kPointerCoordX = 7;
+
+  // Like Android, ids start over with each gesture.
+  if (actionMasked == ACTION_DOWN) {
+    m_vecTrackedPointers.clear();
+    m_nNextPointerId = 0;
+  }
+
+  std::vector<bool> vecClaimed(m_vecTrackedPointers.size(), false);
+  std::vector<PickPoint> points;
+  for (int32_t i = 0; i < point_count; ++i) {
+    const size_t nX = static_cast<size_t>(i) * kPointerCoordsSize +
+                      kPointerCoordX;
+    if (point_data == nullptr || nX + 1 >= point_data_size) {
+      break;
+    }
+    const ::filament::math::float2 position = {
+        static_cast<float>(point_data[nX]),
+        static_cast<float>(point_data[nX + 1])};
+
+    int32_t nPointerId = -1;
+    if (!(actionMasked == ACTION_POINTER_DOWN && i == actionIndex)) {
+      size_t nNearest = m_vecTrackedPointers.size();
+      float fNearest = std::numeric_limits<float>::max();
+      for (size_t j = 0; j < m_vecTrackedPointers.size(); ++j) {
+        const auto delta = m_vecTrackedPointers[j].position - position;
+        if (const float fDistance2 = dot(delta, delta);
+            !vecClaimed[j] && fDistance2 < fNearest) {
+          nNearest = j;
+          fNearest = fDistance2;
+        }
+      }
+      if (nNearest < m_vecTrackedPointers.size()) {
+        vecClaimed[nNearest] = true;
+        nPointerId = m_vecTrackedPointers[nNearest].nPointerId;
+      }
+    }
+    if (nPointerId < 0) {
+      nPointerId = m_nNextPointerId++;
+    }
+    points.push_back({nPointerId, position});
+  }
+
+  m_vecTrackedPointers = points;
+  return points;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void ViewTarget::vQueuePickPoints(const std::vector<PickPoint>& points,
+                                  const CollisionEventType eType) const {
+  if (!cameraManager_) {
+    return;
+  }
+
+  const auto height = static_cast<float>(fview_->getViewport().height);
+  for (const auto& point : points) {
+    // Same y flip as TouchPair.
+    const auto rayInfo = cameraManager_->oGetRayInformationFromScreenPosition(
+        point.position.x, height - point.position.y);
+
+    ECSMessage pickRequest;
+    pickRequest.addData(ECSMessageType::PickRequest, rayInfo);
+    pickRequest.addData(ECSMessageType::PickPointerId, point.nPointerId);
+    pickRequest.addData(ECSMessageType::CollisionRequestType, eType);
+    ECSystemManager::GetInstance()->vRouteMessage(pickRequest);
+  }
+}
+
 }  // namespace plugin_filament_view
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <core/include/literals.h>
 #include <core/scene/camera/camera.h>
 #include <core/scene/camera/camera_manager.h>
 #include <event_channel.h>
@@ -25,6 +26,7 @@
 #include <viewer/Settings.h>
 #include <asio/io_context_strand.hpp>
 #include <cstdint>
+#include <vector>
 
 namespace plugin_filament_view {
 
@@ -72,10 +74,23 @@ class ViewTarget {
   void vSetupCameraManagerWithDeserializedCamera(
       std::unique_ptr<Camera> camera) const;
 
+  // Every action queues one pick per pointer, see vQueuePickPoints.
   void vOnTouch(int32_t action,
                 int32_t point_count,
                 size_t point_data_size,
-                const double* point_data) const;
+                const double* point_data);
+
+  struct PickPoint {
+    int32_t nPointerId;
+    // View coordinates, origin top left.
+    ::filament::math::float2 position;
+  };
+
+  // Queues a pick per point with the CollisionSystem. Everything queued
+  // before the next frame is resolved in one batch and reported as a single
+  // kCollisionPickEvent. Use eNativeOnHover for cursors that aren't pressed.
+  void vQueuePickPoints(const std::vector<PickPoint>& points,
+                        CollisionEventType eType) const;
 
   [[nodiscard]] CameraManager* getCameraManager() const {
     return cameraManager_.get();
@@ -86,6 +101,18 @@ class ViewTarget {
  private:
   void setupWaylandSubsurface();
 
+  // The platform view listener hands over pointer coordinates but not the
+  // pointer ids, so ids are assigned here. A pointer keeps the id of the
+  // nearest pointer of the previous event; one going down gets a new id.
+  std::vector<PickPoint> vecTrackPointers(int32_t actionMasked,
+                                          int32_t actionIndex,
+                                          int32_t point_count,
+                                          size_t point_data_size,
+                                          const double* point_data);
+
+  std::vector<PickPoint> m_vecTrackedPointers;
+  int32_t m_nNextPointerId = 0;
+
   FlutterDesktopEngineState* state_;
   filament::viewer::Settings settings_;
   filament::gltfio::FilamentAsset* asset_{};
@@ -19,7 +19,6 @@
 #include <plugin_registrar.h>
 #include <standard_method_codec.h>
 #include <functional>
-#include <queue>
 #include <unordered_map>
 #include <vector>
 
@@ -32,12 +31,8 @@ namespace plugin_filament_view {
 ////////////////////////////////////////////////////////////////////////////
 // Send a message to the system
 void ECSystem::vSendMessage(const ECSMessage& msg) {
-  SPDLOG_TRACE("[vSendMessage] Attempting to acquire messagesMutex");
-  std::unique_lock lock(messagesMutex);
-  SPDLOG_TRACE("[vSendMessage] messagesMutex acquired");
-  messageQueue_.push(msg);
-  SPDLOG_TRACE("[vSendMessage] Message pushed to queue. Queue size: {}",
-               messageQueue_.size());
+  messageQueue_.vPush(msg);
+  SPDLOG_TRACE("[vSendMessage] Message pushed to queue");
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -48,6 +43,7 @@ void ECSystem::vRegisterMessageHandler(ECSMessageType type,
   std::unique_lock lock(handlersMutex);
   SPDLOG_TRACE("[vRegisterMessageHandler] handlersMutex acquired");
   handlers_[type].push_back(handler);
+  subscribed_[static_cast<size_t>(type)] = true;
   SPDLOG_TRACE(
       "[vRegisterMessageHandler] Handler registered for message type {}",
       static_cast<int>(type));
@@ -61,6 +57,7 @@ void ECSystem::vUnregisterMessageHandler(ECSMessageType type) {
   std::unique_lock lock(handlersMutex);
   SPDLOG_TRACE("[vUnregisterMessageHandler] handlersMutex acquired");
   handlers_.erase(type);
+  subscribed_[static_cast<size_t>(type)] = false;
   SPDLOG_TRACE(
       "[vUnregisterMessageHandler] Handlers unregistered for message type {}",
       static_cast<int>(type));
@@ -73,32 +70,36 @@ void ECSystem::vClearMessageHandlers() {
   std::unique_lock lock(handlersMutex);
   SPDLOG_TRACE("[vClearMessageHandlers] handlersMutex acquired");
   handlers_.clear();
+  for (auto& subscribed : subscribed_) {
+    subscribed = false;
+  }
   SPDLOG_TRACE("[vClearMessageHandlers] All handlers cleared");
 }
 
+////////////////////////////////////////////////////////////////////////////
+bool ECSystem::bIsSubscribedTo(const ECSMessage& msg) const {
+  for (size_t i = 0; i < msg.nGetEntryCount(); i++) {
+    if (subscribed_[static_cast<size_t>(msg.eGetEntryType(i))]) {
+      return true;
+    }
+  }
+  return false;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // Process incoming messages
 void ECSystem::vProcessMessages() {
-  SPDLOG_TRACE("[vProcessMessages] Attempting to acquire messagesMutex");
-  std::queue<ECSMessage> messagesToProcess;
+  // Messages sent while these are handled wait for the next update.
+  messagesToProcess_.clear();
+  messageQueue_.vPopAll(messagesToProcess_);
+  SPDLOG_TRACE("[vProcessMessages] Messages to process: {}",
+               messagesToProcess_.size());
 
-  {
-    std::unique_lock lock(messagesMutex);
-    SPDLOG_TRACE("[vProcessMessages] messagesMutex acquired");
-    std::swap(messageQueue_, messagesToProcess);
-    SPDLOG_TRACE(
-        "[vProcessMessages] Swapped message queues. Messages to process: {}",
-        messagesToProcess.size());
-  }  // messagesMutex is unlocked here
-
-  while (!messagesToProcess.empty()) {
-    const ECSMessage& msg = messagesToProcess.front();
+  for (const auto& msg : messagesToProcess_) {
     SPDLOG_TRACE("[vProcessMessages] Processing message");
     vHandleMessage(msg);
-    messagesToProcess.pop();
-    SPDLOG_TRACE("[vProcessMessages] Message processed. Remaining messages: {}",
-                 messagesToProcess.size());
   }
+  messagesToProcess_.clear();
 
   SPDLOG_TRACE("[vProcessMessages] done");
 }
@@ -107,23 +108,24 @@ void ECSystem::vProcessMessages() {
 // Handle a specific message type by invoking the registered handlers
 void ECSystem::vHandleMessage(const ECSMessage& msg) {
   SPDLOG_TRACE("[vHandleMessage] Attempting to acquire handlersMutex");
-  std::vector<ECSMessageHandler> handlersToInvoke;
+  handlersToInvoke_.clear();
   {
     std::unique_lock lock(handlersMutex);
     SPDLOG_TRACE("[vHandleMessage] handlersMutex acquired");
-    for (const auto& [type, handlerList] : handlers_) {
-      if (msg.hasData(type)) {
+    for (size_t i = 0; i < msg.nGetEntryCount(); i++) {
+      const auto type = msg.eGetEntryType(i);
+      if (const auto it = handlers_.find(type); it != handlers_.end()) {
         SPDLOG_TRACE("[vHandleMessage] Message has data for type {}",
                      static_cast<int>(type));
-        handlersToInvoke.insert(handlersToInvoke.end(), handlerList.begin(),
-                                handlerList.end());
+        handlersToInvoke_.insert(handlersToInvoke_.end(), it->second.begin(),
+                                 it->second.end());
       }
     }
   }  // handlersMutex is unlocked here
   SPDLOG_TRACE("[vHandleMessage] Handlers to invoke: {}",
-               handlersToInvoke.size());
+               handlersToInvoke_.size());
 
-  for (const auto& handler : handlersToInvoke) {
+  for (const auto& handler : handlersToInvoke_) {
     SPDLOG_TRACE("[vHandleMessage] Invoking handler");
     try {
       handler(msg);
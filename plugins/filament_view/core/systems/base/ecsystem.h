@@ -17,13 +17,15 @@
 
 #include <encodable_value.h>
 #include <event_channel.h>
+#include <array>
+#include <atomic>
 #include <functional>
 #include <mutex>
-#include <queue>
 #include <unordered_map>
 #include <vector>
 
 #include <core/systems/messages/ecs_message.h>
+#include <core/systems/messages/ecs_message_queue.h>
 #include <core/systems/messages/ecs_message_types.h>
 
 namespace flutter {
@@ -52,6 +54,10 @@ class ECSystem {
   // Clear all message handlers
   void vClearMessageHandlers();
 
+  // True if a handler is registered for any type the message holds; the
+  // manager only routes messages to their subscribers.
+  [[nodiscard]] bool bIsSubscribedTo(const ECSMessage& msg) const;
+
   // Process incoming messages
   virtual void vProcessMessages();
 
@@ -67,6 +73,12 @@ class ECSystem {
     return typeid(ECSystem).hash_code();
   }
 
+  // Type IDs of the systems that have to be updated before this one each
+  // frame. Systems that do not depend on each other share a stage.
+  [[nodiscard]] virtual std::vector<size_t> vecGetDependencies() const {
+    return {};
+  }
+
   virtual void DebugPrint() = 0;
 
   void vSetupMessageChannels(flutter::PluginRegistrar* poPluginRegistrar,
@@ -79,13 +91,19 @@ class ECSystem {
   virtual void vHandleMessage(const ECSMessage& msg);
 
  private:
-  std::queue<ECSMessage> messageQueue_;  // Queue of incoming messages
+  ECSMessageQueue messageQueue_;  // Queue of incoming messages
   std::unordered_map<ECSMessageType,
                      std::vector<ECSMessageHandler>,
                      EnumClassHash>
       handlers_;  // Registered handlers
+  std::array<std::atomic<bool>,
+             static_cast<size_t>(ECSMessageType::ECSMessageTypeCount)>
+      subscribed_{};
+
+  // Only used by vProcessMessages / vHandleMessage, kept to reuse capacity.
+  std::vector<ECSMessage> messagesToProcess_;
+  std::vector<ECSMessageHandler> handlersToInvoke_;
 
-  std::mutex messagesMutex;
   std::mutex handlersMutex;
 
   std::unique_ptr<flutter::EventChannel<flutter::EncodableValue>>
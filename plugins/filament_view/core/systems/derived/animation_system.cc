@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "animation_system.h"
+#include "model_system.h"
 
+#include <core/components/base/component_pool.h>
 #include <core/entity/base/entityobject.h>
 #include <core/include/literals.h>
 #include <core/systems/ecsystems_manager.h>
@@ -37,10 +39,8 @@ void AnimationSystem::vInitSystem() {
             msg.getData<int32_t>(ECSMessageType::AnimationEnqueue);
 
         if (const auto it = _entities.find(guid); it != _entities.end()) {
-          const auto animationComponent = dynamic_cast<Animation*>(
-              it->second
-                  ->GetComponentByStaticTypeID(Animation::StaticGetTypeID())
-                  .get());
+          const auto animationComponent =
+              it->second->poGetComponent<Animation>();
           if (animationComponent) {
             animationComponent->vEnqueueAnimation(animationIndex);
             spdlog::debug("AnimationEnqueue Complete for GUID: {}", guid);
@@ -57,10 +57,8 @@ void AnimationSystem::vInitSystem() {
             msg.getData<EntityGUID>(ECSMessageType::EntityToTarget);
 
         if (const auto it = _entities.find(guid); it != _entities.end()) {
-          const auto animationComponent = dynamic_cast<Animation*>(
-              it->second
-                  ->GetComponentByStaticTypeID(Animation::StaticGetTypeID())
-                  .get());
+          const auto animationComponent =
+              it->second->poGetComponent<Animation>();
           if (animationComponent) {
             animationComponent->vClearQueue();
             spdlog::debug("AnimationClearQueue Complete for GUID: {}", guid);
@@ -79,10 +77,8 @@ void AnimationSystem::vInitSystem() {
             msg.getData<int32_t>(ECSMessageType::AnimationPlay);
 
         if (const auto it = _entities.find(guid); it != _entities.end()) {
-          const auto animationComponent = dynamic_cast<Animation*>(
-              it->second
-                  ->GetComponentByStaticTypeID(Animation::StaticGetTypeID())
-                  .get());
+          const auto animationComponent =
+              it->second->poGetComponent<Animation>();
           if (animationComponent) {
             animationComponent->vPlayAnimation(animationIndex);
             spdlog::debug("AnimationPlay Complete for GUID: {}", guid);
@@ -101,10 +97,8 @@ void AnimationSystem::vInitSystem() {
             msg.getData<float>(ECSMessageType::AnimationChangeSpeed);
 
         if (const auto it = _entities.find(guid); it != _entities.end()) {
-          const auto animationComponent = dynamic_cast<Animation*>(
-              it->second
-                  ->GetComponentByStaticTypeID(Animation::StaticGetTypeID())
-                  .get());
+          const auto animationComponent =
+              it->second->poGetComponent<Animation>();
           if (animationComponent) {
             animationComponent->vSetPlaybackSpeedScalar(newSpeed);
             spdlog::debug("AnimationChangeSpeed Complete for GUID: {}", guid);
@@ -121,10 +115,8 @@ void AnimationSystem::vInitSystem() {
             msg.getData<EntityGUID>(ECSMessageType::EntityToTarget);
 
         if (const auto it = _entities.find(guid); it != _entities.end()) {
-          const auto animationComponent = dynamic_cast<Animation*>(
-              it->second
-                  ->GetComponentByStaticTypeID(Animation::StaticGetTypeID())
-                  .get());
+          const auto animationComponent =
+              it->second->poGetComponent<Animation>();
           if (animationComponent) {
             animationComponent->vPause();
             spdlog::debug("AnimationPause Complete for GUID: {}", guid);
@@ -141,10 +133,8 @@ void AnimationSystem::vInitSystem() {
             msg.getData<EntityGUID>(ECSMessageType::EntityToTarget);
 
         if (const auto it = _entities.find(guid); it != _entities.end()) {
-          const auto animationComponent = dynamic_cast<Animation*>(
-              it->second
-                  ->GetComponentByStaticTypeID(Animation::StaticGetTypeID())
-                  .get());
+          const auto animationComponent =
+              it->second->poGetComponent<Animation>();
           if (animationComponent) {
             animationComponent->vResume();
             spdlog::debug("AnimationResume Complete for GUID: {}", guid);
@@ -163,10 +153,8 @@ void AnimationSystem::vInitSystem() {
             msg.getData<bool>(ECSMessageType::AnimationSetLooping);
 
         if (const auto it = _entities.find(guid); it != _entities.end()) {
-          const auto animationComponent = dynamic_cast<Animation*>(
-              it->second
-                  ->GetComponentByStaticTypeID(Animation::StaticGetTypeID())
-                  .get());
+          const auto animationComponent =
+              it->second->poGetComponent<Animation>();
           if (animationComponent) {
             animationComponent->vSetLooping(shouldLoop);
             spdlog::debug("AnimationSetLooping Complete for GUID: {}", guid);
@@ -177,11 +165,9 @@ void AnimationSystem::vInitSystem() {
 
 ////////////////////////////////////////////////////////////////////////////////////
 void AnimationSystem::vUpdate(const float fElapsedTime) {
-  for (auto& [fst, snd] : _entities) {
-    const auto animator = dynamic_cast<Animation*>(
-        snd->GetComponentByStaticTypeID(Animation::StaticGetTypeID()).get());
-    animator->vUpdate(fElapsedTime);
-  }
+  // The pool holds the Animation of every entity in _entities.
+  ComponentPool<Animation>::GetInstance().vForEach(
+      [fElapsedTime](Animation& animator) { animator.vUpdate(fElapsedTime); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -194,12 +180,22 @@ void AnimationSystem::vRegisterEntityObject(
   }
 
   _entities.insert(std::pair(entity->GetGlobalGuid(), entity));
+  if (const auto animation = entity->poGetComponent<Animation>()) {
+    ComponentPool<Animation>::GetInstance().vInsert(entity->nGetPoolIndex(),
+                                                    animation);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
 void AnimationSystem::vUnregisterEntityObject(
     const std::shared_ptr<EntityObject>& entity) {
   _entities.erase(entity->GetGlobalGuid());
+  ComponentPool<Animation>::GetInstance().vErase(entity->nGetPoolIndex());
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+std::vector<size_t> AnimationSystem::vecGetDependencies() const {
+  return {ModelSystem::StaticGetTypeID()};
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
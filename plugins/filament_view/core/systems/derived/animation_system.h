@@ -46,6 +46,8 @@ class AnimationSystem : public ECSystem {
     return typeid(AnimationSystem).hash_code();
   }
 
+  [[nodiscard]] std::vector<size_t> vecGetDependencies() const override;
+
   void vInitSystem() override;
   void vUpdate(float fElapsedTime) override;
   void vShutdownSystem() override;
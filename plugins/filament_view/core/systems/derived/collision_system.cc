@@ -61,9 +61,41 @@ void CollisionSystem::vAddCollidable(EntityObject* collidable) {
     return;
   }
 
-  const auto originalCollidable = dynamic_cast<Collidable*>(
-      collidable->GetComponentByStaticTypeID(Collidable::StaticGetTypeID())
-          .get());
+  if (m_mapLeafByEntity.find(collidable) != m_mapLeafByEntity.end()) {
+    vUpdateCollidable(collidable);
+    return;
+  }
+
+  if (!bBuildDebugRepresentation(collidable)) {
+    return;
+  }
+
+  collidables_.push_back(collidable);
+  vPatchBatches(collidable);
+
+  m_mapLeafByEntity[collidable] = m_oTree.nInsert(
+      collidable->poGetComponent<Collidable>()->GetWorldAabb(), collidable);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+void CollisionSystem::vUpdateCollidable(EntityObject* collidable) {
+  const auto leaf = m_mapLeafByEntity.find(collidable);
+  if (leaf == m_mapLeafByEntity.end()) {
+    return;
+  }
+
+  vDestroyDebugRepresentation(collidable->GetGlobalGuid());
+  bBuildDebugRepresentation(collidable);
+  vPatchBatches(collidable);
+
+  // Small moves stay inside the leaf's fat box and cost nothing here.
+  m_oTree.bMove(leaf->second,
+                collidable->poGetComponent<Collidable>()->GetWorldAabb());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+bool CollisionSystem::bBuildDebugRepresentation(EntityObject* collidable) {
+  const auto originalCollidable = collidable->poGetComponent<Collidable>();
 
   if (originalCollidable != nullptr &&
       originalCollidable->GetShouldMatchAttachedObject()) {
@@ -93,16 +125,10 @@ void CollisionSystem::vAddCollidable(EntityObject* collidable) {
     ourModelObject->vShallowCopyComponentToOther(
         CommonRenderable::StaticGetTypeID(), *newShape);
 
-    const std::shared_ptr<Component> componentBT =
-        newShape->GetComponentByStaticTypeID(BaseTransform::StaticGetTypeID());
     const std::shared_ptr<BaseTransform> baseTransformPtr =
-        std::dynamic_pointer_cast<BaseTransform>(componentBT);
-
-    const std::shared_ptr<Component> componentCR =
-        newShape->GetComponentByStaticTypeID(
-            CommonRenderable::StaticGetTypeID());
+        newShape->GetComponent<BaseTransform>();
     const std::shared_ptr<CommonRenderable> commonRenderablePtr =
-        std::dynamic_pointer_cast<CommonRenderable>(componentCR);
+        newShape->GetComponent<CommonRenderable>();
 
     newShape->m_poBaseTransform =
         std::weak_ptr<BaseTransform>(baseTransformPtr);
@@ -143,16 +169,14 @@ void CollisionSystem::vAddCollidable(EntityObject* collidable) {
   if (newShape == nullptr) {
     // log not handled;
     spdlog::error("Failed to create collidable shape.");
-    return;
+    return false;
   }
 
-  collidables_.push_back(collidable);
-
   newShape->m_bIsWireframe = true;
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "vAddCollidable");
+          "bBuildDebugRepresentation");
   const auto engine = filamentSystem->getFilamentEngine();
 
   filament::Scene* poFilamentScene = filamentSystem->getFilamentScene();
@@ -166,21 +190,32 @@ void CollisionSystem::vAddCollidable(EntityObject* collidable) {
   // now store in map.
   collidablesDebugDrawingRepresentation_.insert(
       std::pair(collidable->GetGlobalGuid(), newShape));
+  return true;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-void CollisionSystem::vRemoveCollidable(EntityObject* collidable) {
-  collidables_.remove(collidable);
-
-  // Remove from collidablesDebugDrawingRepresentation_
-  const auto iter =
-      collidablesDebugDrawingRepresentation_.find(collidable->GetGlobalGuid());
+void CollisionSystem::vDestroyDebugRepresentation(const EntityGUID& guid) {
+  const auto iter = collidablesDebugDrawingRepresentation_.find(guid);
   if (iter != collidablesDebugDrawingRepresentation_.end()) {
     delete iter->second;
     collidablesDebugDrawingRepresentation_.erase(iter);
   }
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+void CollisionSystem::vRemoveCollidable(EntityObject* collidable) {
+  collidables_.remove(collidable);
+  vUnbatch(collidable);
+
+  if (const auto leaf = m_mapLeafByEntity.find(collidable);
+      leaf != m_mapLeafByEntity.end()) {
+    m_oTree.vRemove(leaf->second);
+    m_mapLeafByEntity.erase(leaf);
+  }
+
+  vDestroyDebugRepresentation(collidable->GetGlobalGuid());
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 void CollisionSystem::vTurnOnRenderingOfCollidables() const {
   for (const auto& [fst, snd] : collidablesDebugDrawingRepresentation_) {
@@ -204,60 +239,197 @@ void CollisionSystem::DebugPrint() {
   }*/
 }
 
-/////////////////////////////////////////////////////////////////////////////////////////
-inline float fLength2(const filament::math::float3& v) {
-  return v.x * v.x + v.y * v.y + v.z * v.z;
-}
-
 /////////////////////////////////////////////////////////////////////////////////////////
 std::list<HitResult> CollisionSystem::lstCheckForCollidable(
     Ray& rayCast,
     int64_t /*collisionLayer*/) const {
+  // Check if the collision layer matches (if a specific layer was provided)
+  // if (collisionLayer != 0 && (collidable->GetCollisionLayer() &
+  // collisionLayer) == 0) {
+  //    continue; // Skip if layers don't match
+  // }
+
   std::list<HitResult> hitResults;
+  vRaycastTree(rayCast, SIZE_MAX, hitResults);
+  return hitResults;
+}
 
-  // Iterate over all entities.
-  for (const auto& entity : collidables_) {
-    // Make sure collidable is still here....
-    auto collidable = std::dynamic_pointer_cast<Collidable>(
-        entity->GetComponentByStaticTypeID(Collidable::StaticGetTypeID()));
-    if (!collidable) {
-      continue;  // No collidable component, skip this entity
+/////////////////////////////////////////////////////////////////////////////////////////
+void CollisionSystem::vRaycastTree(const Ray& ray,
+                                   const size_t maxHits,
+                                   std::list<HitResult>& hitResults) const {
+  const filament::math::float3 origin = ray.f3GetPosition();
+  const filament::math::float3 direction = ray.f3GetDirection();
+  const float directionLength2 = dot(direction, direction);
+  if (directionLength2 <= 0.0f || maxHits == 0) {
+    return;
+  }
+
+  // The tree only opens leaves the ray reaches, nearest box first, and hands
+  // back hits in increasing distance, so the list comes out sorted and the
+  // walk can stop at maxHits.
+  m_oTree.vRaycast(
+      origin, direction,
+      [&](EntityObject* entity, float& t) {
+        const auto collidable = entity->poGetComponent<Collidable>();
+        if (filament::math::float3 hitLocation;
+            collidable != nullptr &&
+            collidable->bDoesIntersect(ray, hitLocation)) {
+          t = dot(hitLocation - origin, direction) / directionLength2;
+          return true;
+        }
+        return false;
+      },
+      [&](EntityObject* entity, const float t) {
+        HitResult hitResult;
+        hitResult.guid_ = entity->GetGlobalGuid();
+        hitResult.name_ = entity->GetName();
+        hitResult.hitPosition_ = origin + t * direction;
+        hitResults.push_back(hitResult);
+        return hitResults.size() < maxHits;
+      });
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+void CollisionSystem::vPatchBatches(EntityObject* entity) {
+  const auto collidable = entity->poGetComponent<Collidable>();
+  const ShapeType eShape = collidable != nullptr && collidable->GetIsEnabled()
+                               ? collidable->GetShapeType()
+                               : ShapeType::Unset;
+  if (eShape != ShapeType::Sphere && eShape != ShapeType::Cube &&
+      eShape != ShapeType::Plane) {
+    vUnbatch(entity);
+    return;
+  }
+
+  uint32_t id;
+  if (const auto it = m_mapBatchIdByEntity.find(entity);
+      it != m_mapBatchIdByEntity.end()) {
+    id = it->second;
+  } else if (!m_vecFreeBatchIds.empty()) {
+    id = m_vecFreeBatchIds.back();
+    m_vecFreeBatchIds.pop_back();
+    m_vecBatchEntries[id] = {entity, ShapeType::Unset, 0};
+    m_mapBatchIdByEntity.emplace(entity, id);
+  } else {
+    id = static_cast<uint32_t>(m_vecBatchEntries.size());
+    m_vecBatchEntries.push_back({entity, ShapeType::Unset, 0});
+    m_mapBatchIdByEntity.emplace(entity, id);
+  }
+
+  // A shape type change moves it to another batch.
+  if (m_vecBatchEntries[id].eShape != eShape) {
+    if (m_vecBatchEntries[id].eShape != ShapeType::Unset) {
+      vRemoveBatchSlot(m_vecBatchEntries[id]);
     }
+    m_vecBatchEntries[id].eShape = eShape;
+    m_vecBatchEntries[id].nSlot = kNoRayBatchId;
+  }
 
-    // Check if the collision layer matches (if a specific layer was provided)
-    // if (collisionLayer != 0 && (collidable->GetCollisionLayer() &
-    // collisionLayer) == 0) {
-    //    continue; // Skip if layers don't match
-    // }
+  const bool bIsNew = m_vecBatchEntries[id].nSlot == kNoRayBatchId;
+  uint32_t& slot = m_vecBatchEntries[id].nSlot;
+  const auto center = collidable->GetCenterPoint();
+  const auto extents = collidable->GetExtentsSize();
+  switch (eShape) {
+    case ShapeType::Sphere:
+      if (bIsNew) {
+        slot = m_oSphereBatch.nAdd(id, center, extents.x);
+      } else {
+        m_oSphereBatch.vSet(slot, center, extents.x);
+      }
+      break;
+    case ShapeType::Cube: {
+      const Aabb box = collidable->GetWorldAabb();
+      if (bIsNew) {
+        slot = m_oAabbBatch.nAdd(id, box.min, box.max);
+      } else {
+        m_oAabbBatch.vSet(slot, box.min, box.max);
+      }
+      break;
+    }
+    case ShapeType::Plane:
+      if (bIsNew) {
+        slot = m_oPlaneBatch.nAdd(id, center, extents.x * 0.5f,
+                                  extents.z * 0.5f);
+      } else {
+        m_oPlaneBatch.vSet(slot, center, extents.x * 0.5f, extents.z * 0.5f);
+      }
+      break;
+    default:
+      break;
+  }
+}
 
-    // Perform intersection test with the ray
-    if (filament::math::float3 hitLocation;
-        collidable->bDoesIntersect(rayCast, hitLocation)) {
-      // If there is an intersection, create a HitResult
-      HitResult hitResult;
-      hitResult.guid_ = entity->GetGlobalGuid();
-      hitResult.name_ = entity->GetName();
-      hitResult.hitPosition_ = hitLocation;  // Set the hit location
+/////////////////////////////////////////////////////////////////////////////////////////
+void CollisionSystem::vUnbatch(EntityObject* entity) {
+  const auto it = m_mapBatchIdByEntity.find(entity);
+  if (it == m_mapBatchIdByEntity.end()) {
+    return;
+  }
 
-      SPDLOG_INFO("HIT RESULT: {}", hitResult.guid_);
+  const uint32_t id = it->second;
+  m_mapBatchIdByEntity.erase(it);
+  if (m_vecBatchEntries[id].eShape != ShapeType::Unset) {
+    vRemoveBatchSlot(m_vecBatchEntries[id]);
+  }
+  m_vecBatchEntries[id] = {};
+  m_vecFreeBatchIds.push_back(id);
+}
 
-      // Add to the hit results
-      hitResults.push_back(hitResult);
+/////////////////////////////////////////////////////////////////////////////////////////
+void CollisionSystem::vRemoveBatchSlot(const BatchEntry& entry) {
+  uint32_t moved = kNoRayBatchId;
+  switch (entry.eShape) {
+    case ShapeType::Sphere:
+      moved = m_oSphereBatch.nRemove(entry.nSlot);
+      break;
+    case ShapeType::Cube:
+      moved = m_oAabbBatch.nRemove(entry.nSlot);
+      break;
+    case ShapeType::Plane:
+      moved = m_oPlaneBatch.nRemove(entry.nSlot);
+      break;
+    default:
+      return;
+  }
+  if (moved != kNoRayBatchId) {
+    m_vecBatchEntries[moved].nSlot = entry.nSlot;
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+std::vector<std::list<HitResult>> CollisionSystem::vecCheckRaysForCollidables(
+    const std::vector<Ray>& rays,
+    const size_t maxHitsPerRay) {
+  std::vector<std::list<HitResult>> results(rays.size());
+  if (m_mapBatchIdByEntity.size() > kMaxBatchScan) {
+    for (size_t i = 0; i < rays.size(); ++i) {
+      vRaycastTree(rays[i], maxHitsPerRay, results[i]);
     }
+    return results;
   }
 
-  // Sort hit results by distance from the ray's origin
-  hitResults.sort([&rayCast](const HitResult& a, const HitResult& b) {
-    // Calculate the squared distance to avoid the cost of sqrt
-    const auto distanceA = fLength2(a.hitPosition_ - rayCast.f3GetPosition());
-    const auto distanceB = fLength2(b.hitPosition_ - rayCast.f3GetPosition());
+  for (size_t i = 0; i < rays.size(); ++i) {
+    const filament::math::float3 origin = rays[i].f3GetPosition();
+    const filament::math::float3 direction = rays[i].f3GetDirection();
 
-    // Sort in ascending order (closest hit first)
-    return distanceA < distanceB;
-  });
+    m_vecBatchHits.clear();
+    RayBatch::vIntersect(origin, direction, m_oSphereBatch, m_vecBatchHits);
+    RayBatch::vIntersect(origin, direction, m_oAabbBatch, m_vecBatchHits);
+    RayBatch::vIntersect(origin, direction, m_oPlaneBatch, m_vecBatchHits);
+    RayBatch::vSortNearestFirst(m_vecBatchHits, maxHitsPerRay);
 
-  // Return the sorted list of hit results
-  return hitResults;
+    for (const auto& [id, t] : m_vecBatchHits) {
+      const EntityObject* entity = m_vecBatchEntries[id].poEntity;
+      HitResult hitResult;
+      hitResult.guid_ = entity->GetGlobalGuid();
+      hitResult.name_ = entity->GetName();
+      hitResult.hitPosition_ = origin + t * direction;
+      results[i].push_back(std::move(hitResult));
+    }
+  }
+
+  return results;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -290,6 +462,42 @@ void CollisionSystem::SendCollisionInformationCallback(
   vSendDataToEventChannel(encodableMap);
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+void CollisionSystem::SendPickInformationCallback(
+    const std::vector<int32_t>& pointerIds,
+    const std::vector<CollisionEventType>& eventTypes,
+    const std::vector<std::list<HitResult>>& hitResults) const {
+  flutter::EncodableMap encodableMap;
+
+  encodableMap[flutter::EncodableValue("event")] =
+      flutter::EncodableValue(kCollisionPickEvent);
+  encodableMap[flutter::EncodableValue(kCollisionPickCount)] =
+      static_cast<int>(pointerIds.size());
+
+  for (size_t i = 0; i < pointerIds.size(); ++i) {
+    flutter::EncodableMap pick;
+    pick[flutter::EncodableValue(kCollisionPickPointerId)] = pointerIds[i];
+    pick[flutter::EncodableValue(kCollisionEventType)] =
+        static_cast<int>(eventTypes[i]);
+    pick[flutter::EncodableValue(kCollisionEventHitCount)] =
+        static_cast<int>(hitResults[i].size());
+
+    int iter = 0;
+    for (const auto& arg : hitResults[i]) {
+      std::ostringstream oss;
+      oss << kCollisionEventHitResult << iter;
+      pick[flutter::EncodableValue(oss.str())] = arg.Encode();
+      ++iter;
+    }
+
+    std::ostringstream oss;
+    oss << kCollisionPickResult << i;
+    encodableMap[flutter::EncodableValue(oss.str())] = pick;
+  }
+
+  vSendDataToEventChannel(encodableMap);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 void CollisionSystem::vInitSystem() {
   vRegisterMessageHandler(
@@ -305,6 +513,33 @@ void CollisionSystem::vInitSystem() {
         SendCollisionInformationCallback(hitList, requestor, type);
       });
 
+  vRegisterMessageHandler(
+      ECSMessageType::PickRequest, [this](const ECSMessage& msg) {
+        const auto rayInfo = msg.getData<Ray>(ECSMessageType::PickRequest);
+        const auto pointerId =
+            msg.getData<int32_t>(ECSMessageType::PickPointerId);
+        const auto type = msg.getData<CollisionEventType>(
+            ECSMessageType::CollisionRequestType);
+
+        const auto existing = m_mapPendingPicks.find(pointerId);
+        if (existing == m_mapPendingPicks.end()) {
+          m_mapPendingPicks.emplace(pointerId, PendingPick{rayInfo, type});
+          return;
+        }
+
+        // Latest ray wins, but a begin or end seen this frame is kept over
+        // held / hover so the caller never misses a press or release.
+        existing->second.ray = rayInfo;
+        const auto eOld = existing->second.eType;
+        const bool bOldIsEdge =
+            eOld == eNativeOnTouchBegin || eOld == eNativeOnTouchEnd;
+        const bool bNewIsEdge =
+            type == eNativeOnTouchBegin || type == eNativeOnTouchEnd;
+        if (bNewIsEdge || !bOldIsEdge) {
+          existing->second.eType = type;
+        }
+      });
+
   vRegisterMessageHandler(
       ECSMessageType::ToggleDebugCollidableViewsInScene,
       [this](const ECSMessage& msg) {
@@ -330,11 +565,10 @@ void CollisionSystem::vInitSystem() {
 
         for (const auto& entity : collidables_) {
           if (entity->GetGlobalGuid() == stringGUID) {
-            const auto collidable = std::dynamic_pointer_cast<Collidable>(
-                entity->GetComponentByStaticTypeID(
-                    Collidable::StaticGetTypeID()));
+            const auto collidable = entity->GetComponent<Collidable>();
 
             collidable->SetEnabled(value);
+            vPatchBatches(entity);
 
             break;
           }
@@ -343,7 +577,30 @@ void CollisionSystem::vInitSystem() {
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-void CollisionSystem::vUpdate(float /*fElapsedTime*/) {}
+void CollisionSystem::vUpdate(float /*fElapsedTime*/) {
+  if (m_mapPendingPicks.empty()) {
+    return;
+  }
+
+  m_vecPickRays.clear();
+  m_vecPickPointerIds.clear();
+  m_vecPickEventTypes.clear();
+  for (const auto& [pointerId, pick] : m_mapPendingPicks) {
+    m_vecPickRays.push_back(pick.ray);
+    m_vecPickPointerIds.push_back(pointerId);
+    m_vecPickEventTypes.push_back(pick.eType);
+  }
+  m_mapPendingPicks.clear();
+
+  const auto hitResults = vecCheckRaysForCollidables(m_vecPickRays);
+  SendPickInformationCallback(m_vecPickPointerIds, m_vecPickEventTypes,
+                              hitResults);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+std::vector<size_t> CollisionSystem::vecGetDependencies() const {
+  return {FilamentSystem::StaticGetTypeID()};
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////
 void CollisionSystem::vShutdownSystem() {}
@@ -19,9 +19,13 @@
 #include <core/components/derived/collidable.h>
 #include <core/entity/derived/shapes/baseshape.h>
 #include <core/include/literals.h>
+#include <core/scene/geometry/aabb_tree.h>
+#include <core/scene/geometry/ray_batch.h>
 #include <core/systems/base/ecsystem.h>
 #include <flutter_desktop_plugin_registrar.h>
 #include <list>
+#include <map>
+#include <unordered_map>
 
 namespace plugin_filament_view {
 
@@ -34,9 +38,8 @@ class HitResult {
   [[nodiscard]] flutter::EncodableValue Encode() const;
 };
 
-// Ideally this is replaced by a physics engine eventually that has a scenegraph
-// or spatial tree structure in place that makes this type of work more
-// efficient.
+// Ideally this is replaced by a physics engine eventually. Until then ray
+// queries go through a dynamic AABB tree over the collidables.
 class CollisionSystem : public ECSystem {
  public:
   CollisionSystem() = default;
@@ -62,16 +65,41 @@ class CollisionSystem : public ECSystem {
     return typeid(CollisionSystem).hash_code();
   }
 
+  [[nodiscard]] std::vector<size_t> vecGetDependencies() const override;
+
   void vAddCollidable(EntityObject* collidable);
   void vRemoveCollidable(EntityObject* collidable);
 
+  // Call after a collidable's entity moved, rotated or scaled; refits it in
+  // the tree and rebuilds its debug drawing.
+  void vUpdateCollidable(EntityObject* collidable);
+
   void setupMessageChannels(flutter::PluginRegistrar* plugin_registrar);
 
-  // send in your ray, get a list of hit results back, collisionLayer not
-  // actively used - future work.
+  // send in your ray, get a list of hit results back sorted nearest first,
+  // collisionLayer not actively used - future work.
   std::list<HitResult> lstCheckForCollidable(Ray& rayCast,
                                              int64_t collisionLayer = 0) const;
 
+  // Tests several rays at once (multi-touch, hover). Small scenes are scanned
+  // with the batched kernels over packed copies of the enabled collidables;
+  // past kMaxBatchScan collidables each ray walks the AABB tree instead,
+  // since a linear scan, even 4 lanes wide, loses to visiting O(log n)
+  // nodes. Returns one hit list per ray, nearest first, truncated to
+  // maxHitsPerRay.
+  std::vector<std::list<HitResult>> vecCheckRaysForCollidables(
+      const std::vector<Ray>& rays,
+      size_t maxHitsPerRay = SIZE_MAX);
+
+  static constexpr size_t kMaxBatchScan = 64;
+
+  // Sends the results of every pick queued this frame as one event, keyed by
+  // pointer id, see kCollisionPickEvent.
+  void SendPickInformationCallback(
+      const std::vector<int32_t>& pointerIds,
+      const std::vector<CollisionEventType>& eventTypes,
+      const std::vector<std::list<HitResult>>& hitResults) const;
+
   // this will send the hit information sent in to non-native (Dart) code.
   void SendCollisionInformationCallback(
       const std::list<HitResult>& lstHitResults,
@@ -88,7 +116,57 @@ class CollisionSystem : public ECSystem {
   void vMatchCollidablesToRenderingModelsTransforms();
   void vMatchCollidablesToDebugDrawingTransforms();
 
+  // Creates the wireframe shape for a collidable, matching the collidable to
+  // its model or shape on the way. Returns false if the type is unsupported.
+  bool bBuildDebugRepresentation(EntityObject* collidable);
+  void vDestroyDebugRepresentation(const EntityGUID& guid);
+
   std::list<EntityObject*> collidables_;
+
+  AabbTree m_oTree;
+  std::unordered_map<EntityObject*, int32_t> m_mapLeafByEntity;
+
+  // SoA copies of the enabled collidables for vecCheckRaysForCollidables.
+  // Patched per entity on add, update, toggle and remove; batch ids index
+  // m_vecBatchEntries.
+  struct BatchEntry {
+    EntityObject* poEntity = nullptr;
+    ShapeType eShape = ShapeType::Unset;
+    uint32_t nSlot = 0;
+  };
+
+  // Puts the entity's current collidable into its batch, overwriting its
+  // slot in place when the shape type didn't change.
+  void vPatchBatches(EntityObject* entity);
+  // Drops the entity from its batch, if it's in one.
+  void vUnbatch(EntityObject* entity);
+  // Swap-removes entry's slot from its batch and fixes up the moved slot.
+  void vRemoveBatchSlot(const BatchEntry& entry);
+
+  // Tree walk for one ray, keeping at most maxHits nearest hits.
+  void vRaycastTree(const Ray& ray,
+                    size_t maxHits,
+                    std::list<HitResult>& hitResults) const;
+
+  SphereBatch m_oSphereBatch;
+  AabbBatch m_oAabbBatch;
+  PlaneBatch m_oPlaneBatch;
+  std::vector<BatchEntry> m_vecBatchEntries;
+  std::vector<uint32_t> m_vecFreeBatchIds;
+  std::unordered_map<EntityObject*, uint32_t> m_mapBatchIdByEntity;
+  std::vector<RayBatchHit> m_vecBatchHits;
+
+  // PickRequest messages collected between frames, latest ray per pointer.
+  // Resolved together in vUpdate.
+  struct PendingPick {
+    Ray ray;
+    CollisionEventType eType;
+  };
+  std::map<int32_t, PendingPick> m_mapPendingPicks;
+  std::vector<Ray> m_vecPickRays;
+  std::vector<int32_t> m_vecPickPointerIds;
+  std::vector<CollisionEventType> m_vecPickEventTypes;
+
   std::map<EntityGUID, shapes::BaseShape*>
       collidablesDebugDrawingRepresentation_;
 };
@@ -109,7 +109,7 @@ void DebugLinesSystem::DebugPrint() {
 void DebugLinesSystem::vCleanup() {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "DebugLinesSystem::vCleanup");
+          "DebugLinesSystem::vCleanup");
   const auto engine = filamentSystem->getFilamentEngine();
 
   for (auto it = ourLines_.begin(); it != ourLines_.end();) {
@@ -127,7 +127,7 @@ void DebugLinesSystem::vCleanup() {
 void DebugLinesSystem::vUpdate(const float fElapsedTime) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "DebugLinesSystem::vUpdate");
+          "DebugLinesSystem::vUpdate");
   const auto engine = filamentSystem->getFilamentEngine();
 
   for (auto it = ourLines_.begin(); it != ourLines_.end();) {
@@ -159,6 +159,11 @@ void DebugLinesSystem::vInitSystem() {
       });
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+std::vector<size_t> DebugLinesSystem::vecGetDependencies() const {
+  return {FilamentSystem::StaticGetTypeID()};
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 void DebugLinesSystem::vShutdownSystem() {
   vCleanup();
@@ -174,7 +179,7 @@ void DebugLinesSystem::vAddLine(filament::math::float3 startPoint,
 
   auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "DebugLinesSystem::vAddLine");
+          "DebugLinesSystem::vAddLine");
   const auto engine = filamentSystem->getFilamentEngine();
 
   utils::EntityManager& oEntitymanager = engine->getEntityManager();
@@ -78,6 +78,8 @@ class DebugLinesSystem final : public ECSystem {
     return typeid(DebugLinesSystem).hash_code();
   }
 
+  [[nodiscard]] std::vector<size_t> vecGetDependencies() const override;
+
  private:
   bool m_bCurrentlyDrawingDebugLines = false;
 
@@ -42,6 +42,9 @@ void FilamentSystem::vInitSystem() {
   );*/
 
   fengine_ = filament::Engine::create(filament::Engine::Backend::VULKAN);
+  // Renderables sharing geometry and material, such as the instances of one
+  // glTF model, are merged into instanced draws.
+  fengine_->setAutomaticInstancingEnabled(true);
   iblProfiler_ = std::make_unique<IBLProfiler>(fengine_);
   frenderer_ = fengine_->createRenderer();
   fscene_ = fengine_->createScene();
@@ -69,6 +69,8 @@ class IndirectLightSystem : public ECSystem {
     return typeid(IndirectLightSystem).hash_code();
   }
 
+  [[nodiscard]] std::vector<size_t> vecGetDependencies() const override;
+
   void vInitSystem() override;
   void vUpdate(float fElapsedTime) override;
   void vShutdownSystem() override;
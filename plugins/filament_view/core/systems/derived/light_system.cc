@@ -63,7 +63,7 @@ void LightSystem::vBuildLightAndAddToScene(Light& light) {
 void LightSystem::vBuildLight(Light& light) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "vBuildLight");
+          "vBuildLight");
   const auto engine = filamentSystem->getFilamentEngine();
 
   if (light.m_poFilamentEntityLight == nullptr) {
@@ -114,7 +114,6 @@ void LightSystem::vBuildLight(Light& light) {
 void LightSystem::vRemoveLightFromScene(const Light& light) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(),
           "lightManager::vRemoveLightFromScene");
 
   const auto scene = filamentSystem->getFilamentScene();
@@ -126,7 +125,7 @@ void LightSystem::vRemoveLightFromScene(const Light& light) {
 void LightSystem::vAddLightToScene(const Light& light) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "lightManager::vAddLightToScene");
+          "lightManager::vAddLightToScene");
 
   const auto scene = filamentSystem->getFilamentScene();
 
@@ -152,10 +151,7 @@ void LightSystem::vInitSystem() {
         // find the entity in our list:
         if (const auto ourEntity = m_mapGuidToEntity.find(guid);
             ourEntity != m_mapGuidToEntity.end()) {
-          const auto theLight = dynamic_cast<Light*>(
-              ourEntity->second
-                  ->GetComponentByStaticTypeID(Light::StaticGetTypeID())
-                  .get());
+          const auto theLight = ourEntity->second->poGetComponent<Light>();
           theLight->SetIntensity(intensityValue);
           theLight->SetColor(colorValue);
 
@@ -180,10 +176,7 @@ void LightSystem::vInitSystem() {
         // find the entity in our list:
         if (auto ourEntity = m_mapGuidToEntity.find(guid);
             ourEntity != m_mapGuidToEntity.end()) {
-          auto theLight = dynamic_cast<Light*>(
-              ourEntity->second
-                  ->GetComponentByStaticTypeID(Light::StaticGetTypeID())
-                  .get());
+          auto theLight = ourEntity->second->poGetComponent<Light>();
           theLight->SetPosition(position);
           theLight->SetDirection(rotation);
 
@@ -198,12 +191,15 @@ void LightSystem::vInitSystem() {
 ////////////////////////////////////////////////////////////////////////////////////
 void LightSystem::vUpdate(float /*fElapsedTime*/) {}
 
+////////////////////////////////////////////////////////////////////////////////////
+std::vector<size_t> LightSystem::vecGetDependencies() const {
+  return {FilamentSystem::StaticGetTypeID()};
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 void LightSystem::vShutdownSystem() {
   if (m_poDefaultLight != nullptr) {
-    const auto component = dynamic_cast<Light*>(
-        m_poDefaultLight->GetComponentByStaticTypeID(Light::StaticGetTypeID())
-            .get());
+    const auto component = m_poDefaultLight->poGetComponent<Light>();
     vRemoveLightFromScene(*component);
 
     m_poDefaultLight.reset();
@@ -48,6 +48,8 @@ class LightSystem : public ECSystem {
     return typeid(LightSystem).hash_code();
   }
 
+  [[nodiscard]] std::vector<size_t> vecGetDependencies() const override;
+
   void vInitSystem() override;
   void vUpdate(float fElapsedTime) override;
   void vShutdownSystem() override;
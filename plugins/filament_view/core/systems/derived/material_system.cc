@@ -21,7 +21,10 @@
 #include <core/entity/base/entityobject.h>
 #include <core/entity/derived/renderable_entityobject.h>
 #include <core/systems/ecsystems_manager.h>
+#include <core/utils/asset_cache.h>
 #include <plugins/common/common.h>
+#include <algorithm>
+#include <asio/post.hpp>
 
 #include "entityobject_locator_system.h"
 
@@ -52,15 +55,67 @@ Resource<filament::Material*> MaterialSystem::loadMaterialFromResource(
         materialDefinition->szGetMaterialAssetPath());
   }
 
-  if (!materialDefinition->szGetMaterialURLPath().empty()) {
-    return MaterialLoader::loadMaterialFromUrl(
-        materialDefinition->szGetMaterialURLPath());
+  if (const auto url = materialDefinition->szGetMaterialURLPath();
+      !url.empty()) {
+    // Never download here, this runs on the strand.
+    const auto fetched = fetchedUrlMaterials_.find(url);
+    if (fetched == fetchedUrlMaterials_.end()) {
+      spdlog::error("Material {} wasn't fetched before use", url);
+      return Resource<filament::Material*>::Error(
+          "Material was not fetched: " + url);
+    }
+    const auto buffer = std::move(fetched->second);
+    fetchedUrlMaterials_.erase(fetched);
+    return MaterialLoader::loadMaterialFromUrl(url, *buffer);
   }
 
   return Resource<filament::Material*>::Error(
       "You must provide material asset path or url");
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+void MaterialSystem::vFetchUrlMaterials(
+    const std::vector<std::string>& materialUrls,
+    std::function<void()> fnOnReady) {
+  std::vector<std::string> toFetch;
+  {
+    std::lock_guard lock(loadingMaterialsMutex_);
+    for (const auto& url : materialUrls) {
+      if (url.empty() || loadedTemplateMaterials_.count(url) != 0 ||
+          fetchedUrlMaterials_.count(url) != 0 ||
+          std::find(toFetch.begin(), toFetch.end(), url) != toFetch.end()) {
+        continue;
+      }
+      toFetch.push_back(url);
+    }
+  }
+
+  if (toFetch.empty()) {
+    fnOnReady();
+    return;
+  }
+
+  // Both only touched on the strand.
+  auto remaining = std::make_shared<size_t>(toFetch.size());
+  auto onReady = std::make_shared<std::function<void()>>(std::move(fnOnReady));
+  for (auto& url : toFetch) {
+    post(ECSystemManager::GetInstance()->GetAssetIOPool(),
+         [this, url = std::move(url), remaining, onReady]() mutable {
+           auto buffer = std::make_shared<AssetBuffer>(
+               AssetCache::GetInstance().Fetch(url));
+           post(*ECSystemManager::GetInstance()->GetStrand(),
+                [this, url = std::move(url), buffer = std::move(buffer),
+                 remaining, onReady] {
+                  // Kept even when empty, so the load reports the failure.
+                  fetchedUrlMaterials_[url] = buffer;
+                  if (--*remaining == 0) {
+                    (*onReady)();
+                  }
+                });
+         });
+  }
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 Resource<filament::MaterialInstance*> MaterialSystem::setupMaterialInstance(
     const filament::Material* materialResult,
@@ -184,7 +239,6 @@ void MaterialSystem::vInitSystem() {
         const auto objectLocatorSystem =
             ECSystemManager::GetInstance()
                 ->poGetSystemAs<EntityObjectLocatorSystem>(
-                    EntityObjectLocatorSystem::StaticGetTypeID(),
                     "ChangeMaterialParameter");
 
         if (const auto entityObject =
@@ -214,33 +268,49 @@ void MaterialSystem::vInitSystem() {
         const EntityGUID& guid =
             msg.getData<EntityGUID>(ECSMessageType::EntityToTarget);
 
-        const auto objectLocatorSystem =
-            ECSystemManager::GetInstance()
-                ->poGetSystemAs<EntityObjectLocatorSystem>(
-                    EntityObjectLocatorSystem::StaticGetTypeID(),
-                    "ChangeMaterialDefinitions");
-
-        if (const auto entityObject =
-                objectLocatorSystem->poGetEntityObjectById(guid);
-            entityObject != nullptr) {
-          spdlog::debug("ChangeMaterialDefinitions valid entity found.");
-
-          const auto renderable =
-              dynamic_cast<RenderableEntityObject*>(entityObject.get());
-          renderable->vChangeMaterialDefinitions(params, loadedTextures_);
+        std::vector<std::string> materialUrls;
+        if (const auto url = params.find(flutter::EncodableValue("url"));
+            url != params.end() &&
+            std::holds_alternative<std::string>(url->second)) {
+          materialUrls.push_back(std::get<std::string>(url->second));
         }
 
-        spdlog::debug("ChangeMaterialDefinitions Complete");
+        // A new URL material is downloaded first; the change is applied
+        // once it's in.
+        vFetchUrlMaterials(materialUrls, [this, params, guid] {
+          const auto objectLocatorSystem =
+              ECSystemManager::GetInstance()
+                  ->poGetSystemAs<EntityObjectLocatorSystem>(
+                      "ChangeMaterialDefinitions");
+
+          if (const auto entityObject =
+                  objectLocatorSystem->poGetEntityObjectById(guid);
+              entityObject != nullptr) {
+            spdlog::debug("ChangeMaterialDefinitions valid entity found.");
+
+            const auto renderable =
+                dynamic_cast<RenderableEntityObject*>(entityObject.get());
+            renderable->vChangeMaterialDefinitions(params, loadedTextures_);
+          }
+
+          spdlog::debug("ChangeMaterialDefinitions Complete");
+        });
       });
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 void MaterialSystem::vUpdate(float /*fElapsedTime*/) {}
+/////////////////////////////////////////////////////////////////////////////////////////
+std::vector<size_t> MaterialSystem::vecGetDependencies() const {
+  return {FilamentSystem::StaticGetTypeID(),
+          EntityObjectLocatorSystem::StaticGetTypeID()};
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 void MaterialSystem::vShutdownSystem() {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "CameraManager::setDefaultCamera");
+          "CameraManager::setDefaultCamera");
   const auto engine = filamentSystem->getFilamentEngine();
 
   for (const auto& [fst, snd] : loadedTemplateMaterials_) {
@@ -253,6 +323,7 @@ void MaterialSystem::vShutdownSystem() {
 
   loadedTemplateMaterials_.clear();
   loadedTextures_.clear();
+  fetchedUrlMaterials_.clear();
 
   materialLoader_.reset();
   textureLoader_.reset();
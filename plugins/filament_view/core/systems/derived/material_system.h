@@ -19,10 +19,13 @@
 #include <core/scene/material/loader/material_loader.h>
 #include <core/scene/material/loader/texture_loader.h>
 #include <core/systems/base/ecsystem.h>
+#include <core/utils/asset_buffer.h>
 #include <filament/MaterialInstance.h>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace plugin_filament_view {
 
@@ -40,6 +43,14 @@ class MaterialSystem : public ECSystem {
   Resource<::filament::MaterialInstance*> getMaterialInstance(
       const MaterialDefinitions* materialDefinitions);
 
+  // URL materials are downloaded on the asset I/O pool ahead of
+  // getMaterialInstance, which only builds them. Fetches those of
+  // materialUrls that aren't loaded yet and calls fnOnReady on the strand
+  // once they are all in; right away if there is nothing to fetch. Call on
+  // the Filament strand.
+  void vFetchUrlMaterials(const std::vector<std::string>& materialUrls,
+                          std::function<void()> fnOnReady);
+
   // Disallow copy and assign.
   MaterialSystem(const MaterialSystem&) = delete;
   MaterialSystem& operator=(const MaterialSystem&) = delete;
@@ -55,11 +66,13 @@ class MaterialSystem : public ECSystem {
     return typeid(MaterialSystem).hash_code();
   }
 
+  [[nodiscard]] std::vector<size_t> vecGetDependencies() const override;
+
  private:
   std::unique_ptr<plugin_filament_view::MaterialLoader> materialLoader_;
   std::unique_ptr<plugin_filament_view::TextureLoader> textureLoader_;
 
-  static Resource<::filament::Material*> loadMaterialFromResource(
+  Resource<::filament::Material*> loadMaterialFromResource(
       const MaterialDefinitions* materialDefinition);
   Resource<::filament::MaterialInstance*> setupMaterialInstance(
       const ::filament::Material* materialResult,
@@ -72,6 +85,10 @@ class MaterialSystem : public ECSystem {
       loadedTemplateMaterials_;
   std::mutex loadingMaterialsMutex_;
 
+  // Bytes of URL materials fetched by vFetchUrlMaterials, waiting to be
+  // built by loadMaterialFromResource. Only touched on the strand.
+  std::map<std::string, std::shared_ptr<AssetBuffer>> fetchedUrlMaterials_;
+
   // This map is a list of all loaded textures. Multiple materials might
   // reference the same texture, and instead of loading them separately; they'll
   // be reused here. As of writing 202409 Textures are tied to materials, so it
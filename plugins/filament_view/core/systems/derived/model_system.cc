@@ -20,8 +20,8 @@
 #include <core/components/derived/collidable.h>
 #include <core/include/file_utils.h>
 #include <core/systems/ecsystems_manager.h>
+#include <core/utils/asset_cache.h>
 #include <core/utils/entitytransforms.h>
-#include <curl_client/curl_client.h>
 #include <filament/Scene.h>
 #include <filament/filament/RenderableManager.h>
 #include <filament/gltfio/ResourceLoader.h>
@@ -32,6 +32,7 @@
 #include <asio/post.hpp>
 
 #include "animation_system.h"
+#include "view_target_system.h"
 
 namespace plugin_filament_view {
 
@@ -42,6 +43,10 @@ using filament::gltfio::ResourceLoader;
 
 ////////////////////////////////////////////////////////////////////////////////////
 void ModelSystem::destroyAllAssetsOnModels() {
+  m_vecAssetsStillLoading.clear();
+  m_mapInstanceSlots.clear();
+  m_mapInstancedAssetGroups.clear();
+  m_bInstanceTransformsDirty = false;
   for (const auto& [fst, snd] : m_mapszoAssets) {
     destroyAsset(snd->getAsset());  // NOLINT
   }
@@ -57,7 +62,7 @@ void ModelSystem::destroyAsset(
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), __FUNCTION__);
+          __FUNCTION__);
 
   filamentSystem->getFilamentScene()->removeEntities(asset->getEntities(),
                                                      asset->getEntityCount());
@@ -77,7 +82,7 @@ filament::gltfio::FilamentAsset* ModelSystem::poFindAssetByGuid(
 
 ////////////////////////////////////////////////////////////////////////////////////
 void ModelSystem::loadModelGlb(std::shared_ptr<Model> oOurModel,
-                               const std::vector<uint8_t>& buffer,
+                               const AssetBuffer& buffer,
                                const std::string& /*assetName*/) {
   if (assetLoader_ == nullptr) {
     // NOTE, this should only be temporary until CustomModelViewer isn't
@@ -92,21 +97,24 @@ void ModelSystem::loadModelGlb(std::shared_ptr<Model> oOurModel,
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "loadModelGlb");
+          "loadModelGlb");
   const auto engine = filamentSystem->getFilamentEngine();
   auto& rcm = engine->getRenderableManager();
 
-  // Note if you're creating a lot of instances, this is better to use at the
-  // start FilamentAsset* createInstancedAsset(const uint8_t* bytes, uint32_t
-  // numBytes, FilamentInstance **instances, size_t numInstances)
   filament::gltfio::FilamentAsset* asset = nullptr;
   filament::gltfio::FilamentInstance* assetInstance = nullptr;
 
   const auto instancedModelData =
       m_mapInstanceableAssets_.find(oOurModel->szGetAssetPath());
   if (instancedModelData != m_mapInstanceableAssets_.end()) {
-    // we have the model already, use it.
-    assetInstance = assetLoader_->createInstance(instancedModelData->second);
+    // we have the model already, use one of its instances.
+    auto& group = m_mapInstancedAssetGroups[oOurModel->szGetAssetPath()];
+    assetInstance = poClaimInstance(group, instancedModelData->second);
+    if (assetInstance == nullptr) {
+      spdlog::error("Failed to create instance of {}",
+                    oOurModel->szGetAssetPath());
+      return;
+    }
 
     const Entity* instanceEntities = assetInstance->getEntities();
     const size_t instanceEntityCount = assetInstance->getEntityCount();
@@ -130,12 +138,48 @@ void ModelSystem::loadModelGlb(std::shared_ptr<Model> oOurModel,
 
     filamentSystem->getFilamentScene()->addEntity(assetInstance->getRoot());
     oOurModel->setAssetInstance(assetInstance);
+
+    m_mapInstanceSlots[oOurModel->GetGlobalGuid()] = {
+        &group, static_cast<uint32_t>(group.vecRoots.size())};
+    group.vecRoots.push_back(assetInstance->getRoot());
+    group.vecTransforms.emplace_back();
   }
 
   // instance-able / primary object.
-  if (assetInstance == nullptr) {
+  if (assetInstance == nullptr && oOurModel->bShouldKeepAssetDataInMemory()) {
+    // Create every instance we know of now, sharing one parse and one set of
+    // GPU resources; later models of this path claim them.
+    const auto awaiting =
+        m_mapszoAssetsAwaitingDataLoad.find(oOurModel->szGetAssetPath());
+    const size_t instanceCount = std::max(
+        {size_t{1},
+         static_cast<size_t>(
+             std::max(oOurModel->nGetExpectedInstanceCount(), 0)),
+         1 + (awaiting != m_mapszoAssetsAwaitingDataLoad.end()
+                  ? awaiting->second.size()
+                  : 0)});
+
+    std::vector<filament::gltfio::FilamentInstance*> instances(instanceCount);
+    asset = assetLoader_->createInstancedAsset(
+        buffer.data(), static_cast<uint32_t>(buffer.size()), instances.data(),
+        instanceCount);
+
+    if (asset) {
+      auto& group = m_mapInstancedAssetGroups[oOurModel->szGetAssetPath()];
+      // The first instance is the asset's own, used by this model.
+      for (size_t i = 1; i < instanceCount; ++i) {
+        group.vecSpareInstances.push_back(instances[i]);
+        group.setSpareEntities.insert(
+            instances[i]->getEntities(),
+            instances[i]->getEntities() + instances[i]->getEntityCount());
+      }
+    }
+  } else if (assetInstance == nullptr) {
     asset = assetLoader_->createAsset(buffer.data(),
                                       static_cast<uint32_t>(buffer.size()));
+  }
+
+  if (assetInstance == nullptr) {
     if (!asset) {
       spdlog::error("Failed to loadModelGlb->createasset from buffered data.");
       return;
@@ -167,9 +211,9 @@ void ModelSystem::loadModelGlb(std::shared_ptr<Model> oOurModel,
     oOurModel->setAsset(asset);
   }
 
-  EntityTransforms::vApplyTransform(oOurModel, *oOurModel->GetBaseTransform());
-
   std::shared_ptr<Model> sharedPtr = std::move(oOurModel);
+  vApplyModelTransform(sharedPtr, *sharedPtr->GetBaseTransform());
+
   vSetupAssetThroughoutECS(sharedPtr, asset, assetInstance);
 }
 
@@ -207,7 +251,7 @@ void ModelSystem::loadModelGltf(
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "loadModelGltf");
+          "loadModelGltf");
   const auto engine = filamentSystem->getFilamentEngine();
 
   auto& rcm = engine->getRenderableManager();
@@ -235,12 +279,70 @@ void ModelSystem::loadModelGltf(
   vSetupAssetThroughoutECS(sharedPtr, asset, nullptr);
 }
 
+////////////////////////////////////////////////////////////////////////////////////
+filament::gltfio::FilamentInstance* ModelSystem::poClaimInstance(
+    InstancedAssetGroup& group,
+    filament::gltfio::FilamentAsset* asset) const {
+  if (group.vecSpareInstances.empty()) {
+    // More models than expected; grow the asset one instance at a time.
+    return assetLoader_->createInstance(asset);
+  }
+
+  auto* instance = group.vecSpareInstances.back();
+  group.vecSpareInstances.pop_back();
+  for (size_t i = 0; i < instance->getEntityCount(); ++i) {
+    group.setSpareEntities.erase(instance->getEntities()[i]);
+  }
+  return instance;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void ModelSystem::vApplyModelTransform(const std::shared_ptr<Model>& model,
+                                       const BaseTransform& transform) {
+  const auto slot = m_mapInstanceSlots.find(model->GetGlobalGuid());
+  if (slot == m_mapInstanceSlots.end()) {
+    EntityTransforms::vApplyTransform(model, transform);
+    return;
+  }
+
+  auto& [poGroup, nSlot] = slot->second;
+  poGroup->vecTransforms[nSlot] =
+      EntityTransforms::oCalculateTransform(transform);
+  poGroup->vecDirtySlots.push_back(nSlot);
+  m_bInstanceTransformsDirty = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void ModelSystem::vFlushInstanceTransforms() {
+  if (!m_bInstanceTransformsDirty) {
+    return;
+  }
+  m_bInstanceTransformsDirty = false;
+
+  const auto filamentSystem =
+      ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
+          __FUNCTION__);
+  auto& tm = filamentSystem->getFilamentEngine()->getTransformManager();
+
+  // World transforms are recomputed once at commit rather than per set.
+  tm.openLocalTransformTransaction();
+  for (auto& [szAssetPath, group] : m_mapInstancedAssetGroups) {
+    for (const uint32_t nSlot : group.vecDirtySlots) {
+      tm.setTransform(tm.getInstance(group.vecRoots[nSlot]),
+                      group.vecTransforms[nSlot]);
+    }
+    group.vecDirtySlots.clear();
+  }
+  tm.commitLocalTransformTransaction();
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 void ModelSystem::vSetupAssetThroughoutECS(
     std::shared_ptr<Model>& sharedPtr,
     filament::gltfio::FilamentAsset* filamentAsset,
     filament::gltfio::FilamentInstance* filamentAssetInstance) {
   m_mapszoAssets.insert(std::pair(sharedPtr->GetGlobalGuid(), sharedPtr));
+  m_vecAssetsStillLoading.push_back(sharedPtr);
 
   filament::gltfio::Animator* animatorInstance = nullptr;
 
@@ -252,9 +354,7 @@ void ModelSystem::vSetupAssetThroughoutECS(
 
   if (animatorInstance != nullptr &&
       sharedPtr->HasComponentByStaticTypeID(Animation::StaticGetTypeID())) {
-    const auto animatorComponent =
-        sharedPtr->GetComponentByStaticTypeID(Animation::StaticGetTypeID());
-    const auto animator = dynamic_cast<Animation*>(animatorComponent.get());
+    const auto animator = sharedPtr->poGetComponent<Animation>();
     animator->vSetAnimator(*animatorInstance);
 
     // Great if you need help with your animation information!
@@ -273,39 +373,45 @@ void ModelSystem::vSetupAssetThroughoutECS(
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
-void ModelSystem::populateSceneWithAsyncLoadedAssets(const Model* model) {
+bool ModelSystem::populateSceneWithAsyncLoadedAssets(
+    const Model* model,
+    const std::chrono::steady_clock::time_point deadline) {
+  auto* asset = model->getAsset();
+
+  if (!asset) {
+    return true;
+  }
+
+  size_t count = asset->popRenderables(nullptr, 0);
+  if (count == 0) {
+    return true;
+  }
+
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), __FUNCTION__);
+          __FUNCTION__);
   const auto engine = filamentSystem->getFilamentEngine();
 
   auto& rcm = engine->getRenderableManager();
 
-  auto* asset = model->getAsset();
+  const auto groupIter =
+      m_mapInstancedAssetGroups.find(model->szGetAssetPath());
+  const InstancedAssetGroup* group =
+      groupIter != m_mapInstancedAssetGroups.end() ? &groupIter->second
+                                                   : nullptr;
 
-  if (!asset) {
-    return;
-  }
-
-  size_t count = asset->popRenderables(nullptr, 0);
-  while (count) {
-    constexpr size_t maxToPopAtOnce = 128;
-    auto maxToPop = std::min(count, maxToPopAtOnce);
+  // Always do one batch, so a busy frame still makes progress.
+  do {
+    const size_t popped =
+        asset->popRenderables(readyRenderables_, kRenderablesPerPop);
 
     SPDLOG_DEBUG(
         "ModelSystem::populateSceneWithAsyncLoadedAssets async load count "
         "available[{}] - working on [{}]",
-        count, maxToPop);
-    // Note for high amounts, we should probably do a small amount; break out;
-    // and let it come back do more on another frame.
-
-    asset->popRenderables(readyRenderables_, maxToPop);
-
-    utils::Slice const listOfRenderables{asset->getRenderableEntities(),
-                                         asset->getRenderableEntityCount()};
+        count, popped);
 
-    for (const auto entity : listOfRenderables) {
-      const auto ri = rcm.getInstance(entity);
+    for (size_t i = 0; i < popped; ++i) {
+      const auto ri = rcm.getInstance(readyRenderables_[i]);
       rcm.setCastShadows(ri,
                          model->GetCommonRenderable()->IsCastShadowsEnabled());
       rcm.setReceiveShadows(
@@ -315,88 +421,181 @@ void ModelSystem::populateSceneWithAsyncLoadedAssets(const Model* model) {
       rcm.setScreenSpaceContactShadows(ri, false);
     }
 
+    // Instances nobody has claimed yet stay out of the scene.
+    size_t toAdd = popped;
+    if (group != nullptr && !group->setSpareEntities.empty()) {
+      toAdd = static_cast<size_t>(
+          std::remove_if(readyRenderables_, readyRenderables_ + popped,
+                         [group](const utils::Entity entity) {
+                           return group->setSpareEntities.count(entity) != 0;
+                         }) -
+          readyRenderables_);
+    }
+
     // we won't load the primary asset to render.
     if (!model->bIsPrimaryAssetToInstanceFrom()) {
       filamentSystem->getFilamentScene()->addEntities(readyRenderables_,
-                                                      maxToPop);
+                                                      toAdd);
     }
 
     count = asset->popRenderables(nullptr, 0);
+  } while (count && std::chrono::steady_clock::now() < deadline);
+
+  return count == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void ModelSystem::vSortAssetsStillLoadingByCameraDistance() {
+  if (m_vecAssetsStillLoading.size() < 2) {
+    return;
+  }
+
+  const auto viewTargetSystem =
+      ECSystemManager::GetInstance()->poGetSystemAs<ViewTargetSystem>(
+          __FUNCTION__);
+  if (viewTargetSystem == nullptr) {
+    return;
+  }
+  const auto eye = viewTargetSystem->f3GetCameraPosition(0);
+
+  m_vecLoadOrder.clear();
+  for (auto& model : m_vecAssetsStillLoading) {
+    const auto offset = model->GetBaseTransform()->GetCenterPosition() - eye;
+    m_vecLoadOrder.emplace_back(dot(offset, offset), std::move(model));
   }
+  std::stable_sort(
+      m_vecLoadOrder.begin(), m_vecLoadOrder.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
 
-  if ([[maybe_unused]] auto lightEntities = asset->getLightEntities()) {
+  for (size_t i = 0; i < m_vecLoadOrder.size(); ++i) {
+    m_vecAssetsStillLoading[i] = std::move(m_vecLoadOrder[i].second);
+  }
+  m_vecLoadOrder.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void ModelSystem::vOnAssetFinishedLoading(
+    const std::shared_ptr<Model>& model) {
+  // we're no longer loading, we're loaded.
+  if (model->bShouldKeepAssetDataInMemory()) {
+    m_mapszbCurrentlyLoadingInstanceableAssets.erase(model->szGetAssetPath());
+  }
+
+  if (const auto* asset = model->getAsset();
+      asset != nullptr && asset->getLightEntityCount() > 0) {
     spdlog::info(
         "Note: Light entities have come in from asset model load;"
         "these are not attached to our entities and will be un changeable");
-    filamentSystem->getFilamentScene()->addEntities(asset->getLightEntities(),
-                                                    sizeof(*lightEntities));
+    const auto filamentSystem =
+        ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
+            __FUNCTION__);
+    filamentSystem->getFilamentScene()->addEntities(
+        asset->getLightEntities(), asset->getLightEntityCount());
   }
-}
 
-////////////////////////////////////////////////////////////////////////////////////
-void ModelSystem::updateAsyncAssetLoading() {
-  resourceLoader_->asyncUpdateLoad();
+  // You don't get collision as a primary asset.
+  if (model->bIsPrimaryAssetToInstanceFrom()) {
+    return;
+  }
 
-  // This does not specify per resource, but a global, best we can do with this
-  // information is if we're done loading <everything> that was marked as async
-  // load, then load that physics data onto a collidable if required. This gives
-  // us visuals without collidables in a scene with <tons> of objects; but would
-  // eventually settle
-  const float percentComplete = resourceLoader_->asyncGetLoadProgress();
+  auto collisionSystem =
+      ECSystemManager::GetInstance()->poGetSystemAs<CollisionSystem>(
+          "updateAsyncAssetLoading");
+  if (collisionSystem == nullptr) {
+    spdlog::warn("Failed to get collision system when loading model");
+    return;
+  }
 
-  for (const auto& [fst, snd] : m_mapszoAssets) {
-    populateSceneWithAsyncLoadedAssets(snd.get());
+  // if its 'done' loading, we need to create our large AABB collision
+  // object if this model it's referencing required one.
+  //
+  // Also need to make sure it hasn't already created one for this model.
+  if (model->HasComponentByStaticTypeID(Collidable::StaticGetTypeID()) &&
+      !collisionSystem->bHasEntityObjectRepresentation(
+          model->GetGlobalGuid())) {
+    // I don't think this needs to become a message; as an async load
+    // gives us un-deterministic throughput; it can't be replicated with a
+    // messaging structure, and we have to wait till the load is done.
+    collisionSystem->vAddCollidable(model.get());
+  }
+}
 
-    if (percentComplete != 1.0f) {
+////////////////////////////////////////////////////////////////////////////////////
+void ModelSystem::vLoadAwaitingInstances() {
+  // once we're done loading our assets; we should be able to load instanced
+  // models.
+  for (auto iter = m_mapszoAssetsAwaitingDataLoad.begin();
+       iter != m_mapszoAssetsAwaitingDataLoad.end();) {
+    const auto& szAssetPath = iter->first;
+    if (m_mapszbCurrentlyLoadingInstanceableAssets.count(szAssetPath) != 0 ||
+        m_mapInstanceableAssets_.count(szAssetPath) == 0) {
+      ++iter;
       continue;
     }
 
-    // we're no longer loading, we're loaded.
-    m_mapszbCurrentlyLoadingInstanceableAssets.erase(fst);
-
-    // once we're done loading our assets; we should be able to load instanced
-    // models.
-    if (auto foundAwaitingIter =
-            m_mapszoAssetsAwaitingDataLoad.find(snd->szGetAssetPath());
-        snd->bShouldKeepAssetDataInMemory() &&
-        foundAwaitingIter != m_mapszoAssetsAwaitingDataLoad.end()) {
-      spdlog::info("Loading additional instanced assets: {}",
-                   snd->szGetAssetPath());
-      for (const auto& itemToLoad : foundAwaitingIter->second) {
-        spdlog::info("Loading subset: {}", snd->szGetAssetPath());
-        std::vector<uint8_t> emptyVec;
-        loadModelGlb(itemToLoad, emptyVec, itemToLoad->szGetAssetPath());
-      }
-      spdlog::info("Done Loading additional instanced assets: {}",
-                   snd->szGetAssetPath());
-      m_mapszoAssetsAwaitingDataLoad.erase(snd->szGetAssetPath());
+    spdlog::info("Loading additional instanced assets: {}", szAssetPath);
+    const auto modelsToLoad = std::move(iter->second);
+    iter = m_mapszoAssetsAwaitingDataLoad.erase(iter);
+    for (const auto& itemToLoad : modelsToLoad) {
+      loadModelGlb(itemToLoad, AssetBuffer(), itemToLoad->szGetAssetPath());
     }
+  }
+}
 
-    // You don't get collision as a primary asset.
-    if (snd->bIsPrimaryAssetToInstanceFrom()) {
-      continue;
-    }
+////////////////////////////////////////////////////////////////////////////////////
+void ModelSystem::vOnAssetFailedLoading(const std::shared_ptr<Model>& model) {
+  if (model == nullptr || !model->bShouldKeepAssetDataInMemory()) {
+    return;
+  }
 
-    auto collisionSystem =
-        ECSystemManager::GetInstance()->poGetSystemAs<CollisionSystem>(
-            CollisionSystem::StaticGetTypeID(), "updateAsyncAssetLoading");
-    if (collisionSystem == nullptr) {
-      spdlog::warn("Failed to get collision system when loading model");
-      continue;
-    }
+  const auto szAssetPath = model->szGetAssetPath();
+  m_mapszbCurrentlyLoadingInstanceableAssets.erase(szAssetPath);
+  if (const auto iter = m_mapszoAssetsAwaitingDataLoad.find(szAssetPath);
+      iter != m_mapszoAssetsAwaitingDataLoad.end()) {
+    spdlog::error("Dropping {} instances of {}, their asset failed to load",
+                  iter->second.size(), szAssetPath);
+    m_mapszoAssetsAwaitingDataLoad.erase(iter);
+  }
+}
 
-    // if its 'done' loading, we need to create our large AABB collision
-    // object if this model it's referencing required one.
-    //
-    // Also need to make sure it hasn't already created one for this model.
-    if (snd->HasComponentByStaticTypeID(Collidable::StaticGetTypeID()) &&
-        !collisionSystem->bHasEntityObjectRepresentation(fst)) {
-      // I don't think this needs to become a message; as an async load
-      // gives us un-deterministic throughput; it can't be replicated with a
-      // messaging structure, and we have to wait till the load is done.
-      collisionSystem->vAddCollidable(snd.get());
+////////////////////////////////////////////////////////////////////////////////////
+void ModelSystem::updateAsyncAssetLoading() {
+  if (!m_vecAssetsStillLoading.empty()) {
+    const auto deadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float, std::milli>(m_fAsyncLoadBudgetMs));
+
+    resourceLoader_->asyncUpdateLoad();
+    vSortAssetsStillLoadingByCameraDistance();
+
+    // Progress is only reported for all async loads together, so an asset is
+    // only finished once everything queued is; until then, a drained asset
+    // costs one popRenderables count query per tick.
+    const bool bAllResourcesLoaded =
+        resourceLoader_->asyncGetLoadProgress() == 1.0f;
+
+    for (auto iter = m_vecAssetsStillLoading.begin();
+         iter != m_vecAssetsStillLoading.end();) {
+      const bool bDrained =
+          populateSceneWithAsyncLoadedAssets(iter->get(), deadline);
+
+      if (bDrained && bAllResourcesLoaded) {
+        const auto model = std::move(*iter);
+        iter = m_vecAssetsStillLoading.erase(iter);
+        vOnAssetFinishedLoading(model);
+      } else {
+        ++iter;
+      }
+
+      // Farther assets wait for the next frame.
+      if (std::chrono::steady_clock::now() >= deadline) {
+        break;
+      }
     }
   }
+
+  vLoadAwaitingInstances();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -408,9 +607,6 @@ std::future<Resource<std::string_view>> ModelSystem::loadGlbFromAsset(
   auto promise_future(promise->get_future());
 
   try {
-    const asio::io_context::strand& strand_(
-        *ECSystemManager::GetInstance()->GetStrand());
-
     const auto assetPath =
         ECSystemManager::GetInstance()->getConfigValue<std::string>(kAssetPath);
 
@@ -451,13 +647,32 @@ std::future<Resource<std::string_view>> ModelSystem::loadGlbFromAsset(
           std::pair(szAssetPath, true));
     }
 
-    post(strand_,
-         [&, model = std::move(oOurModel), promise, path, assetPath]() mutable {
+    // Read on the asset pool; only creating the asset needs the strand.
+    post(ECSystemManager::GetInstance()->GetAssetIOPool(),
+         [this, model = std::move(oOurModel), promise, path,
+          assetPath]() mutable {
            try {
-             const auto buffer = readBinaryFile(path, assetPath);
-             handleFile(std::move(model), buffer, path, promise);
+             // Shared so the handler stays copyable.
+             auto buffer =
+                 std::make_shared<AssetBuffer>(mapBinaryFile(path, assetPath));
+             post(*ECSystemManager::GetInstance()->GetStrand(),
+                  [this, model = std::move(model), promise, path,
+                   buffer = std::move(buffer)]() mutable {
+                    try {
+                      handleFile(std::move(model), *buffer, path, promise);
+                    } catch (const std::exception& e) {
+                      spdlog::warn("Lambda Exception {}", e.what());
+                      promise->set_exception(std::make_exception_ptr(e));
+                    } catch (...) {
+                      spdlog::warn("Unknown Exception in lambda");
+                    }
+                  });
            } catch (const std::exception& e) {
              spdlog::warn("Lambda Exception {}", e.what());
+             post(*ECSystemManager::GetInstance()->GetStrand(),
+                  [this, model = std::move(model)] {
+                    vOnAssetFailedLoading(model);
+                  });
              promise->set_exception(std::make_exception_ptr(e));
            } catch (...) {
              spdlog::warn("Unknown Exception in lambda");
@@ -477,23 +692,51 @@ std::future<Resource<std::string_view>> ModelSystem::loadGlbFromUrl(
   const auto promise(
       std::make_shared<std::promise<Resource<std::string_view>>>());
   auto promise_future(promise->get_future());
-  post(*ECSystemManager::GetInstance()->GetStrand(),
-       [&, model = std::move(oOurModel), promise,
+  post(ECSystemManager::GetInstance()->GetAssetIOPool(),
+       [this, model = std::move(oOurModel), promise,
         url = std::move(url)]() mutable {
-         plugin_common_curl::CurlClient client;
-         const auto buffer = client.RetrieveContentAsVector();
-         if (client.GetCode() != CURLE_OK) {
-           promise->set_value(Resource<std::string_view>::Error(
-               "Couldn't load Glb from " + url));
+         try {
+           // Shared so the handler stays copyable.
+           auto buffer = std::make_shared<AssetBuffer>(
+               AssetCache::GetInstance().Fetch(url));
+           post(*ECSystemManager::GetInstance()->GetStrand(),
+                [this, model = std::move(model), promise, url,
+                 buffer = std::move(buffer)]() mutable {
+                  try {
+                    handleFile(std::move(model), *buffer, url, promise);
+                  } catch (const std::exception& e) {
+                    spdlog::warn("Lambda Exception {}", e.what());
+                    promise->set_exception(std::make_exception_ptr(e));
+                  } catch (...) {
+                    spdlog::warn("Unknown Exception in lambda");
+                  }
+                });
+         } catch (const std::exception& e) {
+           spdlog::warn("Lambda Exception {}", e.what());
+           vFailUrlLoad(std::move(model), promise, url);
+         } catch (...) {
+           spdlog::warn("Unknown Exception in lambda");
+           vFailUrlLoad(std::move(model), promise, url);
          }
-         handleFile(std::move(model), buffer, url, promise);
        });
   return promise_future;
 }
 
+////////////////////////////////////////////////////////////////////////////////////
+void ModelSystem::vFailUrlLoad(std::shared_ptr<Model>&& oOurModel,
+                               const PromisePtr& promise,
+                               const std::string& url) {
+  post(*ECSystemManager::GetInstance()->GetStrand(),
+       [this, model = std::move(oOurModel), promise, url] {
+         vOnAssetFailedLoading(model);
+         promise->set_value(Resource<std::string_view>::Error(
+             "Couldn't load Glb from " + url));
+       });
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 void ModelSystem::handleFile(std::shared_ptr<Model>&& oOurModel,
-                             const std::vector<uint8_t>& buffer,
+                             const AssetBuffer& buffer,
                              const std::string& fileSource,
                              const PromisePtr& promise) {
   spdlog::debug("handleFile");
@@ -502,6 +745,7 @@ void ModelSystem::handleFile(std::shared_ptr<Model>&& oOurModel,
     promise->set_value(Resource<std::string_view>::Success(
         "Loaded glb model successfully from " + fileSource));
   } else {
+    vOnAssetFailedLoading(oOurModel);
     promise->set_value(Resource<std::string_view>::Error(
         "Couldn't load glb model from " + fileSource));
   }
@@ -539,7 +783,7 @@ void ModelSystem::vInitSystem() {
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "ModelSystem::vInitSystem");
+          "ModelSystem::vInitSystem");
   const auto engine = filamentSystem->getFilamentEngine();
 
   if (engine == nullptr) {
@@ -582,15 +826,13 @@ void ModelSystem::vInitSystem() {
         // find the entity in our list:
         if (const auto ourEntity = m_mapszoAssets.find(guid);
             ourEntity != m_mapszoAssets.end()) {
-          const auto theObject = dynamic_cast<BaseTransform*>(
-              ourEntity->second
-                  ->GetComponentByStaticTypeID(BaseTransform::StaticGetTypeID())
-                  .get());
+          const auto theObject =
+              ourEntity->second->poGetComponent<BaseTransform>();
 
           // change stuff.
           theObject->SetCenterPosition(position);
 
-          EntityTransforms::vApplyTransform(ourEntity->second, *theObject);
+          vApplyModelTransform(ourEntity->second, *theObject);
 
           // and change the collision
           vRemoveAndReaddModelToCollisionSystem(ourEntity->first,
@@ -615,15 +857,13 @@ void ModelSystem::vInitSystem() {
         // find the entity in our list:
         if (const auto ourEntity = m_mapszoAssets.find(guid);
             ourEntity != m_mapszoAssets.end()) {
-          const auto theObject = dynamic_cast<BaseTransform*>(
-              ourEntity->second
-                  ->GetComponentByStaticTypeID(BaseTransform::StaticGetTypeID())
-                  .get());
+          const auto theObject =
+              ourEntity->second->poGetComponent<BaseTransform>();
 
           // change stuff.
           theObject->SetRotation(rotation);
 
-          EntityTransforms::vApplyTransform(ourEntity->second, *theObject);
+          vApplyModelTransform(ourEntity->second, *theObject);
 
           // and change the collision
           vRemoveAndReaddModelToCollisionSystem(ourEntity->first,
@@ -647,15 +887,13 @@ void ModelSystem::vInitSystem() {
         // find the entity in our list:
         if (const auto ourEntity = m_mapszoAssets.find(guid);
             ourEntity != m_mapszoAssets.end()) {
-          const auto theObject = dynamic_cast<BaseTransform*>(
-              ourEntity->second
-                  ->GetComponentByStaticTypeID(BaseTransform::StaticGetTypeID())
-                  .get());
+          const auto theObject =
+              ourEntity->second->poGetComponent<BaseTransform>();
 
           // change stuff.
           theObject->SetScale(values);
 
-          EntityTransforms::vApplyTransform(ourEntity->second, *theObject);
+          vApplyModelTransform(ourEntity->second, *theObject);
 
           // and change the collision
           vRemoveAndReaddModelToCollisionSystem(ourEntity->first,
@@ -677,7 +915,6 @@ void ModelSystem::vInitSystem() {
             ourEntity != m_mapszoAssets.end()) {
           const auto fSystem =
               ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-                  FilamentSystem::StaticGetTypeID(),
                   "vRegisterMessageHandler::ToggleVisualForEntity");
 
           if (const auto modelAsset = ourEntity->second->getAsset()) {
@@ -714,7 +951,6 @@ void ModelSystem::vRemoveAndReaddModelToCollisionSystem(
     const std::shared_ptr<Model>& model) {
   const auto collisionSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<CollisionSystem>(
-          CollisionSystem::StaticGetTypeID(),
           "vRemoveAndReaddModelToCollisionSystem");
   if (collisionSystem == nullptr) {
     spdlog::warn(
@@ -723,19 +959,24 @@ void ModelSystem::vRemoveAndReaddModelToCollisionSystem(
     return;
   }
 
-  // if we are marked for collidable, have one in the scene, remove and readd
-  // if this is a performance issue, we can do the transform move in the future
-  // instead.
+  // if we are marked for collidable and have one in the scene, refit it in
+  // place rather than removing and re-adding it.
   if (model->HasComponentByStaticTypeID(Collidable::StaticGetTypeID()) &&
       collisionSystem->bHasEntityObjectRepresentation(guid)) {
-    collisionSystem->vRemoveCollidable(model.get());
-    collisionSystem->vAddCollidable(model.get());
+    collisionSystem->vUpdateCollidable(model.get());
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
 void ModelSystem::vUpdate(float /*fElapsedTime*/) {
   updateAsyncAssetLoading();
+  vFlushInstanceTransforms();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+std::vector<size_t> ModelSystem::vecGetDependencies() const {
+  return {FilamentSystem::StaticGetTypeID(),
+          CollisionSystem::StaticGetTypeID()};
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -18,12 +18,16 @@
 #include <core/entity/derived/model/model.h>
 #include <core/include/resource.h>
 #include <core/systems/base/ecsystem.h>
+#include <core/utils/asset_buffer.h>
 #include <gltfio/AssetLoader.h>
 #include <gltfio/FilamentAsset.h>
 #include <gltfio/ResourceLoader.h>
 #include <asio/io_context_strand.hpp>
+#include <chrono>
 #include <future>
 #include <list>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace plugin_filament_view {
 
@@ -37,7 +41,7 @@ class ModelSystem : public ECSystem {
   void destroyAsset(const filament::gltfio::FilamentAsset* asset) const;
 
   void loadModelGlb(std::shared_ptr<Model> oOurModel,
-                    const std::vector<uint8_t>& buffer,
+                    const AssetBuffer& buffer,
                     const std::string& assetName);
 
   void loadModelGltf(std::shared_ptr<Model> oOurModel,
@@ -47,8 +51,17 @@ class ModelSystem : public ECSystem {
 
   filament::gltfio::FilamentAsset* poFindAssetByGuid(const std::string& szGUID);
 
+  // Streams async loaded renderables into the scene, nearest assets to the
+  // camera first, for at most the frame budget each call. Assets leave the
+  // queue once fully loaded and cost nothing per tick after that.
   void updateAsyncAssetLoading();
 
+  // Milliseconds per frame updateAsyncAssetLoading may spend; at least one
+  // batch of renderables is always added so loading can't stall.
+  void vSetAsyncLoadFrameBudget(float fMilliseconds) {
+    m_fAsyncLoadBudgetMs = fMilliseconds;
+  }
+
   std::future<Resource<std::string_view>> loadGlbFromAsset(
       std::shared_ptr<Model> oOurModel,
       const std::string& path);
@@ -78,6 +91,8 @@ class ModelSystem : public ECSystem {
     return typeid(ModelSystem).hash_code();
   }
 
+  [[nodiscard]] std::vector<size_t> vecGetDependencies() const override;
+
  private:
   ::filament::gltfio::AssetLoader* assetLoader_{};
   ::filament::gltfio::MaterialProvider* materialProvider_{};
@@ -99,11 +114,43 @@ class ModelSystem : public ECSystem {
   // When loading, it will be in here so we know not to load more than 1
   std::map<std::string, bool> m_mapszbCurrentlyLoadingInstanceableAssets;
 
+  // Assets made with createInstancedAsset, by asset path. Instances are
+  // created with the asset and handed out as models for the same path load.
+  // Their root transforms are kept packed here and pushed to the
+  // TransformManager in one transaction per frame.
+  struct InstancedAssetGroup {
+    std::vector<filament::gltfio::FilamentInstance*> vecSpareInstances;
+    // Entities of spare instances, kept out of the scene until claimed.
+    std::unordered_set<utils::Entity, utils::Entity::Hasher> setSpareEntities;
+    std::vector<utils::Entity> vecRoots;
+    std::vector<filament::math::mat4f> vecTransforms;
+    std::vector<uint32_t> vecDirtySlots;
+  };
+  std::map<std::string, InstancedAssetGroup> m_mapInstancedAssetGroups;
+
+  struct InstanceSlot {
+    InstancedAssetGroup* poGroup;
+    uint32_t nSlot;
+  };
+  // Models rendered through a claimed instance, by guid.
+  std::unordered_map<EntityGUID, InstanceSlot> m_mapInstanceSlots;
+  bool m_bInstanceTransformsDirty = false;
+
+  // Models whose assets are still being async loaded, re-sorted nearest to
+  // the camera first every tick.
+  std::vector<std::shared_ptr<Model>> m_vecAssetsStillLoading;
+  std::vector<std::pair<float, std::shared_ptr<Model>>> m_vecLoadOrder;
+
+  static constexpr float kDefaultAsyncLoadBudgetMs = 2.0f;
+  float m_fAsyncLoadBudgetMs = kDefaultAsyncLoadBudgetMs;
+
+  // Renderables are popped off the async load in batches of this many; small
+  // enough that one batch doesn't overrun the frame budget by much.
+  static constexpr size_t kRenderablesPerPop = 32;
+
   // This is a reusable list of renderables for popping off
   // async load.
-  // NOTE If you change this size; the async update loop on the system count
-  // needs to change.
-  utils::Entity readyRenderables_[128];
+  utils::Entity readyRenderables_[kRenderablesPerPop];
 
   // not actively used, to be moved
   std::vector<float> morphWeights_;
@@ -113,16 +160,50 @@ class ModelSystem : public ECSystem {
       filament::gltfio::FilamentAsset* filamentAsset,
       filament::gltfio::FilamentInstance* filamentAssetInstance);
 
-  void populateSceneWithAsyncLoadedAssets(const Model* model);
+  // Adds ready renderables of model's asset to the scene until none are
+  // left or deadline passes. Returns true if none are left.
+  bool populateSceneWithAsyncLoadedAssets(
+      const Model* model,
+      std::chrono::steady_clock::time_point deadline);
+
+  void vSortAssetsStillLoadingByCameraDistance();
+
+  // Hands out a spare instance of the group, or creates one if none are left.
+  filament::gltfio::FilamentInstance* poClaimInstance(
+      InstancedAssetGroup& group,
+      filament::gltfio::FilamentAsset* asset) const;
+
+  // Applies the model's transform directly, or for claimed instances, stores
+  // it in the packed buffer for vFlushInstanceTransforms.
+  void vApplyModelTransform(const std::shared_ptr<Model>& model,
+                            const BaseTransform& transform);
+  void vFlushInstanceTransforms();
+
+  // One time work for a model once its asset is fully loaded: lights and the
+  // collidable.
+  void vOnAssetFinishedLoading(const std::shared_ptr<Model>& model);
+
+  // Creates the instances waiting on a primary asset that finished loading.
+  void vLoadAwaitingInstances();
+
+  // A primary asset failed to load: clears its loading flag and drops the
+  // instances waiting on it, which would otherwise wait forever.
+  void vOnAssetFailedLoading(const std::shared_ptr<Model>& model);
 
   static void vRemoveAndReaddModelToCollisionSystem(
       const EntityGUID& guid,
       const std::shared_ptr<Model>& model);
 
   using PromisePtr = std::shared_ptr<std::promise<Resource<std::string_view>>>;
+
+  // Called on the asset pool when fetching url threw; fails the load on the
+  // strand.
+  void vFailUrlLoad(std::shared_ptr<Model>&& oOurModel,
+                    const PromisePtr& promise,
+                    const std::string& url);
   void handleFile(
       std::shared_ptr<Model>&& oOurModel,
-      const std::vector<uint8_t>& buffer,
+      const AssetBuffer& buffer,
       const std::string& fileSource,
       const PromisePtr&
           promise);  // NOLINT(readability-avoid-const-params-in-decls)
@@ -120,7 +120,6 @@ void ShapeSystem::vRemoveAndReaddShapeToCollisionSystem(
     const std::shared_ptr<BaseShape>& shape) {
   const auto collisionSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<CollisionSystem>(
-          CollisionSystem::StaticGetTypeID(),
           "vRemoveAndReaddShapeToCollisionSystem");
   if (collisionSystem == nullptr) {
     spdlog::warn(
@@ -129,13 +128,11 @@ void ShapeSystem::vRemoveAndReaddShapeToCollisionSystem(
     return;
   }
 
-  // if we are marked for collidable, have one in the scene, remove and readd
-  // if this is a performance issue, we can do the transform move in the future
-  // instead.
+  // if we are marked for collidable and have one in the scene, refit it in
+  // place rather than removing and re-adding it.
   if (shape->HasComponentByStaticTypeID(Collidable::StaticGetTypeID()) &&
       collisionSystem->bHasEntityObjectRepresentation(guid)) {
-    collisionSystem->vRemoveCollidable(shape.get());
-    collisionSystem->vAddCollidable(shape.get());
+    collisionSystem->vUpdateCollidable(shape.get());
   }
 }
 
@@ -151,7 +148,7 @@ void ShapeSystem::addShapesToScene(
 
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "addShapesToScene");
+          "addShapesToScene");
   const auto engine = filamentSystem->getFilamentEngine();
 
   filament::Engine* poFilamentEngine = engine;
@@ -227,15 +224,11 @@ void ShapeSystem::vInitSystem() {
         // find the entity in our list:
         if (const auto ourEntity = m_mapszoShapes.find(guid);
             ourEntity != m_mapszoShapes.end()) {
-          const auto baseTransform = dynamic_cast<BaseTransform*>(
-              ourEntity->second
-                  ->GetComponentByStaticTypeID(BaseTransform::StaticGetTypeID())
-                  .get());
+          const auto baseTransform =
+              ourEntity->second->poGetComponent<BaseTransform>();
 
-          const auto collidable = dynamic_cast<Collidable*>(
-              ourEntity->second
-                  ->GetComponentByStaticTypeID(Collidable::StaticGetTypeID())
-                  .get());
+          const auto collidable =
+              ourEntity->second->poGetComponent<Collidable>();
 
           // this ideally checks for SetShouldMatchAttachedObject in the future
           // - todo
@@ -268,10 +261,8 @@ void ShapeSystem::vInitSystem() {
         // find the entity in our list:
         if (const auto ourEntity = m_mapszoShapes.find(guid);
             ourEntity != m_mapszoShapes.end()) {
-          const auto baseTransform = dynamic_cast<BaseTransform*>(
-              ourEntity->second
-                  ->GetComponentByStaticTypeID(BaseTransform::StaticGetTypeID())
-                  .get());
+          const auto baseTransform =
+              ourEntity->second->poGetComponent<BaseTransform>();
 
           // change stuff.
           baseTransform->SetRotation(rotation);
@@ -301,15 +292,11 @@ void ShapeSystem::vInitSystem() {
         // find the entity in our list:
         if (const auto ourEntity = m_mapszoShapes.find(guid);
             ourEntity != m_mapszoShapes.end()) {
-          const auto baseTransform = dynamic_cast<BaseTransform*>(
-              ourEntity->second
-                  ->GetComponentByStaticTypeID(BaseTransform::StaticGetTypeID())
-                  .get());
+          const auto baseTransform =
+              ourEntity->second->poGetComponent<BaseTransform>();
 
-          const auto collidable = dynamic_cast<Collidable*>(
-              ourEntity->second
-                  ->GetComponentByStaticTypeID(Collidable::StaticGetTypeID())
-                  .get());
+          const auto collidable =
+              ourEntity->second->poGetComponent<Collidable>();
 
           // this ideally checks for SetShouldMatchAttachedObject in the future
           // - todo
@@ -331,6 +318,12 @@ void ShapeSystem::vInitSystem() {
 ////////////////////////////////////////////////////////////////////////////////////
 void ShapeSystem::vUpdate(float /*fElapsedTime*/) {}
 
+////////////////////////////////////////////////////////////////////////////////////
+std::vector<size_t> ShapeSystem::vecGetDependencies() const {
+  return {FilamentSystem::StaticGetTypeID(),
+          CollisionSystem::StaticGetTypeID()};
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 void ShapeSystem::vShutdownSystem() {
   // remove all filament entities.
@@ -58,6 +58,8 @@ class ShapeSystem : public ECSystem {
     return typeid(ShapeSystem).hash_code();
   }
 
+  [[nodiscard]] std::vector<size_t> vecGetDependencies() const override;
+
   void vInitSystem() override;
   void vUpdate(float fElapsedTime) override;
   void vShutdownSystem() override;
@@ -17,19 +17,19 @@
 #include "skybox_system.h"
 
 #include <filesystem>
-#include <fstream>
 #include <sstream>
 
 #include <core/include/color.h>
 #include <core/include/literals.h>
 #include <core/systems/derived/filament_system.h>
 #include <core/systems/ecsystems_manager.h>
+#include <core/utils/asset_buffer.h>
+#include <core/utils/asset_cache.h>
 #include <core/utils/hdr_loader.h>
 #include <filament/IndirectLight.h>
 #include <filament/Scene.h>
 #include <filament/Skybox.h>
 #include <plugins/common/common.h>
-#include <plugins/common/curl_client/curl_client.h>
 #include <asio/post.hpp>
 
 namespace plugin_filament_view {
@@ -45,7 +45,7 @@ std::future<void> SkyboxSystem::Initialize() {
   post(strand_, [&, promise] {
     const auto filamentSystem =
         ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-            FilamentSystem::StaticGetTypeID(), "SKyboxManager::Init::Lambda");
+            "SKyboxManager::Init::Lambda");
     const auto engine = filamentSystem->getFilamentEngine();
 
     const auto whiteSkybox = filament::Skybox::Builder()
@@ -70,11 +70,24 @@ void SkyboxSystem::setDefaultSkybox() {
 void SkyboxSystem::setTransparentSkybox() {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "setTransparentSkybox");
+          "setTransparentSkybox");
 
   filamentSystem->getFilamentScene()->setSkybox(nullptr);
 }
 
+////////////////////////////////////////////////////////////////////////////////////
+void SkyboxSystem::vLoadDecodedHdrOnStrand(const PromisePtr& promise,
+                                           image::LinearImage* image,
+                                           const bool showSun,
+                                           const bool shouldUpdateLight,
+                                           const float intensity) {
+  post(*ECSystemManager::GetInstance()->GetStrand(),
+       [promise, image, showSun, shouldUpdateLight, intensity] {
+         promise->set_value(loadSkyboxFromHdrImage(
+             image, showSun, shouldUpdateLight, intensity));
+       });
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 std::future<Resource<std::string_view>> SkyboxSystem::setSkyboxFromHdrAsset(
     const std::string& path,
@@ -95,15 +108,21 @@ std::future<Resource<std::string_view>> SkyboxSystem::setSkyboxFromHdrAsset(
   if (path.empty() || !exists(asset_path)) {
     promise->set_value(
         Resource<std::string_view>::Error("Skybox Asset path is not valid"));
+    return future;
   }
 
-  const asio::io_context::strand& strand_(
-      *ECSystemManager::GetInstance()->GetStrand());
-
-  post(strand_,
-       [&, promise, asset_path, showSun, shouldUpdateLight, intensity] {
-         promise->set_value(loadSkyboxFromHdrFile(
-             asset_path, showSun, shouldUpdateLight, intensity));
+  post(ECSystemManager::GetInstance()->GetAssetIOPool(),
+       [promise, asset_path, showSun, shouldUpdateLight, intensity] {
+         image::LinearImage* decoded;
+         try {
+           decoded = HDRLoader::decodeImage(asset_path);
+         } catch (...) {
+           promise->set_value(
+               Resource<std::string_view>::Error("Could not decode HDR file"));
+           return;
+         }
+         vLoadDecodedHdrOnStrand(promise, decoded, showSun, shouldUpdateLight,
+                                 intensity);
        });
 
   SPDLOG_TRACE("--SkyboxManager::setSkyboxFromHdrAsset");
@@ -126,26 +145,27 @@ std::future<Resource<std::string_view>> SkyboxSystem::setSkyboxFromHdrUrl(
     return future;
   }
 
-  const asio::io_context::strand& strand_(
-      *ECSystemManager::GetInstance()->GetStrand());
-
   SPDLOG_DEBUG("Skybox downloading HDR Asset: {}", url.c_str());
-  post(strand_, [&, promise, url, showSun, shouldUpdateLight, intensity] {
-    plugin_common_curl::CurlClient client;
-    // todo client.Init(url, {}, {});
-    const auto buffer = client.RetrieveContentAsVector();
-    if (client.GetCode() != CURLE_OK) {
-      promise->set_value(Resource<std::string_view>::Error(
-          "Couldn't load skybox from " + url));
-    }
-    if (!buffer.empty()) {
-      promise->set_value(loadSkyboxFromHdrBuffer(buffer, showSun,
-                                                 shouldUpdateLight, intensity));
-    } else {
-      promise->set_value(Resource<std::string_view>::Error(
-          "Couldn't load HDR file from " + url));
-    }
-  });
+  post(ECSystemManager::GetInstance()->GetAssetIOPool(),
+       [promise, url, showSun, shouldUpdateLight, intensity] {
+         const auto buffer = AssetCache::GetInstance().Fetch(url);
+         if (buffer.empty()) {
+           promise->set_value(Resource<std::string_view>::Error(
+               "Couldn't load skybox from " + url));
+           return;
+         }
+
+         image::LinearImage* decoded;
+         try {
+           decoded = HDRLoader::decodeImage(buffer.data(), buffer.size());
+         } catch (...) {
+           promise->set_value(Resource<std::string_view>::Error(
+               "Could not decode HDR buffer"));
+           return;
+         }
+         vLoadDecodedHdrOnStrand(promise, decoded, showSun, shouldUpdateLight,
+                                 intensity);
+       });
   SPDLOG_TRACE("--SkyboxManager::setSkyboxFromHdrUrl");
   return future;
 }
@@ -166,15 +186,12 @@ std::future<Resource<std::string_view>> SkyboxSystem::setSkyboxFromKTXAsset(
   if (path.empty() || !exists(asset_path)) {
     promise->set_value(
         Resource<std::string_view>::Error("KTX Asset path is not valid"));
+    return future;
   }
-  const asio::io_context::strand& strand_(
-      *ECSystemManager::GetInstance()->GetStrand());
 
   SPDLOG_DEBUG("Skybox loading KTX Asset: {}", asset_path.c_str());
-  post(strand_, [&, promise, asset_path] {
-    std::ifstream stream(asset_path, std::ios::in | std::ios::binary);
-    std::vector<uint8_t> buffer((std::istreambuf_iterator(stream)),
-                                std::istreambuf_iterator<char>());
+  post(ECSystemManager::GetInstance()->GetAssetIOPool(), [promise, asset_path] {
+    const auto buffer = AssetBuffer::Map(asset_path);
     if (!buffer.empty()) {
       std::stringstream ss;
       ss << "Loaded environment successfully from " << asset_path;
@@ -201,19 +218,8 @@ std::future<Resource<std::string_view>> SkyboxSystem::setSkyboxFromKTXUrl(
     return future;
   }
 
-  const asio::io_context::strand& strand_(
-      *ECSystemManager::GetInstance()->GetStrand());
-  post(strand_, [&, promise, url] {
-    plugin_common_curl::CurlClient client;
-
-    // TODO client.Init(url, {}, {});
-    auto buffer = client.RetrieveContentAsVector();
-    if (client.GetCode() != CURLE_OK) {
-      std::stringstream ss;
-      ss << "Couldn't load skybox from " << url;
-      promise->set_value(Resource<std::string_view>::Error(ss.str()));
-    }
-
+  post(ECSystemManager::GetInstance()->GetAssetIOPool(), [promise, url] {
+    const auto buffer = AssetCache::GetInstance().Fetch(url);
     if (!buffer.empty()) {
       std::stringstream ss;
       ss << "Loaded skybox successfully from " << url;
@@ -247,7 +253,7 @@ std::future<Resource<std::string_view>> SkyboxSystem::setSkyboxFromColor(
   post(strand_, [&, promise, color] {
     const auto filamentSystem =
         ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-            FilamentSystem::StaticGetTypeID(), "setSkyboxFromColor");
+            "setSkyboxFromColor");
     const auto engine = filamentSystem->getFilamentEngine();
 
     const auto colorArray = colorOf(color);
@@ -268,56 +274,13 @@ Resource<std::string_view> SkyboxSystem::loadSkyboxFromHdrFile(
     const bool showSun,
     const bool shouldUpdateLight,
     const float intensity) {
-  filament::Texture* texture;
-
-  const auto filamentSystem =
-      ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "loadSkyboxFromHdrFile");
-  const auto engine = filamentSystem->getFilamentEngine();
-
+  image::LinearImage* decoded;
   try {
-    texture = HDRLoader::createTexture(engine, assetPath);
+    decoded = HDRLoader::decodeImage(assetPath);
   } catch (...) {
     return Resource<std::string_view>::Error("Could not decode HDR buffer");
   }
-  if (texture) {
-    const auto skyboxTexture =
-        filamentSystem->getIBLProfiler()->createCubeMapTexture(texture);
-    engine->destroy(texture);
-
-    if (skyboxTexture) {
-      const auto sky = filament::Skybox::Builder()
-                           .environment(skyboxTexture)
-                           .showSun(showSun)
-                           .build(*engine);
-
-      // updates scene light with skybox when loaded with the same hdr file
-      if (shouldUpdateLight) {
-        const auto reflections =
-            filamentSystem->getIBLProfiler()->getLightReflection(skyboxTexture);
-        const auto ibl = filament::IndirectLight::Builder()
-                             .reflections(reflections)
-                             .intensity(intensity)
-                             .build(*engine);
-        // destroy the previous IBl
-        const auto indirectLight =
-            filamentSystem->getFilamentScene()->getIndirectLight();
-        engine->destroy(indirectLight);
-        filamentSystem->getFilamentScene()->setIndirectLight(ibl);
-      }
-
-      if (const auto prevSkybox =
-              filamentSystem->getFilamentScene()->getSkybox()) {
-        engine->destroy(prevSkybox);
-      }
-
-      filamentSystem->getFilamentScene()->setSkybox(sky);
-    }
-    return Resource<std::string_view>::Success(
-        "Loaded hdr skybox successfully");
-  }
-
-  return Resource<std::string_view>::Error("Could not decode HDR file");
+  return loadSkyboxFromHdrImage(decoded, showSun, shouldUpdateLight, intensity);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -326,19 +289,27 @@ Resource<std::string_view> SkyboxSystem::loadSkyboxFromHdrBuffer(
     const bool showSun,
     const bool shouldUpdateLight,
     const float intensity) {
-  filament::Texture* texture;
+  image::LinearImage* decoded;
+  try {
+    decoded = HDRLoader::decodeImage(buffer);
+  } catch (...) {
+    return Resource<std::string_view>::Error("Could not decode HDR buffer");
+  }
+  return loadSkyboxFromHdrImage(decoded, showSun, shouldUpdateLight, intensity);
+}
 
+////////////////////////////////////////////////////////////////////////////////////
+Resource<std::string_view> SkyboxSystem::loadSkyboxFromHdrImage(
+    image::LinearImage* image,
+    const bool showSun,
+    const bool shouldUpdateLight,
+    const float intensity) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "loadSkyboxFromHdrBuffer");
+          "loadSkyboxFromHdrImage");
   const auto engine = filamentSystem->getFilamentEngine();
 
-  try {
-    texture = HDRLoader::createTexture(engine, buffer);
-  } catch (...) {
-    return Resource<std::string_view>::Error("Could not decode HDR buffer");
-  }
-  if (texture) {
+  if (const auto texture = HDRLoader::createTextureFromImage(engine, image)) {
     const auto skyboxTexture =
         filamentSystem->getIBLProfiler()->createCubeMapTexture(texture);
     engine->destroy(texture);
@@ -386,11 +357,16 @@ void SkyboxSystem::vInitSystem() {
 ////////////////////////////////////////////////////////////////////////////////////
 void SkyboxSystem::vUpdate(float /*fElapsedTime*/) {}
 
+////////////////////////////////////////////////////////////////////////////////////
+std::vector<size_t> SkyboxSystem::vecGetDependencies() const {
+  return {FilamentSystem::StaticGetTypeID()};
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 void SkyboxSystem::vShutdownSystem() {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "loadSkyboxFromHdrBuffer");
+          "loadSkyboxFromHdrBuffer");
   const auto engine = filamentSystem->getFilamentEngine();
 
   if (const auto prevSkybox = filamentSystem->getFilamentScene()->getSkybox()) {
@@ -20,6 +20,10 @@
 #include <core/systems/base/ecsystem.h>
 #include <future>
 
+namespace image {
+class LinearImage;
+}
+
 namespace plugin_filament_view {
 
 class SkyboxSystem : public ECSystem {
@@ -63,6 +67,14 @@ class SkyboxSystem : public ECSystem {
       bool shouldUpdateLight,
       float intensity);
 
+  // Builds the skybox (and IBL) from an already decoded HDR image; takes
+  // ownership of it. Must run on the Filament API thread.
+  static Resource<std::string_view> loadSkyboxFromHdrImage(
+      image::LinearImage* image,
+      bool showSun,
+      bool shouldUpdateLight,
+      float intensity);
+
   // Disallow copy and assign.
   SkyboxSystem(const SkyboxSystem&) = delete;
   SkyboxSystem& operator=(const SkyboxSystem&) = delete;
@@ -73,12 +85,23 @@ class SkyboxSystem : public ECSystem {
     return typeid(SkyboxSystem).hash_code();
   }
 
+  [[nodiscard]] std::vector<size_t> vecGetDependencies() const override;
+
   void vInitSystem() override;
   void vUpdate(float fElapsedTime) override;
   void vShutdownSystem() override;
   void DebugPrint() override;
 
  private:
+  using PromisePtr = std::shared_ptr<std::promise<Resource<std::string_view>>>;
+
   static void setTransparentSkybox();
+
+  // Called from the asset I/O pool once decoding is done.
+  static void vLoadDecodedHdrOnStrand(const PromisePtr& promise,
+                                      image::LinearImage* image,
+                                      bool showSun,
+                                      bool shouldUpdateLight,
+                                      float intensity);
 };
 }  // namespace plugin_filament_view
\ No newline at end of file
@@ -15,7 +15,9 @@
  */
 
 #include "view_target_system.h"
+#include "filament_system.h"
 #include <core/scene/view_target.h>
+#include <filament/View.h>
 
 namespace plugin_filament_view {
 
@@ -185,6 +187,11 @@ void ViewTargetSystem::vInitSystem() {
 ////////////////////////////////////////////////////////////////////////////////////
 void ViewTargetSystem::vUpdate(float /*fElapsedTime*/) {}
 
+////////////////////////////////////////////////////////////////////////////////////
+std::vector<size_t> ViewTargetSystem::vecGetDependencies() const {
+  return {FilamentSystem::StaticGetTypeID()};
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 void ViewTargetSystem::vShutdownSystem() {
   m_poCamera.reset();
@@ -271,6 +278,28 @@ void ViewTargetSystem::vOnTouch(const size_t nWhich,
                                      point_data);
 }
 
+////////////////////////////////////////////////////////////////////////////////////
+void ViewTargetSystem::vQueuePickPoints(
+    const size_t nWhich,
+    const std::vector<ViewTarget::PickPoint>& points,
+    const CollisionEventType eType) const {
+  m_lstViewTargets[nWhich]->vQueuePickPoints(points, eType);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+filament::math::float3 ViewTargetSystem::f3GetCameraPosition(
+    const size_t nWhich) const {
+  if (nWhich >= m_lstViewTargets.size() ||
+      m_lstViewTargets[nWhich]->getFilamentView() == nullptr) {
+    return {};
+  }
+
+  const auto position =
+      m_lstViewTargets[nWhich]->getFilamentView()->getCamera().getPosition();
+  return {static_cast<float>(position.x), static_cast<float>(position.y),
+          static_cast<float>(position.z)};
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 void ViewTargetSystem::vChangePrimaryCameraMode(
     const size_t nWhich,
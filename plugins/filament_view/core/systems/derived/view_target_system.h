@@ -40,6 +40,8 @@ class ViewTargetSystem : public ECSystem {
     return typeid(ViewTargetSystem).hash_code();
   }
 
+  [[nodiscard]] std::vector<size_t> vecGetDependencies() const override;
+
   void vInitSystem() override;
   void vUpdate(float fElapsedTime) override;
   void vShutdownSystem() override;
@@ -65,11 +67,20 @@ class ViewTargetSystem : public ECSystem {
                 size_t point_data_size,
                 const double* point_data) const;
 
+  void vQueuePickPoints(size_t nWhich,
+                        const std::vector<ViewTarget::PickPoint>& points,
+                        CollisionEventType eType) const;
+
   void vChangePrimaryCameraMode(size_t nWhich,
                                 const std::string& szValue) const;
   void vResetInertiaCameraToDefaultValues(size_t nWhich) const;
   void vSetCurrentCameraOrbitAngle(size_t nWhich, float fValue) const;
 
+  // World position of the camera rendering view target nWhich, or the
+  // origin if there is no such view target yet.
+  [[nodiscard]] filament::math::float3 f3GetCameraPosition(
+      size_t nWhich) const;
+
   void vChangeViewQualitySettings(
       size_t nWhich,
       ViewTarget::ePredefinedQualitySettings settings) const;
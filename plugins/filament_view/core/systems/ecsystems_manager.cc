@@ -16,12 +16,29 @@
 #include "ecsystems_manager.h"
 
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <asio/post.hpp>
 #include <chrono>
+#include <set>
 #include <thread>
 
 namespace plugin_filament_view {
 
+namespace {
+// Asset loads are mostly waiting on disk or network; two lets a download and
+// a decode overlap without competing with the Filament API thread for cores.
+constexpr size_t kAssetIOThreads = 2;
+
+// Frame callbacks of several view targets for the same vsync arrive this
+// fraction of a frame apart at most; only the first one updates the systems.
+constexpr float kFrameCallbackCoalesceFraction = 0.25f;
+
+// Rate the run loop ticks at while no frame callbacks arrive.
+constexpr auto kFrameTime =
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(1.0f / 60.0f));
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////
 ECSystemManager* ECSystemManager::m_poInstance = nullptr;
 ECSystemManager* ECSystemManager::GetInstance() {
@@ -42,6 +59,7 @@ ECSystemManager::ECSystemManager()
     : io_context_(std::make_unique<asio::io_context>(ASIO_CONCURRENCY_HINT_1)),
       work_(make_work_guard(io_context_->get_executor())),
       strand_(std::make_unique<asio::io_context::strand>(*io_context_)),
+      asset_io_pool_(std::make_unique<asio::thread_pool>(kAssetIOThreads)),
       m_eCurrentState(NotInitialized) {
   vSetupThreadingInternals();
 }
@@ -77,25 +95,35 @@ void ECSystemManager::vSetupThreadingInternals() {
 
 ////////////////////////////////////////////////////////////////////////////
 void ECSystemManager::RunLoop() {
-  constexpr std::chrono::milliseconds frameTime(16);  // ~1/60 second
-
-  // Initialize lastFrameTime to the current time
-  auto lastFrameTime = std::chrono::steady_clock::now();
-
   m_eCurrentState = Running;
+
+  auto nextTick = std::chrono::steady_clock::now();
   while (m_bIsRunning) {
-    auto start = std::chrono::steady_clock::now();
+    // Ticks missed while the API thread was busy are dropped, not caught up.
+    nextTick =
+        std::max(nextTick + kFrameTime, std::chrono::steady_clock::now());
+    {
+      std::unique_lock lock(loopMutex);
+      loopCondition.wait_until(lock, nextTick,
+                               [this] { return !m_bIsRunning; });
+    }
+    if (!m_bIsRunning) {
+      break;
+    }
 
-    // Calculate the time difference between this frame and the last frame
-    std::chrono::duration<float> elapsedTime = start - lastFrameTime;
+    // Frame callbacks drive the updates while the view is shown; this only
+    // fills in when they stop, e.g. before the first frame or while hidden.
+    if (const std::chrono::steady_clock::time_point lastFrameCallback(
+            std::chrono::nanoseconds(m_nLastFrameCallbackTime.load()));
+        std::chrono::steady_clock::now() - lastFrameCallback < 2 * kFrameTime) {
+      continue;
+    }
 
-    if (!isHandlerExecuting.load()) {
-      // Use asio::post to schedule work on the main thread (API thread)
-      post(*strand_, [elapsedTime = elapsedTime.count(), this] {
-        isHandlerExecuting.store(true);
+    // Never queue more than one update behind a busy API thread.
+    if (!isHandlerExecuting.exchange(true)) {
+      post(*strand_, [this] {
         try {
-          ExecuteOnMainThread(
-              elapsedTime);  // Pass elapsed time to the main thread
+          ExecuteOnMainThread();
         } catch (...) {
           isHandlerExecuting.store(false);
           throw;  // Rethrow the exception after resetting the flag
@@ -103,17 +131,6 @@ void ECSystemManager::RunLoop() {
         isHandlerExecuting.store(false);
       });
     }
-
-    // Update the time for the next frame
-    lastFrameTime = start;
-
-    auto end = std::chrono::steady_clock::now();
-
-    // Sleep for the remaining time in the frame
-    if (std::chrono::duration<double> elapsed = end - start;
-        elapsed < frameTime) {
-      std::this_thread::sleep_for(frameTime - elapsed);
-    }
   }
   m_eCurrentState = ShutdownStarted;
 
@@ -122,7 +139,11 @@ void ECSystemManager::RunLoop() {
 
 ////////////////////////////////////////////////////////////////////////////
 void ECSystemManager::StopRunLoop() {
-  m_bIsRunning = false;
+  {
+    std::unique_lock lock(loopMutex);
+    m_bIsRunning = false;
+  }
+  loopCondition.notify_all();
   if (loopThread_.joinable()) {
     loopThread_.join();
   }
@@ -137,11 +158,41 @@ void ECSystemManager::StopRunLoop() {
   if (filament_api_thread_.joinable()) {
     filament_api_thread_.join();
   }
+
+  // Drops queued loads; ones already running finish, and their strand posts
+  // are discarded with the stopped io_context.
+  asset_io_pool_->stop();
+  asset_io_pool_->join();
 }
 
 ////////////////////////////////////////////////////////////////////////////
-void ECSystemManager::ExecuteOnMainThread(const float elapsedTime) {
-  vUpdate(elapsedTime);
+void ECSystemManager::vOnFrameCallback() {
+  if (m_eCurrentState != Running) {
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  m_nLastFrameCallbackTime =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          now.time_since_epoch())
+          .count();
+
+  if (now - m_tpLastUpdate < kFrameTime * kFrameCallbackCoalesceFraction) {
+    return;
+  }
+  ExecuteOnMainThread();
+}
+
+////////////////////////////////////////////////////////////////////////////
+void ECSystemManager::ExecuteOnMainThread() {
+  const auto now = std::chrono::steady_clock::now();
+  if (m_tpLastUpdate == std::chrono::steady_clock::time_point{}) {
+    m_tpLastUpdate = now;
+  }
+  const std::chrono::duration<float> elapsedTime = now - m_tpLastUpdate;
+  m_tpLastUpdate = now;
+
+  vUpdate(elapsedTime.count());
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -155,32 +206,50 @@ void ECSystemManager::vInitSystems() {
     system->vInitSystem();
   }
 
+  {
+    std::unique_lock lock(vecSystemsMutex);
+    vBuildSchedule();
+  }
+
   m_eCurrentState = Initialized;
 
   //});
 }
 
+////////////////////////////////////////////////////////////////////////////
+void ECSystemManager::vLogOffThreadCaller(const char* where) {
+  // No lock and no string: each call site is looked up by pointer, and only
+  // the first call from it claims a slot and logs.
+  const auto key = reinterpret_cast<uintptr_t>(where);
+  const size_t start = (key ^ (key >> 8)) % kOffThreadCallerSlots;
+  for (size_t i = 0; i < kOffThreadCallerSlots; ++i) {
+    auto& slot = m_aOffThreadCallers[(start + i) % kOffThreadCallerSlots];
+    const char* seen = slot.load(std::memory_order_relaxed);
+    if (seen == nullptr &&
+        slot.compare_exchange_strong(seen, where, std::memory_order_relaxed)) {
+      break;
+    }
+    if (seen == where) {
+      return;
+    }
+  }
+
+  spdlog::info(
+      "From {} "
+      "You're calling to get a system from an off thread, undefined "
+      "experience!"
+      " Use a message to do your work or grab the ecsystemmanager strand "
+      "and "
+      "do your work.",
+      where);
+}
+
 ////////////////////////////////////////////////////////////////////////////
 std::shared_ptr<ECSystem> ECSystemManager::poGetSystem(
     const size_t systemTypeID,
-    const std::string& where) {
-  if (const auto callingThread = pthread_self();
-      callingThread != filament_api_thread_id_) {
-    // Note we should have a 'log once' base functionality in common
-    // creating this inline for now.
-    if (const auto foundIter = m_mapOffThreadCallers.find(where);
-        foundIter == m_mapOffThreadCallers.end()) {
-      spdlog::info(
-          "From {} "
-          "You're calling to get a system from an off thread, undefined "
-          "experience!"
-          " Use a message to do your work or grab the ecsystemmanager strand "
-          "and "
-          "do your work.",
-          where);
-
-      m_mapOffThreadCallers.insert(std::pair(where, 0));
-    }
+    const char* where) {
+  if (pthread_self() != filament_api_thread_id_) {
+    vLogOffThreadCaller(where);
   }
 
   std::unique_lock lock(vecSystemsMutex);
@@ -198,26 +267,108 @@ void ECSystemManager::vAddSystem(std::shared_ptr<ECSystem> system) {
   spdlog::debug("Adding system at address {}",
                 static_cast<void*>(system.get()));
   m_vecSystems.push_back(std::move(system));
+  m_bScheduleDirty = true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void ECSystemManager::vRemoveSystem(const std::shared_ptr<ECSystem>& system) {
+  std::unique_lock<std::mutex> lock(vecSystemsMutex);
+  m_vecSystems.erase(
+      std::remove(m_vecSystems.begin(), m_vecSystems.end(), system),
+      m_vecSystems.end());
+  m_bScheduleDirty = true;
+
+  if (const auto it = m_mapSystemSlotResets.find(system.get());
+      it != m_mapSystemSlotResets.end()) {
+    for (const auto reset : it->second) {
+      reset();
+    }
+    m_mapSystemSlotResets.erase(it);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+void ECSystemManager::vRemoveAllSystems() {
+  std::unique_lock<std::mutex> lock(vecSystemsMutex);
+  m_vecSystems.clear();
+  m_bScheduleDirty = true;
+
+  for (const auto& [system, resets] : m_mapSystemSlotResets) {
+    for (const auto reset : resets) {
+      reset();
+    }
+  }
+  m_mapSystemSlotResets.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////
+void ECSystemManager::vBuildSchedule() {
+  m_vecStages.clear();
+  m_bScheduleDirty = false;
+
+  std::vector<std::shared_ptr<ECSystem>> remaining;
+  std::set<size_t> registered;
+  for (const auto& system : m_vecSystems) {
+    if (system) {
+      remaining.push_back(system);
+      registered.insert(system->GetTypeID());
+    } else {
+      spdlog::error("Encountered null system pointer!");
+    }
+  }
+
+  // Systems keep their registration order within a stage.
+  std::set<size_t> scheduled;
+  while (!remaining.empty()) {
+    std::vector<std::shared_ptr<ECSystem>> stage;
+    for (const auto& system : remaining) {
+      const auto dependencies = system->vecGetDependencies();
+      if (std::all_of(dependencies.begin(), dependencies.end(),
+                      [&](const size_t typeID) {
+                        return scheduled.count(typeID) != 0 ||
+                               registered.count(typeID) == 0;
+                      })) {
+        stage.push_back(system);
+      }
+    }
+
+    if (stage.empty()) {
+      spdlog::error(
+          "ECSystemManager: dependency cycle between {} systems, updating "
+          "them in registration order",
+          remaining.size());
+      m_vecStages.push_back(std::move(remaining));
+      break;
+    }
+
+    for (const auto& system : stage) {
+      scheduled.insert(system->GetTypeID());
+      remaining.erase(std::find(remaining.begin(), remaining.end(), system));
+    }
+    m_vecStages.push_back(std::move(stage));
+  }
+
+  spdlog::debug("ECSystemManager scheduled {} systems in {} stages",
+                registered.size(), m_vecStages.size());
 }
 
 ////////////////////////////////////////////////////////////////////////////
 void ECSystemManager::vUpdate(const float deltaTime) {
-  // Copy systems under mutex
-  std::vector<std::shared_ptr<ECSystem>> systemsCopy;
+  // Copy the stages under mutex
+  std::vector<std::vector<std::shared_ptr<ECSystem>>> stagesCopy;
   {
     std::unique_lock lock(vecSystemsMutex);
-
-    // Copy the systems vector
-    systemsCopy = m_vecSystems;
+    if (m_bScheduleDirty) {
+      vBuildSchedule();
+    }
+    stagesCopy = m_vecStages;
   }  // Mutex is unlocked here
 
   // Iterate over the copy without holding the mutex
-  for (const auto& system : systemsCopy) {
-    if (system) {
+  for (const auto& stage : stagesCopy) {
+    for (const auto& system : stage) {
       system->vProcessMessages();
       system->vUpdate(deltaTime);
-    } else {
-      spdlog::error("Encountered null system pointer!");
     }
   }
 }
@@ -235,12 +386,22 @@ void ECSystemManager::DebugPrint() const {
 ////////////////////////////////////////////////////////////////////////////
 void ECSystemManager::vShutdownSystems() {
   post(*GetInstance()->GetStrand(), [&] {
-    // we shutdown in reverse, until we have a 'system dependency tree' type of
-    // view, filament system (which is always the first system, needs to be
-    // shutdown last as its 'engine' varible is used in destruction for other
-    // systems
-    for (auto it = m_vecSystems.rbegin(); it != m_vecSystems.rend(); ++it) {
-      (*it)->vShutdownSystem();
+    std::vector<std::vector<std::shared_ptr<ECSystem>>> stagesCopy;
+    {
+      std::unique_lock lock(vecSystemsMutex);
+      if (m_bScheduleDirty) {
+        vBuildSchedule();
+      }
+      stagesCopy = m_vecStages;
+    }
+
+    // Shut down in reverse dependency order, so the filament system, whose
+    // engine is used in the destruction of every other system, goes last.
+    for (auto stage = stagesCopy.rbegin(); stage != stagesCopy.rend();
+         ++stage) {
+      for (auto it = stage->rbegin(); it != stage->rend(); ++it) {
+        (*it)->vShutdownSystem();
+      }
     }
 
     m_eCurrentState = Shutdown;
@@ -17,6 +17,12 @@
 
 #include <core/systems/base/ecsystem.h>
 #include <asio/io_context_strand.hpp>
+#include <asio/thread_pool.hpp>
+#include <any>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <future>
 #include <map>
 #include <memory>
@@ -43,37 +49,45 @@ class ECSystemManager {
 
   void vAddSystem(std::shared_ptr<ECSystem> system);
 
-  void vRemoveSystem(const std::shared_ptr<ECSystem>& system) {
+  // Adds a system and remembers it by its static type, for poGetSystemAs.
+  template <typename T>
+  void vAddSystem(std::unique_ptr<T> system) {
+    T* typedSystem = system.get();
+    vAddSystem(std::shared_ptr<ECSystem>(std::move(system)));
+
     std::unique_lock<std::mutex> lock(vecSystemsMutex);
-    m_vecSystems.erase(
-        std::remove(m_vecSystems.begin(), m_vecSystems.end(), system),
-        m_vecSystems.end());
+    vCacheSystem(typedSystem);
   }
 
-  // Send a message to all registered systems
+  void vRemoveSystem(const std::shared_ptr<ECSystem>& system);
+
+  // Send a message to the registered systems handling any of its types
   void vRouteMessage(const ECSMessage& msg) {
     std::unique_lock<std::mutex> lock(vecSystemsMutex);
     for (const auto& system : m_vecSystems) {
-      system->vSendMessage(msg);
+      if (system->bIsSubscribedTo(msg)) {
+        system->vSendMessage(msg);
+      }
     }
   }
 
   // Clear all systems
-  void vRemoveAllSystems() {
-    std::unique_lock<std::mutex> lock(vecSystemsMutex);
-    m_vecSystems.clear();
-  }
+  void vRemoveAllSystems();
 
-  std::shared_ptr<ECSystem> poGetSystem(size_t systemTypeID,
-                                        const std::string& where);
+  std::shared_ptr<ECSystem> poGetSystem(size_t systemTypeID, const char* where);
 
+  // Systems are cached per type when added, so this is a pointer load on the
+  // hot path. Systems live until shutdown; don't keep the pointer past it.
   template <typename Target>
-  std::shared_ptr<Target> poGetSystemAs(size_t systemTypeID,
-                                        const std::string& where) {
-    // Retrieve the system from the manager using its type ID
-    auto system = poGetSystem(systemTypeID, where);
-    // Perform dynamic pointer cast to the desired type
-    return std::dynamic_pointer_cast<Target>(system);
+  Target* poGetSystemAs(const char* where) {
+    if (pthread_self() != filament_api_thread_id_) {
+      vLogOffThreadCaller(where);
+    }
+    if (Target* system =
+            m_poSystemByType<Target>.load(std::memory_order_acquire)) {
+      return system;
+    }
+    return poResolveSystem<Target>();
   }
 
   void vInitSystems();
@@ -85,6 +99,11 @@ class ECSystemManager {
   void StartRunLoop();
   void StopRunLoop();
 
+  // Called on the Filament API thread from the Wayland frame callback, before
+  // the frame is drawn. While frame callbacks arrive they drive the updates;
+  // otherwise the run loop ticks at 60 Hz.
+  void vOnFrameCallback();
+
   [[nodiscard]] bool bIsCompletedStopping() const {
     return m_bSpawnedThreadFinished;
   }
@@ -101,6 +120,12 @@ class ECSystemManager {
     return strand_;
   }
 
+  // File reads, downloads and image decoding for asset loaders run here so
+  // they never stall a frame; post the Engine work back onto GetStrand().
+  [[nodiscard]] asio::thread_pool& GetAssetIOPool() const {
+    return *asset_io_pool_;
+  }
+
   template <typename T>
   void setConfigValue(const std::string& key, T value) {
     m_mapConfigurationValues[key] = value;
@@ -133,24 +158,80 @@ class ECSystemManager {
   void RunLoop();
   std::atomic<bool> m_bIsRunning{false};
   std::atomic<bool> m_bSpawnedThreadFinished{false};
-  void ExecuteOnMainThread(float elapsedTime);
+  void ExecuteOnMainThread();
+
+  // Groups the systems into stages, each stage only depending on earlier
+  // ones. Called with vecSystemsMutex held.
+  void vBuildSchedule();
 
   std::thread filament_api_thread_;
   pthread_t filament_api_thread_id_{};
   std::unique_ptr<asio::io_context> io_context_;
   asio::executor_work_guard<decltype(io_context_->get_executor())> work_;
   std::unique_ptr<asio::io_context::strand> strand_;
+  std::unique_ptr<asio::thread_pool> asset_io_pool_;
   std::thread loopThread_;
 
   std::atomic<bool> isHandlerExecuting{false};
 
+  std::mutex loopMutex;
+  std::condition_variable loopCondition;
+  // steady_clock time of the last frame callback, in nanoseconds.
+  std::atomic<int64_t> m_nLastFrameCallbackTime{0};
+  // Only touched on the Filament API thread.
+  std::chrono::steady_clock::time_point m_tpLastUpdate;
+
   std::vector<std::shared_ptr<ECSystem>> m_vecSystems;
+  // Systems grouped by vBuildSchedule; stages, and the systems within each,
+  // are updated one after another on the Filament API thread, so this only
+  // fixes the update order.
+  std::vector<std::vector<std::shared_ptr<ECSystem>>> m_vecStages;
+  bool m_bScheduleDirty = true;
 
   std::mutex vecSystemsMutex;
 
   std::map<std::string, std::any> m_mapConfigurationValues;
 
-  std::map<std::string, int> m_mapOffThreadCallers;
+  // Call sites already warned about, keyed by the address of their where
+  // string (normally __FUNCTION__). Open addressing, filled lock-free; sized
+  // well above the number of poGetSystemAs / poGetSystem call sites.
+  static constexpr size_t kOffThreadCallerSlots = 256;
+  std::array<std::atomic<const char*>, kOffThreadCallerSlots>
+      m_aOffThreadCallers{};
+
+  // Note we should have a 'log once' base functionality in common
+  void vLogOffThreadCaller(const char* where);
+
+  // One slot per system type; set with vecSystemsMutex held.
+  template <typename T>
+  static inline std::atomic<T*> m_poSystemByType{nullptr};
+
+  // Clear the type slots of a system when it is removed.
+  std::map<ECSystem*, std::vector<void (*)()>> m_mapSystemSlotResets;
+
+  // Called with vecSystemsMutex held.
+  template <typename T>
+  void vCacheSystem(T* system) {
+    m_poSystemByType<T>.store(system, std::memory_order_release);
+    m_mapSystemSlotResets[system].push_back(
+        [] { m_poSystemByType<T>.store(nullptr, std::memory_order_release); });
+  }
+
+  // Finds a system that was not added by its static type.
+  template <typename Target>
+  Target* poResolveSystem() {
+    std::unique_lock lock(vecSystemsMutex);
+    for (const auto& system : m_vecSystems) {
+      if (system->GetTypeID() != Target::StaticGetTypeID()) {
+        continue;
+      }
+      if (const auto typedSystem = dynamic_cast<Target*>(system.get())) {
+        vCacheSystem(typedSystem);
+        return typedSystem;
+      }
+    }
+    return nullptr;  // If no matching system found
+  }
 
   RunState m_eCurrentState;
 };
@@ -17,14 +17,24 @@
 
 #include "ecs_message_types.h"
 
-#include <any>
-#include <iostream>
+#include <core/include/literals.h>
+#include <core/scene/geometry/ray.h>
+#include <encodable_value.h>
+#include <math/vec3.h>
+#include <math/vec4.h>
+#include <array>
+#include <cstdint>
 #include <stdexcept>
+#include <string>
 #include <typeinfo>
-#include <unordered_map>
+#include <variant>
+
+struct FlutterDesktopEngineState;
 
 namespace plugin_filament_view {
 
+class Camera;
+
 struct EnumClassHash {
   template <typename T>
   std::size_t operator()(T t) const {
@@ -32,36 +42,86 @@ struct EnumClassHash {
   }
 };
 
+// Every type a message can carry. Values are stored inline, so only strings
+// and maps allocate.
+using ECSMessageValue = std::variant<std::monostate,
+                                     bool,
+                                     int32_t,
+                                     uint32_t,
+                                     // size_t is one of these two
+                                     uint64_t,
+                                     float,
+                                     double,
+                                     std::string,
+                                     ::filament::math::float3,
+                                     ::filament::math::float4,
+                                     Ray,
+                                     CollisionEventType,
+                                     flutter::EncodableMap,
+                                     Camera*,
+                                     FlutterDesktopEngineState*>;
+
 // Message class that can hold variable data amounts
 class ECSMessage {
  public:
+  static constexpr size_t kMaxEntries = 6;
+
   // Add data to the message
   template <typename T>
   void addData(ECSMessageType type, const T& value) {
-    data_[type] = value;
+    for (size_t i = 0; i < count_; i++) {
+      if (entries_[i].type == type) {
+        entries_[i].value.template emplace<T>(value);
+        return;
+      }
+    }
+    if (count_ == kMaxEntries) {
+      throw std::runtime_error("Too many entries in message");
+    }
+    entries_[count_].type = type;
+    entries_[count_].value.template emplace<T>(value);
+    count_++;
   }
 
   // Get data from the message
   template <typename T>
   T getData(ECSMessageType type) const {
-    auto it = data_.find(type);
-    if (it != data_.end()) {
-      try {
-        return std::any_cast<T>(it->second);
-      } catch (const std::bad_any_cast& e) {
-        throw std::runtime_error("Type mismatch for key. Expected type: " +
-                                 std::string(typeid(T).name()));
+    for (size_t i = 0; i < count_; i++) {
+      if (entries_[i].type != type) {
+        continue;
       }
+      if (const auto* value = std::get_if<T>(&entries_[i].value)) {
+        return *value;
+      }
+      throw std::runtime_error("Type mismatch for key. Expected type: " +
+                               std::string(typeid(T).name()));
     }
     throw std::runtime_error("Message type not found");
   }
 
   // Check if the message contains a specific type
   [[nodiscard]] bool hasData(ECSMessageType type) const {
-    return data_.find(type) != data_.end();
+    for (size_t i = 0; i < count_; i++) {
+      if (entries_[i].type == type) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Types held by the message, in the order they were added.
+  [[nodiscard]] size_t nGetEntryCount() const { return count_; }
+  [[nodiscard]] ECSMessageType eGetEntryType(size_t index) const {
+    return entries_[index].type;
   }
 
  private:
-  std::unordered_map<ECSMessageType, std::any, EnumClassHash> data_;
+  struct Entry {
+    ECSMessageType type{};
+    ECSMessageValue value;
+  };
+
+  std::array<Entry, kMaxEntries> entries_;
+  size_t count_ = 0;
 };
 }  // namespace plugin_filament_view
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "ecs_message.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+namespace plugin_filament_view {
+
+// Lock-free multi producer, single consumer queue of messages for one
+// system. Messages are copied into preallocated cells; a burst that does
+// not fit spills into a mutex guarded queue instead of being dropped.
+class ECSMessageQueue {
+ public:
+  // Must be a power of two.
+  static constexpr size_t kCapacity = 64;
+
+  ECSMessageQueue() {
+    for (size_t i = 0; i < kCapacity; i++) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Disallow copy and assign.
+  ECSMessageQueue(const ECSMessageQueue&) = delete;
+  ECSMessageQueue& operator=(const ECSMessageQueue&) = delete;
+
+  // Callable from any thread.
+  void vPush(const ECSMessage& msg) {
+    // Once spilled, later messages follow until the consumer catches up, so
+    // each producer's messages stay in order.
+    if (!overflowing_.load(std::memory_order_acquire) && bTryPush(msg)) {
+      return;
+    }
+    std::unique_lock lock(overflowMutex_);
+    overflow_.push(msg);
+    overflowing_.store(true, std::memory_order_release);
+  }
+
+  // Moves every queued message to the end of out. Only called by the owning
+  // system.
+  void vPopAll(std::vector<ECSMessage>& out) {
+    while (true) {
+      Cell& cell = cells_[dequeuePos_ & (kCapacity - 1)];
+      if (cell.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+        break;
+      }
+      out.push_back(std::move(cell.message));
+      cell.sequence.store(dequeuePos_ + kCapacity, std::memory_order_release);
+      dequeuePos_++;
+    }
+
+    if (overflowing_.load(std::memory_order_acquire)) {
+      std::unique_lock lock(overflowMutex_);
+      while (!overflow_.empty()) {
+        out.push_back(std::move(overflow_.front()));
+        overflow_.pop();
+      }
+      overflowing_.store(false, std::memory_order_release);
+    }
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence{};
+    ECSMessage message;
+  };
+
+  bool bTryPush(const ECSMessage& msg) {
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells_[pos & (kCapacity - 1)];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          cell.message = msg;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // Full
+        return false;
+      } else {
+        pos = enqueuePos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::array<Cell, kCapacity> cells_;
+  std::atomic<size_t> enqueuePos_{0};
+  size_t dequeuePos_ = 0;
+
+  std::atomic<bool> overflowing_{false};
+  std::mutex overflowMutex_;
+  std::queue<ECSMessage> overflow_;
+};
+
+}  // namespace plugin_filament_view
@@ -23,6 +23,9 @@ enum class ECSMessageType {
   CollisionRequestRequestor,
   CollisionRequestType,
 
+  PickRequest,
+  PickPointerId,
+
   ViewTargetCreateRequest,
   ViewTargetCreateRequestTop,
   ViewTargetCreateRequestLeft,
@@ -82,6 +85,9 @@ enum class ECSMessageType {
   ToggleVisualForEntity,
   ToggleCollisionForEntity,
   BoolValue,
+
+  // Keep last.
+  ECSMessageTypeCount,
 };
 
 }
\ No newline at end of file
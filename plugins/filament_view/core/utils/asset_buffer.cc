@@ -0,0 +1,143 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "asset_buffer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <plugins/common/common.h>
+
+namespace plugin_filament_view {
+
+namespace {
+// Reads the whole file into memory, for when mmap isn't possible.
+std::vector<uint8_t> ReadAll(const int fd, const size_t size) {
+  std::vector<uint8_t> buffer(size);
+  size_t offset = 0;
+  while (offset < size) {
+    const ssize_t n = pread(fd, buffer.data() + offset, size - offset,
+                            static_cast<off_t>(offset));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return {};
+    }
+    offset += static_cast<size_t>(n);
+  }
+  return buffer;
+}
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////
+AssetBuffer::AssetBuffer(std::vector<uint8_t> buffer)
+    : m_vecOwned(std::move(buffer)),
+      m_pData(m_vecOwned.data()),
+      m_nSize(m_vecOwned.size()) {}
+
+////////////////////////////////////////////////////////////////////////////
+AssetBuffer::~AssetBuffer() {
+  vReset();
+}
+
+////////////////////////////////////////////////////////////////////////////
+AssetBuffer::AssetBuffer(AssetBuffer&& other) noexcept {
+  *this = std::move(other);
+}
+
+////////////////////////////////////////////////////////////////////////////
+AssetBuffer& AssetBuffer::operator=(AssetBuffer&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  vReset();
+  // Moving a vector keeps its storage, so m_pData stays valid either way.
+  m_pvMapping = std::exchange(other.m_pvMapping, nullptr);
+  m_vecOwned = std::move(other.m_vecOwned);
+  m_pData = std::exchange(other.m_pData, nullptr);
+  m_nSize = std::exchange(other.m_nSize, 0);
+  other.m_vecOwned.clear();
+  return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AssetBuffer::vReset() {
+  if (m_pvMapping != nullptr) {
+    munmap(m_pvMapping, m_nSize);
+    m_pvMapping = nullptr;
+  }
+  m_vecOwned.clear();
+  m_pData = nullptr;
+  m_nSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+AssetBuffer AssetBuffer::Map(const std::filesystem::path& path,
+                             const eAccessPattern ePattern) {
+  AssetBuffer result;
+
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    spdlog::error("[{}] Failed to open: {}", path.c_str(), strerror(errno));
+    return result;
+  }
+
+  struct stat st {};
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    spdlog::error("[{}] Empty or unreadable file", path.c_str());
+    close(fd);
+    return result;
+  }
+  const auto size = static_cast<size_t>(st.st_size);
+
+  // Sequential assets are parsed whole right after this, on the Filament
+  // strand. Populate the mapping now so the disk reads happen on the
+  // calling I/O pool thread rather than as page faults during the parse.
+  int flags = MAP_PRIVATE;
+  if (ePattern == eAccessPattern::Sequential) {
+    flags |= MAP_POPULATE;
+  }
+  void* mapping = mmap(nullptr, size, PROT_READ, flags, fd, 0);
+  if (mapping == MAP_FAILED) {
+    spdlog::warn("[{}] mmap failed ({}), reading instead", path.c_str(),
+                 strerror(errno));
+    result = AssetBuffer(ReadAll(fd, size));
+    close(fd);
+    return result;
+  }
+  // The mapping holds its own reference to the file.
+  close(fd);
+
+  // Hints only; failures are harmless.
+  if (ePattern == eAccessPattern::Sequential) {
+    madvise(mapping, size, MADV_SEQUENTIAL);
+  } else {
+    madvise(mapping, size, MADV_RANDOM);
+  }
+
+  result.m_pvMapping = mapping;
+  result.m_pData = static_cast<const uint8_t*>(mapping);
+  result.m_nSize = size;
+  return result;
+}
+
+}  // namespace plugin_filament_view
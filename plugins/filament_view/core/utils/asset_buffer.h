@@ -0,0 +1,71 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace plugin_filament_view {
+
+// Read only bytes of an asset, either a private mapping of the file or an
+// owned heap buffer (downloads, or files that can't be mapped). Lets file
+// assets go straight from the page cache to gltfio / Material::Builder
+// without a heap copy. Move only; the bytes stay valid while it lives.
+class AssetBuffer {
+ public:
+  // How the consumer reads the bytes; passed on to madvise.
+  enum class eAccessPattern {
+    // Parsed front to back once, e.g. GLB, filamat and KTX. The whole file
+    // is read in by Map() itself (MAP_POPULATE), so call it off the
+    // Filament strand and the parse never waits on the disk.
+    Sequential,
+    // Jumped around in, no read ahead.
+    Random,
+  };
+
+  AssetBuffer() = default;
+  explicit AssetBuffer(std::vector<uint8_t> buffer);
+  ~AssetBuffer();
+
+  AssetBuffer(AssetBuffer&& other) noexcept;
+  AssetBuffer& operator=(AssetBuffer&& other) noexcept;
+
+  // Disallow copy and assign.
+  AssetBuffer(const AssetBuffer&) = delete;
+  AssetBuffer& operator=(const AssetBuffer&) = delete;
+
+  // Maps path read only, falling back to reading it if it can't be mapped.
+  // Returns an empty buffer if the file can't be opened or is empty.
+  static AssetBuffer Map(const std::filesystem::path& path,
+                         eAccessPattern ePattern = eAccessPattern::Sequential);
+
+  [[nodiscard]] const uint8_t* data() const { return m_pData; }
+  [[nodiscard]] size_t size() const { return m_nSize; }
+  [[nodiscard]] bool empty() const { return m_nSize == 0; }
+  [[nodiscard]] bool bIsMapped() const { return m_pvMapping != nullptr; }
+
+ private:
+  void vReset();
+
+  void* m_pvMapping = nullptr;
+  std::vector<uint8_t> m_vecOwned;
+  const uint8_t* m_pData = nullptr;
+  size_t m_nSize = 0;
+};
+
+}  // namespace plugin_filament_view
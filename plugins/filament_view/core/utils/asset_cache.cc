@@ -0,0 +1,576 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "asset_cache.h"
+
+#include <curl/curl.h>
+#include <strings.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <plugins/common/common.h>
+
+namespace plugin_filament_view {
+
+namespace {
+
+constexpr char kIndexFile[] = "index";
+constexpr char kIndexHeader[] = "filament_view_asset_cache 1";
+constexpr char kObjectsDir[] = "objects";
+// How stale recency on disk may get; losing it only skews eviction order.
+constexpr auto kIndexSaveInterval = std::chrono::seconds(30);
+// Offline boots shouldn't hang on a dead network before using the cache.
+constexpr long kConnectTimeoutSec = 10;
+// A server that accepts and then stalls would otherwise hold one of the
+// two I/O pool threads forever. Large assets on slow links still finish;
+// only transfers stuck under kLowSpeedLimit bytes/s for this long abort.
+constexpr long kLowSpeedTimeSec = 20;
+constexpr long kLowSpeedLimit = 1;
+
+// FIPS 180-4 SHA-256, only used to name cached objects.
+class Sha256 {
+ public:
+  static std::string szHexDigest(const uint8_t* data, const size_t size) {
+    Sha256 sha;
+    sha.vUpdate(data, size);
+    const auto digest = sha.aFinish();
+
+    static constexpr char kHex[] = "0123456789abcdef";
+    std::string hex(digest.size() * 2, '0');
+    for (size_t i = 0; i < digest.size(); ++i) {
+      hex[2 * i] = kHex[digest[i] >> 4];
+      hex[2 * i + 1] = kHex[digest[i] & 0xf];
+    }
+    return hex;
+  }
+
+ private:
+  static uint32_t Rotr(const uint32_t x, const int n) {
+    return (x >> n) | (x << (32 - n));
+  }
+
+  void vUpdate(const uint8_t* data, size_t size) {
+    m_nLength += size;
+    while (size > 0) {
+      const size_t n = std::min(size, m_aBlock.size() - m_nBlockUsed);
+      memcpy(m_aBlock.data() + m_nBlockUsed, data, n);
+      m_nBlockUsed += n;
+      data += n;
+      size -= n;
+      if (m_nBlockUsed == m_aBlock.size()) {
+        vCompress();
+        m_nBlockUsed = 0;
+      }
+    }
+  }
+
+  std::array<uint8_t, 32> aFinish() {
+    const uint64_t nBits = m_nLength * 8;
+    m_aBlock[m_nBlockUsed++] = 0x80;
+    if (m_nBlockUsed > 56) {
+      std::fill(m_aBlock.begin() + static_cast<ptrdiff_t>(m_nBlockUsed),
+                m_aBlock.end(), 0);
+      vCompress();
+      m_nBlockUsed = 0;
+    }
+    std::fill(m_aBlock.begin() + static_cast<ptrdiff_t>(m_nBlockUsed),
+              m_aBlock.begin() + 56, 0);
+    for (int i = 0; i < 8; ++i) {
+      m_aBlock[63 - i] = static_cast<uint8_t>(nBits >> (8 * i));
+    }
+    vCompress();
+
+    std::array<uint8_t, 32> digest{};
+    for (size_t i = 0; i < 8; ++i) {
+      for (size_t j = 0; j < 4; ++j) {
+        digest[4 * i + j] = static_cast<uint8_t>(m_aState[i] >> (24 - 8 * j));
+      }
+    }
+    return digest;
+  }
+
+  void vCompress() {
+    static constexpr uint32_t k[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+        0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+        0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+        0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+        0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+        0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+        0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+        0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+        0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    uint32_t w[64];
+    for (size_t i = 0; i < 16; ++i) {
+      w[i] = static_cast<uint32_t>(m_aBlock[4 * i]) << 24 |
+             static_cast<uint32_t>(m_aBlock[4 * i + 1]) << 16 |
+             static_cast<uint32_t>(m_aBlock[4 * i + 2]) << 8 |
+             static_cast<uint32_t>(m_aBlock[4 * i + 3]);
+    }
+    for (size_t i = 16; i < 64; ++i) {
+      const uint32_t s0 =
+          Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      const uint32_t s1 =
+          Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = m_aState[0], b = m_aState[1], c = m_aState[2],
+             d = m_aState[3], e = m_aState[4], f = m_aState[5],
+             g = m_aState[6], h = m_aState[7];
+    for (size_t i = 0; i < 64; ++i) {
+      const uint32_t S1 = Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25);
+      const uint32_t ch = (e & f) ^ (~e & g);
+      const uint32_t t1 = h + S1 + ch + k[i] + w[i];
+      const uint32_t S0 = Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22);
+      const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      const uint32_t t2 = S0 + maj;
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+    m_aState[0] += a;
+    m_aState[1] += b;
+    m_aState[2] += c;
+    m_aState[3] += d;
+    m_aState[4] += e;
+    m_aState[5] += f;
+    m_aState[6] += g;
+    m_aState[7] += h;
+  }
+
+  std::array<uint32_t, 8> m_aState = {0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+                                      0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                      0x1f83d9ab, 0x5be0cd19};
+  std::array<uint8_t, 64> m_aBlock{};
+  size_t m_nBlockUsed = 0;
+  uint64_t m_nLength = 0;
+};
+
+// $XDG_CACHE_HOME/filament_view, falling back to ~/.cache, then /tmp.
+std::filesystem::path DefaultRoot() {
+  if (const char* xdg = getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+    return std::filesystem::path(xdg) / "filament_view";
+  }
+  if (const char* home = getenv("HOME"); home && *home) {
+    return std::filesystem::path(home) / ".cache" / "filament_view";
+  }
+  return std::filesystem::temp_directory_path() / "filament_view_cache";
+}
+
+// The index is tab separated, one entry per line.
+bool bIsIndexSafe(const std::string& value) {
+  return value.find_first_of("\t\r\n") == std::string::npos;
+}
+
+size_t BodyWriter(const char* data,
+                  const size_t size,
+                  const size_t num_mem_block,
+                  std::vector<uint8_t>* body) {
+  const auto* u_data = reinterpret_cast<const uint8_t*>(data);
+  body->insert(body->end(), u_data, u_data + size * num_mem_block);
+  return size * num_mem_block;
+}
+
+// Keeps the validators of the last response; earlier ones belong to
+// redirects.
+size_t HeaderWriter(const char* data,
+                    const size_t size,
+                    const size_t num_items,
+                    void* user_data) {
+  auto* headers = static_cast<std::pair<std::string, std::string>*>(user_data);
+  const size_t length = size * num_items;
+  std::string_view line(data, length);
+
+  if (line.rfind("HTTP/", 0) == 0) {
+    headers->first.clear();
+    headers->second.clear();
+    return length;
+  }
+
+  const auto colon = line.find(':');
+  if (colon == std::string_view::npos) {
+    return length;
+  }
+  const auto name = line.substr(0, colon);
+  auto value = line.substr(colon + 1);
+  while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+    value.remove_prefix(1);
+  }
+  while (!value.empty() && (value.back() == '\r' || value.back() == '\n' ||
+                            value.back() == ' ')) {
+    value.remove_suffix(1);
+  }
+
+  if (name.size() == 4 && strncasecmp(name.data(), "etag", 4) == 0) {
+    headers->first = value;
+  } else if (name.size() == 13 &&
+             strncasecmp(name.data(), "last-modified", 13) == 0) {
+    headers->second = value;
+  }
+  return length;
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////
+AssetCache& AssetCache::GetInstance() {
+  static AssetCache instance(DefaultRoot());
+  return instance;
+}
+
+////////////////////////////////////////////////////////////////////////////
+AssetCache::AssetCache(std::filesystem::path root) : m_oRoot(std::move(root)) {
+  curl_global_init(CURL_GLOBAL_DEFAULT);
+
+  std::error_code ec;
+  std::filesystem::create_directories(m_oRoot / kObjectsDir, ec);
+  if (ec) {
+    spdlog::error("[AssetCache] Can't create {}: {}", m_oRoot.c_str(),
+                  ec.message());
+  }
+
+  std::lock_guard lock(m_mutex);
+  vLoadIndex();
+  spdlog::debug("[AssetCache] {} entries, {} bytes in {}", m_mapEntries.size(),
+                m_nTotalBytes, m_oRoot.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////
+AssetCache::~AssetCache() {
+  std::lock_guard lock(m_mutex);
+  if (m_bIndexDirty) {
+    vSaveIndex();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+AssetBuffer AssetCache::Fetch(const std::string& url) {
+  Entry cached;
+  bool bCached = false;
+  {
+    std::lock_guard lock(m_mutex);
+    if (const auto it = m_mapEntries.find(url); it != m_mapEntries.end()) {
+      cached = it->second;
+      bCached = true;
+    }
+  }
+
+  Response response;
+  const bool bReached =
+      bDownload(url, bCached ? &cached : nullptr, response);
+
+  if (bReached && response.nStatus == 200 && !response.vecBody.empty()) {
+    vStore(url, response);
+    return AssetBuffer(std::move(response.vecBody));
+  }
+
+  if (bCached) {
+    if (!bReached || response.nStatus != 304) {
+      spdlog::warn("[AssetCache] {} unavailable (HTTP {}), using cached copy",
+                   url, response.nStatus);
+    }
+    auto buffer = oMapCached(url);
+    if (!buffer.empty()) {
+      return buffer;
+    }
+    // Evicted meanwhile; the next Fetch downloads it again.
+  }
+
+  if (bReached) {
+    spdlog::error("[AssetCache] {} returned HTTP {}", url, response.nStatus);
+  }
+  return {};
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AssetCache::vSetMaxBytes(const size_t nMaxBytes) {
+  std::lock_guard lock(m_mutex);
+  m_nMaxBytes = nMaxBytes;
+  if (m_nTotalBytes > m_nMaxBytes) {
+    vEvictOverLimit();
+    vSaveIndex();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+bool AssetCache::bDownload(const std::string& url,
+                           const Entry* cached,
+                           Response& response) {
+  CURL* curl = curl_easy_init();
+  if (curl == nullptr) {
+    spdlog::error("[AssetCache] Failed to create CURL connection");
+    return false;
+  }
+
+  curl_slist* headers = nullptr;
+  if (cached != nullptr) {
+    if (!cached->szETag.empty()) {
+      headers = curl_slist_append(
+          headers, ("If-None-Match: " + cached->szETag).c_str());
+    }
+    if (!cached->szLastModified.empty()) {
+      headers = curl_slist_append(
+          headers, ("If-Modified-Since: " + cached->szLastModified).c_str());
+    }
+  }
+
+  std::pair<std::string, std::string> validators;
+  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+  curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, kConnectTimeoutSec);
+  curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, kLowSpeedLimit);
+  curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, kLowSpeedTimeSec);
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, BodyWriter);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.vecBody);
+  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderWriter);
+  curl_easy_setopt(curl, CURLOPT_HEADERDATA, &validators);
+
+  const CURLcode code = curl_easy_perform(curl);
+  if (code == CURLE_OK) {
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.nStatus);
+  } else {
+    spdlog::warn("[AssetCache] Fetching {} failed: {}", url,
+                 curl_easy_strerror(code));
+  }
+  curl_slist_free_all(headers);
+  curl_easy_cleanup(curl);
+
+  response.szETag = std::move(validators.first);
+  response.szLastModified = std::move(validators.second);
+  return code == CURLE_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AssetCache::vStore(const std::string& url, const Response& response) {
+  if (!bIsIndexSafe(url)) {
+    return;
+  }
+
+  const auto& body = response.vecBody;
+  const std::string szObject = Sha256::szHexDigest(body.data(), body.size());
+  const auto path = oObjectPath(szObject);
+
+  // Held across the write so eviction can't remove an object we are about
+  // to point at.
+  std::lock_guard lock(m_mutex);
+
+  if (m_mapObjectRefs.find(szObject) == m_mapObjectRefs.end()) {
+    std::ostringstream tmpName;
+    tmpName << szObject << ".tmp." << std::this_thread::get_id();
+    const auto tmp = path.parent_path() / tmpName.str();
+    {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      out.write(reinterpret_cast<const char*>(body.data()),
+                static_cast<std::streamsize>(body.size()));
+      if (!out) {
+        spdlog::warn("[AssetCache] Can't write {}", tmp.c_str());
+        std::error_code ec;
+        std::filesystem::remove(tmp, ec);
+        return;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+      spdlog::warn("[AssetCache] Can't store {}: {}", path.c_str(),
+                   ec.message());
+      std::filesystem::remove(tmp, ec);
+      return;
+    }
+  }
+
+  auto& entry = m_mapEntries[url];
+  if (entry.szObject != szObject) {
+    if (!entry.szObject.empty()) {
+      vReleaseObject(entry);
+    }
+    if (m_mapObjectRefs[szObject]++ == 0) {
+      m_nTotalBytes += body.size();
+    }
+  }
+  entry.szObject = szObject;
+  entry.nSize = body.size();
+  entry.nLastUse = ++m_nUseCounter;
+  entry.szETag = bIsIndexSafe(response.szETag) ? response.szETag : "";
+  entry.szLastModified =
+      bIsIndexSafe(response.szLastModified) ? response.szLastModified : "";
+
+  vEvictOverLimit();
+  vSaveIndex();
+}
+
+////////////////////////////////////////////////////////////////////////////
+AssetBuffer AssetCache::oMapCached(const std::string& url) {
+  std::lock_guard lock(m_mutex);
+  const auto it = m_mapEntries.find(url);
+  if (it == m_mapEntries.end()) {
+    return {};
+  }
+
+  auto buffer = AssetBuffer::Map(oObjectPath(it->second.szObject));
+  if (buffer.size() != it->second.nSize) {
+    // Removed or truncated behind our back; forget it.
+    spdlog::warn("[AssetCache] Dropping damaged entry for {}", url);
+    vReleaseObject(it->second);
+    m_mapEntries.erase(it);
+    vSaveIndex();
+    return {};
+  }
+
+  it->second.nLastUse = ++m_nUseCounter;
+  m_bIndexDirty = true;
+  if (std::chrono::steady_clock::now() - m_oLastIndexSave >=
+      kIndexSaveInterval) {
+    vSaveIndex();
+  }
+  return buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AssetCache::vLoadIndex() {
+  std::ifstream in(m_oRoot / kIndexFile);
+  std::string line;
+  if (in && std::getline(in, line) && line == kIndexHeader) {
+    while (std::getline(in, line)) {
+      std::vector<std::string> fields;
+      std::istringstream stream(line);
+      std::string field;
+      while (std::getline(stream, field, '\t')) {
+        fields.push_back(std::move(field));
+      }
+      // Trailing empty validators aren't produced by getline.
+      fields.resize(std::max<size_t>(fields.size(), 6));
+      if (fields.size() != 6) {
+        continue;
+      }
+
+      Entry entry;
+      entry.szObject = fields[1];
+      try {
+        entry.nSize = std::stoull(fields[2]);
+        entry.nLastUse = std::stoull(fields[3]);
+      } catch (...) {
+        continue;
+      }
+      entry.szETag = fields[4];
+      entry.szLastModified = fields[5];
+
+      std::error_code ec;
+      const auto size =
+          std::filesystem::file_size(oObjectPath(entry.szObject), ec);
+      if (ec || size != entry.nSize) {
+        continue;
+      }
+
+      if (m_mapObjectRefs[entry.szObject]++ == 0) {
+        m_nTotalBytes += entry.nSize;
+      }
+      m_nUseCounter = std::max(m_nUseCounter, entry.nLastUse);
+      m_mapEntries[fields[0]] = std::move(entry);
+    }
+  }
+
+  // Drop objects nothing points at, e.g. left by a crash mid-write.
+  std::error_code ec;
+  for (const auto& file :
+       std::filesystem::directory_iterator(m_oRoot / kObjectsDir, ec)) {
+    if (m_mapObjectRefs.find(file.path().filename().string()) ==
+        m_mapObjectRefs.end()) {
+      std::filesystem::remove(file.path(), ec);
+    }
+  }
+
+  vEvictOverLimit();
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AssetCache::vSaveIndex() {
+  m_oLastIndexSave = std::chrono::steady_clock::now();
+  m_bIndexDirty = false;
+
+  const auto path = m_oRoot / kIndexFile;
+  auto tmp = path;
+  tmp += ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::trunc);
+    out << kIndexHeader << '\n';
+    for (const auto& [url, entry] : m_mapEntries) {
+      out << url << '\t' << entry.szObject << '\t' << entry.nSize << '\t'
+          << entry.nLastUse << '\t' << entry.szETag << '\t'
+          << entry.szLastModified << '\n';
+    }
+    if (!out) {
+      spdlog::warn("[AssetCache] Can't write {}", tmp.c_str());
+      return;
+    }
+  }
+  // Rename so a crash never leaves a half written index.
+  std::error_code ec;
+  std::filesystem::rename(tmp, path, ec);
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AssetCache::vEvictOverLimit() {
+  while (m_nTotalBytes > m_nMaxBytes && !m_mapEntries.empty()) {
+    auto oldest = m_mapEntries.begin();
+    for (auto it = m_mapEntries.begin(); it != m_mapEntries.end(); ++it) {
+      if (it->second.nLastUse < oldest->second.nLastUse) {
+        oldest = it;
+      }
+    }
+    spdlog::debug("[AssetCache] Evicting {}", oldest->first);
+    vReleaseObject(oldest->second);
+    m_mapEntries.erase(oldest);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+void AssetCache::vReleaseObject(const Entry& entry) {
+  const auto it = m_mapObjectRefs.find(entry.szObject);
+  if (it == m_mapObjectRefs.end() || --it->second > 0) {
+    return;
+  }
+  m_mapObjectRefs.erase(it);
+  m_nTotalBytes -= entry.nSize;
+  // Open mappings keep their pages; only the name goes away.
+  std::error_code ec;
+  std::filesystem::remove(oObjectPath(entry.szObject), ec);
+}
+
+////////////////////////////////////////////////////////////////////////////
+std::filesystem::path AssetCache::oObjectPath(
+    const std::string& szObject) const {
+  return m_oRoot / kObjectsDir / szObject;
+}
+
+}  // namespace plugin_filament_view
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "asset_buffer.h"
+
+namespace plugin_filament_view {
+
+// Persistent disk cache shared by every URL loader (materials, skyboxes,
+// GLB models), so a cold boot doesn't download the same assets again and
+// loading keeps working offline.
+//
+// Bodies are stored once under objects/ named by the SHA-256 of their
+// bytes; an index maps each URL to its object plus the ETag and
+// Last-Modified validators the server sent. Cached URLs are revalidated
+// with a conditional GET on every fetch; when the server can't be reached
+// the cached copy is used as is. Total object size is kept under a limit
+// by dropping least recently used URLs.
+//
+// Fetch blocks on the network and the disk, so only call it from
+// ECSystemManager::GetAssetIOPool().
+class AssetCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 256 * 1024 * 1024;
+
+  static AssetCache& GetInstance();
+
+  // A cache rooted at root. The plugin shares GetInstance(); this is for
+  // tests and tools that need their own directory.
+  explicit AssetCache(std::filesystem::path root);
+
+  // Writes out recency from hits not saved yet.
+  ~AssetCache();
+
+  // Returns the body of url, revalidating or downloading it as needed.
+  // Returns an empty buffer if it can't be downloaded and isn't cached.
+  AssetBuffer Fetch(const std::string& url);
+
+  // Evicts right away if the cache is already over the new limit.
+  void vSetMaxBytes(size_t nMaxBytes);
+
+  // Disallow copy and assign.
+  AssetCache(const AssetCache&) = delete;
+  AssetCache& operator=(const AssetCache&) = delete;
+
+ private:
+  struct Entry {
+    std::string szObject;
+    size_t nSize = 0;
+    // Bumped on every hit; lowest goes first when evicting.
+    uint64_t nLastUse = 0;
+    std::string szETag;
+    std::string szLastModified;
+  };
+
+  struct Response {
+    long nStatus = 0;
+    std::vector<uint8_t> vecBody;
+    std::string szETag;
+    std::string szLastModified;
+  };
+
+  // GET url, conditional on the validators of cached when given. Returns
+  // false if no HTTP response came back at all.
+  static bool bDownload(const std::string& url,
+                        const Entry* cached,
+                        Response& response);
+
+  // Writes the body under its digest and points url at it.
+  void vStore(const std::string& url, const Response& response);
+  // Maps the cached body of url and marks it used; empty if it's gone.
+  AssetBuffer oMapCached(const std::string& url);
+
+  // All below expect m_mutex held.
+  void vLoadIndex();
+  void vSaveIndex();
+  void vEvictOverLimit();
+  void vReleaseObject(const Entry& entry);
+  [[nodiscard]] std::filesystem::path oObjectPath(
+      const std::string& szObject) const;
+
+  const std::filesystem::path m_oRoot;
+  std::mutex m_mutex;
+  std::unordered_map<std::string, Entry> m_mapEntries;
+  // Number of URLs pointing at each object; an object can be shared.
+  std::unordered_map<std::string, int> m_mapObjectRefs;
+  size_t m_nTotalBytes = 0;
+  size_t m_nMaxBytes = kDefaultMaxBytes;
+  uint64_t m_nUseCounter = 0;
+  // Cache hits only bump nLastUse in memory; the index is rewritten on
+  // store and evict, at most every kIndexSaveInterval on hits, and on exit.
+  bool m_bIndexDirty = false;
+  std::chrono::steady_clock::time_point m_oLastIndexSave =
+      std::chrono::steady_clock::now();
+};
+
+}  // namespace plugin_filament_view
@@ -102,7 +102,7 @@ void EntityTransforms::vApplyScale(const std::shared_ptr<Entity>& poEntity,
                                    const filament::math::float3& scale) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
+          "EntityTransforms");
   const auto engine = filamentSystem->getFilamentEngine();
   vApplyScale(poEntity, scale, engine);
 }
@@ -112,7 +112,7 @@ void EntityTransforms::vApplyRotation(const std::shared_ptr<Entity>& poEntity,
                                       const filament::math::quatf& rotation) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
+          "EntityTransforms");
   const auto engine = filamentSystem->getFilamentEngine();
   vApplyRotation(poEntity, rotation, engine);
 }
@@ -123,7 +123,7 @@ void EntityTransforms::vApplyTranslate(
     const filament::math::float3& translation) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
+          "EntityTransforms");
   const auto engine = filamentSystem->getFilamentEngine();
   vApplyTranslate(poEntity, translation, engine);
 }
@@ -133,19 +133,14 @@ void EntityTransforms::vApplyTransform(const std::shared_ptr<Entity>& poEntity,
                                        const filament::math::mat4f& transform) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
+          "EntityTransforms");
   const auto engine = filamentSystem->getFilamentEngine();
   vApplyTransform(poEntity, transform, engine);
 }
 
 ////////////////////////////////////////////////////////////////////////////
-void EntityTransforms::vApplyTransform(const std::shared_ptr<Entity>& poEntity,
-                                       const BaseTransform& transform) {
-  const auto filamentSystem =
-      ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
-  const auto engine = filamentSystem->getFilamentEngine();
-
+filament::math::mat4f EntityTransforms::oCalculateTransform(
+    const BaseTransform& transform) {
   // Create the rotation, scaling, and translation matrices
   const auto rotationMatrix = QuaternionToMat4f(transform.GetRotation());
   const auto scalingMatrix =
@@ -157,6 +152,19 @@ void EntityTransforms::vApplyTransform(const std::shared_ptr<Entity>& poEntity,
   const auto combinedTransform =
       translationMatrix * rotationMatrix * scalingMatrix;
 
+  return combinedTransform;
+}
+
+////////////////////////////////////////////////////////////////////////////
+void EntityTransforms::vApplyTransform(const std::shared_ptr<Entity>& poEntity,
+                                       const BaseTransform& transform) {
+  const auto filamentSystem =
+      ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
+          "EntityTransforms");
+  const auto engine = filamentSystem->getFilamentEngine();
+
+  const auto combinedTransform = oCalculateTransform(transform);
+
   vApplyTransform(poEntity, combinedTransform, engine);
 }
 
@@ -168,7 +176,7 @@ void EntityTransforms::vApplyTransform(
     const filament::math::float3& translation) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
+          "EntityTransforms");
   const auto engine = filamentSystem->getFilamentEngine();
   vApplyTransform(poEntity, rotation, scale, translation, engine);
 }
@@ -178,7 +186,7 @@ void EntityTransforms::vApplyShear(const std::shared_ptr<Entity>& poEntity,
                                    const filament::math::float3& shear) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
+          "EntityTransforms");
   const auto engine = filamentSystem->getFilamentEngine();
   vApplyShear(poEntity, shear, engine);
 }
@@ -188,7 +196,7 @@ void EntityTransforms::vResetTransform(
     const std::shared_ptr<Entity>& poEntity) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
+          "EntityTransforms");
   const auto engine = filamentSystem->getFilamentEngine();
   vResetTransform(poEntity, engine);
 }
@@ -198,7 +206,7 @@ filament::math::mat4f EntityTransforms::oGetCurrentTransform(
     const std::shared_ptr<Entity>& poEntity) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
+          "EntityTransforms");
   const auto engine = filamentSystem->getFilamentEngine();
   return oGetCurrentTransform(poEntity, engine);
 }
@@ -209,7 +217,7 @@ void EntityTransforms::vApplyLookAt(const std::shared_ptr<Entity>& poEntity,
                                     const filament::math::float3& up) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
+          "EntityTransforms");
   const auto engine = filamentSystem->getFilamentEngine();
   vApplyLookAt(poEntity, target, up, engine);
 }
@@ -416,16 +424,7 @@ void EntityTransforms::vApplyTransform(
 
   const auto ei = transformManager.getInstance(entityToWorkWith);
 
-  // Create the rotation, scaling, and translation matrices
-  const auto rotationMatrix = QuaternionToMat4f(transform.GetRotation());
-  const auto scalingMatrix =
-      filament::math::mat4f::scaling(transform.GetScale());
-  const auto translationMatrix =
-      filament::math::mat4f::translation(transform.GetCenterPosition());
-
-  // Combine the transformations: translate * rotate * scale
-  const auto combinedTransform =
-      translationMatrix * rotationMatrix * scalingMatrix;
+  const auto combinedTransform = oCalculateTransform(transform);
 
   // Set the combined transform back to the entity
   transformManager.setTransform(ei, combinedTransform);
@@ -437,7 +436,7 @@ void EntityTransforms::vApplyTransform(
     const BaseTransform& transform) {
   const auto filamentSystem =
       ECSystemManager::GetInstance()->poGetSystemAs<FilamentSystem>(
-          FilamentSystem::StaticGetTypeID(), "EntityTransforms");
+          "EntityTransforms");
   const auto engine = filamentSystem->getFilamentEngine();
 
   vApplyTransform(oModelAsset, transform, engine);
@@ -42,6 +42,10 @@ class EntityTransforms {
   static filament::math::mat3f identity3x3();
   static filament::math::mat4f identity4x4();
 
+  // translate * rotate * scale of a BaseTransform.
+  static filament::math::mat4f oCalculateTransform(
+      const BaseTransform& transform);
+
   // Utility function to create a shear matrix and apply it to a mat4f
   static filament::math::mat4f oApplyShear(
       const filament::math::mat4f& matrix,
@@ -70,23 +70,40 @@ Texture* HDRLoader::createTextureFromImage(Engine* engine, LinearImage* image) {
   return texture;
 }
 
+////////////////////////////////////////////////////////////////////////////
+LinearImage* HDRLoader::decodeImage(const std::string& asset_path,
+                                    const std::string& name) {
+  SPDLOG_DEBUG("Loading {}", asset_path.c_str());
+  std::ifstream ins(asset_path, std::ios::binary);
+  return new LinearImage(ImageDecoder::decode(ins, name));
+}
+
+////////////////////////////////////////////////////////////////////////////
+LinearImage* HDRLoader::decodeImage(const std::vector<uint8_t>& buffer,
+                                    const std::string& name) {
+  return decodeImage(buffer.data(), buffer.size(), name);
+}
+
+////////////////////////////////////////////////////////////////////////////
+LinearImage* HDRLoader::decodeImage(const uint8_t* data,
+                                    const size_t size,
+                                    const std::string& name) {
+  const std::string str(reinterpret_cast<const char*>(data), size);
+  std::istringstream ins(str);
+  return new LinearImage(ImageDecoder::decode(ins, name));
+}
+
 ////////////////////////////////////////////////////////////////////////////
 Texture* HDRLoader::createTexture(Engine* engine,
                                   const std::string& asset_path,
                                   const std::string& name) {
-  SPDLOG_DEBUG("Loading {}", asset_path.c_str());
-  std::ifstream ins(asset_path, std::ios::binary);
-  auto* image = new LinearImage(ImageDecoder::decode(ins, name));
-  return createTextureFromImage(engine, image);
+  return createTextureFromImage(engine, decodeImage(asset_path, name));
 }
 
 ////////////////////////////////////////////////////////////////////////////
 Texture* HDRLoader::createTexture(Engine* engine,
                                   const std::vector<uint8_t>& buffer,
                                   const std::string& name) {
-  const std::string str(buffer.begin(), buffer.end());
-  std::istringstream ins(str);
-  auto* image = new LinearImage(ImageDecoder::decode(ins, name));
-  return createTextureFromImage(engine, image);
+  return createTextureFromImage(engine, decodeImage(buffer, name));
 }
-}  // namespace plugin_filament_view
\ No newline at end of file
+}  // namespace plugin_filament_view
@@ -35,12 +35,29 @@ class HDRLoader {
       const std::vector<uint8_t>& buffer,
       const std::string& name = "memory.hdr");
 
- private:
-  static ::filament::Texture* deleteImageAndLogError(
-      const image::LinearImage* image);
+  // Decoding doesn't touch the Engine, so it can run off the Filament API
+  // thread; hand the result to createTextureFromImage on it. The caller owns
+  // the returned image until then.
+  static image::LinearImage* decodeImage(
+      const std::string& asset_path,
+      const std::string& name = "memory.hdr");
+
+  static image::LinearImage* decodeImage(
+      const std::vector<uint8_t>& buffer,
+      const std::string& name = "memory.hdr");
+
+  static image::LinearImage* decodeImage(
+      const uint8_t* data,
+      size_t size,
+      const std::string& name = "memory.hdr");
 
+  // Takes ownership of image.
   static ::filament::Texture* createTextureFromImage(::filament::Engine* engine,
                                                      image::LinearImage* image);
+
+ private:
+  static ::filament::Texture* deleteImageAndLogError(
+      const image::LinearImage* image);
 };
 
 }  // namespace plugin_filament_view
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Builds an AabbTree over 10k random boxes, moves and reinserts some, then
+// casts rays through it and through a linear scan of the same boxes, the
+// way CollisionSystem queried collidables before the tree.
+//
+//   aabb_tree_bench [boxes] [rays]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <core/scene/geometry/aabb_tree.h>
+
+using filament::math::float3;
+using plugin_filament_view::Aabb;
+using plugin_filament_view::AabbTree;
+using plugin_filament_view::EntityObject;
+
+namespace {
+
+struct Box {
+  float3 center;
+  float halfSize;
+
+  [[nodiscard]] Aabb oAabb() const {
+    const float3 half = {halfSize, halfSize, halfSize};
+    return {center - half, center + half};
+  }
+};
+
+struct Ray {
+  float3 origin;
+  float3 direction;
+  float3 invDir;
+};
+
+// The tree hands leaves back as EntityObject*; here they point at a Box.
+EntityObject* poAsEntity(Box& box) {
+  return reinterpret_cast<EntityObject*>(&box);
+}
+
+const Box& oAsBox(const EntityObject* entity) {
+  return *reinterpret_cast<const Box*>(entity);
+}
+
+// Same exact test for both paths, so only the traversal differs.
+bool bHit(const Box& box, const Ray& ray, float& t) {
+  t = box.oAabb().fRayEntry(ray.origin, ray.invDir);
+  return t > 0.0f;
+}
+
+double fMicrosPer(const std::chrono::steady_clock::time_point start,
+                  const size_t count) {
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::micro>(elapsed).count() /
+         static_cast<double>(count);
+}
+
+}  // namespace
+
+int main(const int argc, char** argv) {
+  const size_t nBoxes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+  const size_t nRays = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> size(0.2f, 2.0f);
+  std::uniform_real_distribution<float> nudge(-0.05f, 0.05f);
+
+  std::vector<Box> boxes(nBoxes);
+  for (auto& box : boxes) {
+    box = {{position(rng), position(rng), position(rng)}, size(rng)};
+  }
+
+  AabbTree tree;
+  std::vector<int32_t> leaves(nBoxes);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < nBoxes; ++i) {
+    leaves[i] = tree.nInsert(boxes[i].oAabb(), poAsEntity(boxes[i]));
+  }
+  std::printf("build     %8.3f us/insert   %zu boxes, height %d\n",
+              fMicrosPer(start, nBoxes), nBoxes, tree.nGetHeight());
+
+  // Small moves mostly stay inside the fat boxes.
+  const size_t nMoves = nBoxes * 2;
+  start = std::chrono::steady_clock::now();
+  for (size_t k = 0; k < nMoves; ++k) {
+    Box& box = boxes[rng() % nBoxes];
+    box.center = box.center + float3{nudge(rng), nudge(rng), nudge(rng)};
+    tree.bMove(leaves[&box - boxes.data()], box.oAabb());
+  }
+  std::printf("move      %8.3f us/move     height %d\n",
+              fMicrosPer(start, nMoves), tree.nGetHeight());
+
+  std::vector<Ray> rays(nRays);
+  for (auto& ray : rays) {
+    float3 direction = {position(rng), position(rng), position(rng)};
+    direction = direction * (1.0f / std::sqrt(dot(direction, direction)));
+    ray = {{position(rng), position(rng), position(rng)},
+           direction,
+           {1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z}};
+  }
+
+  size_t nTreeHits = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto& ray : rays) {
+    tree.vRaycast(
+        ray.origin, ray.direction,
+        [&](const EntityObject* entity, float& t) {
+          return bHit(oAsBox(entity), ray, t);
+        },
+        [&](EntityObject*, float) {
+          ++nTreeHits;
+          return true;
+        });
+  }
+  std::printf("all hits  %8.3f us/ray      tree\n", fMicrosPer(start, nRays));
+
+  start = std::chrono::steady_clock::now();
+  for (const auto& ray : rays) {
+    tree.vRaycast(
+        ray.origin, ray.direction,
+        [&](const EntityObject* entity, float& t) {
+          return bHit(oAsBox(entity), ray, t);
+        },
+        [](EntityObject*, float) { return false; });
+  }
+  std::printf("nearest   %8.3f us/ray      tree\n", fMicrosPer(start, nRays));
+
+  size_t nScanHits = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto& ray : rays) {
+    for (const auto& box : boxes) {
+      if (float t; bHit(box, ray, t)) {
+        ++nScanHits;
+      }
+    }
+  }
+  std::printf("all hits  %8.3f us/ray      linear scan\n",
+              fMicrosPer(start, nRays));
+
+  if (nTreeHits != nScanHits) {
+    std::fprintf(stderr, "hit count mismatch: tree %zu, scan %zu\n",
+                 nTreeHits, nScanHits);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 Toyota Connected North America
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""Local HTTP stand-in for asset_cache_test.
+
+Serves a few fixed assets with ETag and Last-Modified validators and
+answers conditional GETs with 304. Listens on an ephemeral port and prints
+it on the first line of stdout.
+
+  /a /b /c   assets ("abc", 100 x "x", 100 x "y")
+  /change    replaces /a with "abcd"
+  /counts    "<200 responses> <304 responses>" for asset requests
+"""
+
+import hashlib
+import http.server
+import sys
+
+ASSETS = {"/a": b"abc", "/b": b"x" * 100, "/c": b"y" * 100}
+COUNTS = {200: 0, 304: 0}
+LAST_MODIFIED = "Wed, 21 Oct 2015 07:28:00 GMT"
+
+
+class Handler(http.server.BaseHTTPRequestHandler):
+    def log_message(self, *args):
+        pass
+
+    def reply(self, status, body=b"", headers=()):
+        self.send_response(status)
+        for name, value in headers:
+            self.send_header(name, value)
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def do_GET(self):
+        if self.path == "/change":
+            ASSETS["/a"] = b"abcd"
+            self.reply(200)
+            return
+        if self.path == "/counts":
+            self.reply(200, f"{COUNTS[200]} {COUNTS[304]}".encode())
+            return
+        if self.path not in ASSETS:
+            self.reply(404)
+            return
+
+        body = ASSETS[self.path]
+        etag = '"%s"' % hashlib.sha1(body).hexdigest()
+        validators = [("ETag", etag), ("Last-Modified", LAST_MODIFIED)]
+        if self.headers.get("If-None-Match") == etag:
+            COUNTS[304] += 1
+            self.send_response(304)
+            for name, value in validators:
+                self.send_header(name, value)
+            self.end_headers()
+            return
+
+        COUNTS[200] += 1
+        self.reply(200, body, validators)
+
+
+def main():
+    server = http.server.ThreadingHTTPServer(("127.0.0.1", 0), Handler)
+    print(server.server_address[1], flush=True)
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
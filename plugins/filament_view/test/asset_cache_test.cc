@@ -0,0 +1,190 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Drives AssetCache against test/asset_cache_http_stand_in.py.
+//
+//   asset_cache_test <python3> <asset_cache_http_stand_in.py> <scratch dir>
+
+#include <curl/curl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <core/utils/asset_cache.h>
+
+using plugin_filament_view::AssetBuffer;
+using plugin_filament_view::AssetCache;
+namespace fs = std::filesystem;
+
+namespace {
+
+int gFailures = 0;
+
+#define CHECK(cond)                                               \
+  do {                                                            \
+    if (!(cond)) {                                                \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, \
+                   __LINE__, #cond);                              \
+      gFailures++;                                                \
+    }                                                             \
+  } while (0)
+
+// sha256 of the stand-in's asset bodies, i.e. their object names.
+constexpr char kShaAbc[] =
+    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+constexpr char kShaAbcd[] =
+    "88d4266fd4e6338d13b845fcf289579d209c897823b9217da3e161936f031589";
+constexpr char kShaB[] =
+    "09ecb6ebc8bcefc733f6f2ec44f791abeed6a99edf0cc31519637898aebd52d8";
+constexpr char kShaC[] =
+    "56846f2db153afa893bd18d0c0bf6e026d9cd3fa0bfa941976b17ff14d3e217a";
+
+struct StandIn {
+  pid_t pid = -1;
+  std::string base;
+};
+
+// Starts the stand-in and reads the port it printed.
+bool bStartStandIn(const char* python, const char* script, StandIn& out) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  const pid_t pid = fork();
+  if (pid == 0) {
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[0]);
+    close(fds[1]);
+    execlp(python, python, script, static_cast<char*>(nullptr));
+    _exit(127);
+  }
+  close(fds[1]);
+  FILE* stdout_pipe = fdopen(fds[0], "r");
+  int port = 0;
+  const bool ok = pid > 0 && std::fscanf(stdout_pipe, "%d", &port) == 1;
+  std::fclose(stdout_pipe);
+  out.pid = pid;
+  out.base = "http://127.0.0.1:" + std::to_string(port);
+  return ok;
+}
+
+void vStopStandIn(StandIn& stand_in) {
+  if (stand_in.pid > 0) {
+    kill(stand_in.pid, SIGTERM);
+    waitpid(stand_in.pid, nullptr, 0);
+    stand_in.pid = -1;
+  }
+}
+
+size_t Append(const char* data, size_t size, size_t n, std::string* out) {
+  out->append(data, size * n);
+  return size * n;
+}
+
+// Plain GET, bypassing the cache, for the stand-in's control endpoints.
+std::string szGet(const std::string& url) {
+  std::string body;
+  CURL* curl = curl_easy_init();
+  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, Append);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &body);
+  curl_easy_perform(curl);
+  curl_easy_cleanup(curl);
+  return body;
+}
+
+std::string szBody(const AssetBuffer& buffer) {
+  return {reinterpret_cast<const char*>(buffer.data()), buffer.size()};
+}
+
+}  // namespace
+
+int main(const int argc, char** argv) {
+  if (argc != 4) {
+    std::fprintf(stderr, "usage: %s <python3> <stand-in.py> <scratch>\n",
+                 argv[0]);
+    return 2;
+  }
+
+  StandIn stand_in;
+  if (!bStartStandIn(argv[1], argv[2], stand_in)) {
+    std::fprintf(stderr, "could not start %s\n", argv[2]);
+    vStopStandIn(stand_in);
+    return 2;
+  }
+  const std::string& base = stand_in.base;
+
+  const fs::path root = fs::path(argv[3]) / "asset_cache_test";
+  fs::remove_all(root);
+  const fs::path objects = root / "objects";
+
+  {
+    AssetCache cache(root);
+
+    // Cold: downloaded, handed over from memory, stored by digest.
+    const auto first = cache.Fetch(base + "/a");
+    CHECK(szBody(first) == "abc");
+    CHECK(!first.bIsMapped());
+    CHECK(fs::exists(objects / kShaAbc));
+
+    // Warm: revalidated with a 304 and served from the stored object.
+    const auto second = cache.Fetch(base + "/a");
+    CHECK(szBody(second) == "abc");
+    CHECK(second.bIsMapped());
+    CHECK(szGet(base + "/counts") == "1 1");
+
+    CHECK(cache.Fetch(base + "/missing").empty());
+
+    // 3 + 100 + 100 bytes over a 200 byte limit evicts the least recently
+    // used URL, /b.
+    cache.vSetMaxBytes(200);
+    CHECK(cache.Fetch(base + "/b").size() == 100);
+    CHECK(szBody(cache.Fetch(base + "/a")) == "abc");
+    CHECK(cache.Fetch(base + "/c").size() == 100);
+    CHECK(!fs::exists(objects / kShaB));
+    CHECK(fs::exists(objects / kShaAbc));
+    CHECK(fs::exists(objects / kShaC));
+  }
+
+  // Reopened from the index; changed content replaces the old object.
+  szGet(base + "/change");
+  {
+    AssetCache cache(root);
+    CHECK(szBody(cache.Fetch(base + "/a")) == "abcd");
+    CHECK(fs::exists(objects / kShaAbcd));
+    CHECK(!fs::exists(objects / kShaAbc));
+  }
+
+  // Offline: cached URLs still load, uncached ones fail.
+  vStopStandIn(stand_in);
+  {
+    AssetCache cache(root);
+    CHECK(szBody(cache.Fetch(base + "/a")) == "abcd");
+    CHECK(cache.Fetch(base + "/c").size() == 100);
+    CHECK(cache.Fetch(base + "/b").empty());
+  }
+
+  fs::remove_all(root);
+  if (gFailures != 0) {
+    std::fprintf(stderr, "%d check(s) failed\n", gFailures);
+    return 1;
+  }
+  std::printf("asset_cache_test passed\n");
+  return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2020-2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Times ECSystemManager::poGetSystemAs, which loads a per-type atomic slot,
+// against the lookup it replaced: lock, scan the system list by
+// StaticGetTypeID(), then dynamic_pointer_cast, with the caller name passed
+// as a std::string. Runs on the Filament API thread, like real callers, with
+// as many systems registered as the plugin has, then repeats the new lookup
+// from another thread.
+//
+//   system_lookup_bench [lookups]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <utility>
+
+#include <asio/post.hpp>
+#include <core/systems/ecsystems_manager.h>
+
+using plugin_filament_view::ECSystem;
+using plugin_filament_view::ECSystemManager;
+
+namespace {
+
+template <int N>
+class BenchSystem : public ECSystem {
+ public:
+  void vInitSystem() override {}
+  void vUpdate(float /*fElapsedTime*/) override {}
+  void vShutdownSystem() override {}
+  void DebugPrint() override {}
+
+  [[nodiscard]] size_t GetTypeID() const override { return StaticGetTypeID(); }
+
+  // Uncached, as the systems' StaticGetTypeID() are.
+  [[nodiscard]] static size_t StaticGetTypeID() {
+    return typeid(BenchSystem).hash_code();
+  }
+};
+
+template <int... N>
+void vAddSystems(ECSystemManager* manager,
+                 std::integer_sequence<int, N...> /*ids*/) {
+  (manager->vAddSystem(std::make_unique<BenchSystem<N>>()), ...);
+}
+
+// Keeps the compiler from dropping the lookup.
+template <typename T>
+void vKeep(T* pointer) {
+  asm volatile("" : : "r"(pointer) : "memory");
+}
+
+template <typename Fn>
+double fNanosPer(const size_t count, Fn&& fn) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; ++i) {
+    fn();
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(count);
+}
+
+}  // namespace
+
+int main(const int argc, char** argv) {
+  const size_t nLookups =
+      argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+
+  // The plugin registers 12 systems; look up the last one, the worst case
+  // for the scan.
+  constexpr int kSystems = 12;
+  using Target = BenchSystem<kSystems - 1>;
+  // Longer than the small string buffer, like most caller names.
+  constexpr char kWhere[] = "bBuildDebugRepresentation";
+
+  const auto manager = ECSystemManager::GetInstance();
+  std::promise<void> done;
+  asio::post(*manager->GetStrand(), [&] {
+    vAddSystems(manager, std::make_integer_sequence<int, kSystems>());
+
+    const double fSlot = fNanosPer(nLookups, [&] {
+      vKeep(manager->poGetSystemAs<Target>(kWhere));
+    });
+
+    const double fScan = fNanosPer(nLookups, [&] {
+      const std::string where(kWhere);
+      vKeep(std::dynamic_pointer_cast<Target>(
+                manager->poGetSystem(Target::StaticGetTypeID(), where.c_str()))
+                .get());
+    });
+
+    std::printf("poGetSystemAs   %7.2f ns/lookup   atomic type slot\n", fSlot);
+    std::printf("old lookup      %7.2f ns/lookup   lock, scan %d, cast\n",
+                fScan, kSystems);
+    done.set_value();
+  });
+  done.get_future().wait();
+
+  // Off the API thread the call site is also checked against the ones
+  // already warned about.
+  const double fOffThread = fNanosPer(nLookups, [&] {
+    vKeep(manager->poGetSystemAs<Target>(kWhere));
+  });
+  std::printf("off thread      %7.2f ns/lookup   plus warned-site check\n",
+              fOffThread);
+
+  manager->vRemoveAllSystems();
+  return 0;
+}
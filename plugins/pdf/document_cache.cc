@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "document_cache.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "libpdfium.h"
+#include "plugins/common/common.h"
+
+namespace plugin_pdf {
+
+DocumentCache::~DocumentCache() {
+  Clear();
+}
+
+std::shared_ptr<DocumentCache::Document> DocumentCache::Find(
+    std::vector<uint8_t>&& data) {
+  const size_t hash = std::hash<std::string_view>{}(std::string_view(
+      reinterpret_cast<const char*>(data.data()), data.size()));
+
+  std::lock_guard lock(mutex_);
+  for (auto it = documents_.begin(); it != documents_.end(); ++it) {
+    if ((*it)->hash == hash && (*it)->data == data) {
+      documents_.splice(documents_.begin(), documents_, it);
+      SPDLOG_DEBUG("[pdf] Document cache hit: {:x}", hash);
+      return documents_.front();
+    }
+  }
+
+  auto document = std::make_shared<Document>();
+  document->hash = hash;
+  document->data = std::move(data);
+  documents_.push_front(document);
+  if (documents_.size() > kMaxDocuments) {
+    Evict(documents_.back());
+  }
+  return document;
+}
+
+FPDF_DOCUMENT DocumentCache::Acquire(const std::shared_ptr<Document>& document,
+                                     int& page_count,
+                                     std::string& error) {
+  {
+    std::lock_guard lock(mutex_);
+    if (!document->handles.empty()) {
+      const auto handle = document->handles.back();
+      document->handles.pop_back();
+      page_count = document->page_count;
+      return handle;
+    }
+  }
+
+  // Parsed without holding mutex_, so lookups do not wait on it.
+  FPDF_DOCUMENT handle;
+  {
+    std::lock_guard pdfium_lock(LibPdfium::Mutex());
+    handle = LibPdfium->LoadMemDocument64(document->data.data(),
+                                          document->data.size(), nullptr);
+    if (handle) {
+      page_count = LibPdfium->GetPageCount(handle);
+    } else {
+      error = LastErrorString();
+    }
+  }
+
+  std::lock_guard lock(mutex_);
+  if (!handle) {
+    // Do not keep bytes that will never parse.
+    if (!document->evicted) {
+      Evict(document);
+    }
+    return nullptr;
+  }
+  document->page_count = page_count;
+  return handle;
+}
+
+void DocumentCache::Release(const std::shared_ptr<Document>& document,
+                            FPDF_DOCUMENT handle) {
+  {
+    std::lock_guard lock(mutex_);
+    if (!document->evicted) {
+      document->handles.push_back(handle);
+      return;
+    }
+  }
+  std::lock_guard pdfium_lock(LibPdfium::Mutex());
+  LibPdfium->CloseDocument(handle);
+}
+
+void DocumentCache::Clear() {
+  std::lock_guard lock(mutex_);
+  while (!documents_.empty()) {
+    Evict(documents_.back());
+  }
+}
+
+void DocumentCache::Evict(const std::shared_ptr<Document> document) {
+  document->evicted = true;
+  documents_.remove(document);
+
+  // Handles in use are closed when released.
+  std::lock_guard pdfium_lock(LibPdfium::Mutex());
+  for (const auto handle : document->handles) {
+    LibPdfium->CloseDocument(handle);
+  }
+  document->handles.clear();
+}
+
+std::string DocumentCache::LastErrorString() {
+  switch (const unsigned long err = LibPdfium->GetLastError()) {
+    case FPDF_ERR_SUCCESS:
+      return "Success";
+    case FPDF_ERR_UNKNOWN:
+      return "Unknown error";
+    case FPDF_ERR_FILE:
+      return "File not found or could not be opened";
+    case FPDF_ERR_FORMAT:
+      return "File not in PDF format or corrupted";
+    case FPDF_ERR_PASSWORD:
+      return "Password required or incorrect password";
+    case FPDF_ERR_SECURITY:
+      return "Unsupported security scheme";
+    case FPDF_ERR_PAGE:
+      return "Page not found or content error";
+    default:
+      return "Unknown error " + std::to_string(err);
+  }
+}
+
+}  // namespace plugin_pdf
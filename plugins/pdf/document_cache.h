@@ -0,0 +1,128 @@
+/*
+ * Copyright 2025 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLUTTER_PLUGIN_PDF_DOCUMENT_CACHE_H_
+#define FLUTTER_PLUGIN_PDF_DOCUMENT_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "include/fpdfview.h"
+
+namespace plugin_pdf {
+
+/**
+ * @brief LRU cache of parsed PDF documents, keyed by a hash of their content.
+ *
+ * A document keeps the handles opened on it once they are released, so a
+ * later job on the same bytes skips parsing.  Each handle is used by one
+ * worker at a time.
+ */
+class DocumentCache {
+ public:
+  static constexpr size_t kMaxDocuments = 4;
+
+  struct Document {
+    size_t hash{};
+    // Must outlive every handle loaded from it.
+    std::vector<uint8_t> data;
+
+    // Guarded by DocumentCache::mutex_.
+    int page_count = -1;
+    std::vector<FPDF_DOCUMENT> handles;
+    bool evicted{};
+  };
+
+  DocumentCache() = default;
+  ~DocumentCache();
+
+  // Disallow copy and assign.
+  DocumentCache(const DocumentCache&) = delete;
+  DocumentCache& operator=(const DocumentCache&) = delete;
+
+  /**
+   * @brief Look up a document by content, adding it if not cached
+   * @param[in] data PDF document, consumed if it is added
+   * @return std::shared_ptr<Document>
+   * @relation
+   * internal
+   */
+  std::shared_ptr<Document> Find(std::vector<uint8_t>&& data);
+
+  /**
+   * @brief Take an open handle on a document, parsing it if none is free
+   * @param[in] document Document from Find
+   * @param[out] page_count Number of pages in the document
+   * @param[out] error Error message on failure
+   * @return FPDF_DOCUMENT
+   * @retval nullptr The document could not be loaded
+   * @relation
+   * pdfium
+   */
+  FPDF_DOCUMENT Acquire(const std::shared_ptr<Document>& document,
+                        int& page_count,
+                        std::string& error);
+
+  /**
+   * @brief Hand a handle back for reuse
+   * @param[in] document Document the handle was acquired from
+   * @param[in] handle Handle from Acquire
+   * @return void
+   * @relation
+   * pdfium
+   */
+  void Release(const std::shared_ptr<Document>& document,
+               FPDF_DOCUMENT handle);
+
+  /**
+   * @brief Close every free handle and drop all documents
+   * @return void
+   * @relation
+   * pdfium
+   */
+  void Clear();
+
+ private:
+  std::mutex mutex_;
+  // Most recently used first.
+  std::list<std::shared_ptr<Document>> documents_;
+
+  /**
+   * @brief Remove a document and close its free handles.  Called with mutex_
+   * held.
+   * @param[in] document Document to evict
+   * @return void
+   * @relation
+   * pdfium
+   */
+  void Evict(std::shared_ptr<Document> document);
+
+  /**
+   * @brief Describe the last PDFium error
+   * @return std::string
+   * @relation
+   * pdfium
+   */
+  static std::string LastErrorString();
+};
+
+}  // namespace plugin_pdf
+
+#endif  // FLUTTER_PLUGIN_PDF_DOCUMENT_CACHE_H_
@@ -44,6 +44,7 @@ LibPdfiumExports::LibPdfiumExports(void* lib) {
     PluginGetFuncAddress(lib, "FPDF_GetPageHeight", &GetPageHeight);
 
     PluginGetFuncAddress(lib, "FPDFBitmap_Create", &Bitmap_Create);
+    PluginGetFuncAddress(lib, "FPDFBitmap_CreateEx", &Bitmap_CreateEx);
     PluginGetFuncAddress(lib, "FPDFBitmap_Destroy", &Bitmap_Destroy);
     PluginGetFuncAddress(lib, "FPDFBitmap_FillRect", &Bitmap_FillRect);
     PluginGetFuncAddress(lib, "FPDFBitmap_GetBuffer", &Bitmap_GetBuffer);
@@ -57,6 +58,11 @@ LibPdfiumExports* LibPdfium::operator->() const {
   return loadExports();
 }
 
+std::mutex& LibPdfium::Mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
 LibPdfiumExports* LibPdfium::loadExports() {
   static LibPdfiumExports exports = [&] {
     void* lib = dlopen("libpdfium.so", RTLD_NOW | RTLD_GLOBAL);
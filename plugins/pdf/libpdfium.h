@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "flutter/shell/platform/embedder/embedder.h"
 
 #include "include/fpdfview.h"
@@ -44,6 +46,11 @@ struct LibPdfiumExports {
   typedef FPDF_BITMAP (*FPDFBitmap_CreateFnPtr)(int width,
                                                 int height,
                                                 int alpha);
+  typedef FPDF_BITMAP (*FPDFBitmap_CreateExFnPtr)(int width,
+                                                  int height,
+                                                  int format,
+                                                  void* first_scan,
+                                                  int stride);
   typedef FPDF_BOOL (*FPDFBitmap_FillRectFnPtr)(FPDF_BITMAP bitmap,
                                                 int left,
                                                 int top,
@@ -74,6 +81,7 @@ struct LibPdfiumExports {
   FPDF_GetPageWidthFnPtr GetPageWidth = nullptr;
   FPDF_GetPageHeightFnPtr GetPageHeight = nullptr;
   FPDFBitmap_CreateFnPtr Bitmap_Create = nullptr;
+  FPDFBitmap_CreateExFnPtr Bitmap_CreateEx = nullptr;
   FPDFBitmap_FillRectFnPtr Bitmap_FillRect = nullptr;
   FPDF_RenderPageBitmapFnPtr RenderPageBitmap = nullptr;
   FPDFBitmap_GetBufferFnPtr Bitmap_GetBuffer = nullptr;
@@ -87,6 +95,9 @@ class LibPdfium {
  public:
   static bool IsPresent() { return loadExports() != nullptr; }
 
+  // PDFium is not thread-safe; hold while calling into it.
+  static std::mutex& Mutex();
+
   LibPdfiumExports* operator->() const;
 
  private:
@@ -92,6 +92,78 @@ void PrintingApi::SetUp(flutter::BinaryMessenger* binary_messenger,
               }
               api->RasterPdf(std::move(doc), std::move(pages), scale, job_id);
               result->Success();
+            } else if ("cancelJob" == call.method_name()) {
+              const auto& args = std::get_if<EncodableMap>(call.arguments());
+              int32_t job_id = 0;
+              for (const auto& [fst, snd] : *args) {
+                if ("job" == std::get<std::string>(fst) &&
+                    std::holds_alternative<int32_t>(snd)) {
+                  job_id = std::get<int32_t>(snd);
+                }
+              }
+              result->Success(flutter::EncodableValue(api->CancelJob(job_id)));
+            } else if ("createPageTexture" == call.method_name()) {
+              const auto& args = std::get_if<EncodableMap>(call.arguments());
+              std::vector<uint8_t> doc;
+              int32_t page = 0;
+              int32_t width = 0;
+              int32_t height = 0;
+              for (const auto& [fst, snd] : *args) {
+                const auto& key = std::get<std::string>(fst);
+                if ("doc" == key &&
+                    std::holds_alternative<std::vector<uint8_t>>(snd)) {
+                  doc = std::get<std::vector<uint8_t>>(snd);
+                } else if ("page" == key &&
+                           std::holds_alternative<int32_t>(snd)) {
+                  page = std::get<int32_t>(snd);
+                } else if ("width" == key &&
+                           std::holds_alternative<int32_t>(snd)) {
+                  width = std::get<int32_t>(snd);
+                } else if ("height" == key &&
+                           std::holds_alternative<int32_t>(snd)) {
+                  height = std::get<int32_t>(snd);
+                }
+              }
+              const auto output =
+                  api->CreatePageTexture(std::move(doc), page, width, height);
+              if (output.has_error()) {
+                result->Error(output.error().code(), output.error().message(),
+                              output.error().details());
+              } else {
+                result->Success(flutter::EncodableValue(output.value()));
+              }
+            } else if ("updatePageTexture" == call.method_name() ||
+                       "disposePageTexture" == call.method_name()) {
+              const auto& args = std::get_if<EncodableMap>(call.arguments());
+              int64_t texture_id = 0;
+              double scale = 1.0;
+              double x = 0;
+              double y = 0;
+              for (const auto& [fst, snd] : *args) {
+                const auto& key = std::get<std::string>(fst);
+                if ("texture" == key &&
+                    (std::holds_alternative<int32_t>(snd) ||
+                     std::holds_alternative<int64_t>(snd))) {
+                  texture_id = snd.LongValue();
+                } else if ("scale" == key &&
+                           std::holds_alternative<double>(snd)) {
+                  scale = std::get<double>(snd);
+                } else if ("x" == key && std::holds_alternative<double>(snd)) {
+                  x = std::get<double>(snd);
+                } else if ("y" == key && std::holds_alternative<double>(snd)) {
+                  y = std::get<double>(snd);
+                }
+              }
+              const auto output =
+                  "updatePageTexture" == call.method_name()
+                      ? api->UpdatePageTexture(texture_id, scale, x, y)
+                      : api->DisposePageTexture(texture_id);
+              if (output.has_value()) {
+                result->Error(output->code(), output->message(),
+                              output->details());
+              } else {
+                result->Success();
+              }
             } else {
               result->NotImplemented();
             }
@@ -79,6 +79,17 @@ class PrintingApi {
                                                 std::vector<int32_t> pages,
                                                 double scale,
                                                 int job_id) = 0;
+  virtual bool CancelJob(int job_id) = 0;
+  virtual ErrorOr<int64_t> CreatePageTexture(std::vector<uint8_t> doc,
+                                             int page,
+                                             int width,
+                                             int height) = 0;
+  virtual std::optional<FlutterError> UpdatePageTexture(int64_t texture_id,
+                                                        double scale,
+                                                        double x,
+                                                        double y) = 0;
+  virtual std::optional<FlutterError> DisposePageTexture(
+      int64_t texture_id) = 0;
   virtual bool SharePdf(std::vector<uint8_t> buffer,
                         const std::string& name) = 0;
 
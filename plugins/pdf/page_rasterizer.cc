@@ -0,0 +1,181 @@
+/*
+ * Copyright 2025 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "page_rasterizer.h"
+
+#include <numeric>
+
+#include "libpdfium.h"
+#include "plugins/common/common.h"
+
+namespace plugin_pdf {
+
+PageRasterizer::PageRasterizer(PageCallback on_page, EndCallback on_end)
+    : on_page_(std::move(on_page)), on_end_(std::move(on_end)) {
+  FPDF_LIBRARY_CONFIG config{};
+  config.version = 2;
+  // requires a PDFium build with skia enabled
+  config.m_RendererType = FPDF_RENDERERTYPE_SKIA;
+  LibPdfium->InitLibraryWithConfig(&config);
+
+  thread_ = std::thread(&PageRasterizer::Run, this);
+}
+
+PageRasterizer::~PageRasterizer() {
+  {
+    std::lock_guard lock(mutex_);
+    exit_ = true;
+    for (const auto& [id, job] : jobs_) {
+      job->cancelled = true;
+    }
+  }
+  cv_.notify_all();
+  thread_.join();
+  cache_.Clear();
+  LibPdfium->DestroyLibrary();
+}
+
+void PageRasterizer::Raster(std::vector<uint8_t> doc,
+                            std::vector<int32_t> pages,
+                            const double scale,
+                            const int job_id) {
+  auto job = std::make_shared<Job>();
+  job->id = job_id;
+  job->doc = std::move(doc);
+  job->pages = std::move(pages);
+  job->scale = scale;
+  {
+    std::lock_guard lock(mutex_);
+    queue_.push_back(job);
+    jobs_[job_id] = std::move(job);
+  }
+  cv_.notify_all();
+}
+
+bool PageRasterizer::Cancel(const int job_id) {
+  std::lock_guard lock(mutex_);
+  const auto it = jobs_.find(job_id);
+  if (it == jobs_.end()) {
+    return false;
+  }
+  it->second->cancelled = true;
+  return true;
+}
+
+void PageRasterizer::Run() {
+  while (true) {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock lock(mutex_);
+      cv_.wait(lock, [this] { return exit_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      job = std::move(queue_.front());
+      queue_.pop_front();
+    }
+
+    auto error = RunJob(*job);
+
+    {
+      std::lock_guard lock(mutex_);
+      jobs_.erase(job->id);
+    }
+
+    if (error.empty() && job->cancelled) {
+      error = "Cancelled";
+    }
+    on_end_(job->id, error);
+  }
+}
+
+std::string PageRasterizer::RunJob(Job& job) {
+  if (job.cancelled) {
+    return {};
+  }
+
+  // The cache keeps the handle open for the next job on the same bytes.
+  const auto document = cache_.Find(std::move(job.doc));
+  int page_count = 0;
+  std::string error;
+  const auto doc = cache_.Acquire(document, page_count, error);
+  if (!doc) {
+    SPDLOG_DEBUG("[pdf] Load unsuccessful: job: {}", job.id);
+    return error;
+  }
+
+  if (job.pages.empty()) {
+    // Use all pages
+    job.pages.resize(static_cast<size_t>(page_count));
+    std::iota(std::begin(job.pages), std::end(job.pages), 0);
+  }
+
+  for (const auto n : job.pages) {
+    if (job.cancelled) {
+      break;
+    }
+    if (n >= page_count) {
+      continue;
+    }
+    if (auto page = RenderPage(doc, n, job.scale); page) {
+      on_page_(std::move(page->data), page->width, page->height, job.id);
+    }
+  }
+
+  cache_.Release(document, doc);
+  return {};
+}
+
+std::optional<PageRasterizer::Page> PageRasterizer::RenderPage(
+    FPDF_DOCUMENT doc,
+    const int index,
+    const double scale) {
+  std::lock_guard lock(LibPdfium::Mutex());
+  const auto page = LibPdfium->LoadPage(doc, index);
+  if (!page) {
+    return std::nullopt;
+  }
+
+  const auto width = LibPdfium->GetPageWidth(page);
+  const auto height = LibPdfium->GetPageHeight(page);
+
+  const auto bWidth = static_cast<int>(width * scale);
+  const auto bHeight = static_cast<int>(height * scale);
+
+  // Render straight into a buffer handed to Flutter without another copy.
+  // FPDF_REVERSE_BYTE_ORDER makes PDFium write RGBA instead of BGRA.
+  Page result{
+      std::vector<uint8_t>(static_cast<size_t>(bWidth) * bHeight * 4),
+      bWidth, bHeight};
+  const auto bitmap =
+      LibPdfium->Bitmap_CreateEx(bWidth, bHeight, FPDFBitmap_BGRA,
+                                 result.data.data(), bWidth * 4);
+  if (!bitmap) {
+    LibPdfium->ClosePage(page);
+    return std::nullopt;
+  }
+  LibPdfium->Bitmap_FillRect(bitmap, 0, 0, bWidth, bHeight, 0x00ffffff);
+
+  LibPdfium->RenderPageBitmap(bitmap, page, 0, 0, bWidth, bHeight, 0,
+                              FPDF_ANNOT | FPDF_LCD_TEXT |
+                                  FPDF_REVERSE_BYTE_ORDER);
+  // The bitmap does not own an external buffer.
+  LibPdfium->Bitmap_Destroy(bitmap);
+  LibPdfium->ClosePage(page);
+  return result;
+}
+
+}  // namespace plugin_pdf
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2025 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLUTTER_PLUGIN_PDF_PAGE_RASTERIZER_H_
+#define FLUTTER_PLUGIN_PDF_PAGE_RASTERIZER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "document_cache.h"
+#include "include/fpdfview.h"
+
+namespace plugin_pdf {
+
+/**
+ * @brief Rasterizes pages of PDF jobs on a worker thread.
+ *
+ * PDFium serializes every call behind LibPdfium::Mutex(), so more workers
+ * would only queue on it.  The single worker renders jobs in order, holding
+ * one handle per document from the cache, and delivers each page as soon as
+ * it is done.
+ */
+class PageRasterizer {
+ public:
+  using PageCallback = std::function<
+      void(std::vector<uint8_t> data, int width, int height, int job_id)>;
+  using EndCallback =
+      std::function<void(int job_id, const std::string& error)>;
+
+  /**
+   * @brief Initialize PDFium and start the worker.  PDFium stays
+   * initialized until the rasterizer is destroyed.
+   * @param[in] on_page Called for every rendered page, from a worker thread
+   * @param[in] on_end Called once per job after its last page, from a worker
+   * thread.  The error is empty on success.
+   * @relation
+   * pdfium
+   */
+  PageRasterizer(PageCallback on_page, EndCallback on_end);
+  ~PageRasterizer();
+
+  // Disallow copy and assign.
+  PageRasterizer(const PageRasterizer&) = delete;
+  PageRasterizer& operator=(const PageRasterizer&) = delete;
+
+  /**
+   * @brief Queue a rasterization job
+   * @param[in] doc PDF document
+   * @param[in] pages Zero based page indexes, all pages if empty
+   * @param[in] scale Pixels per PDF point
+   * @param[in] job_id Job identifier passed to the callbacks
+   * @return void
+   * @relation
+   * pdfium
+   */
+  void Raster(std::vector<uint8_t> doc,
+              std::vector<int32_t> pages,
+              double scale,
+              int job_id);
+
+  /**
+   * @brief Stop rendering a job.  Pages in progress are finished, the rest
+   * are dropped and the job ends with an error.
+   * @param[in] job_id Job to cancel
+   * @return bool
+   * @retval true Job found
+   * @retval false No queued or running job with that id
+   * @relation
+   * internal
+   */
+  bool Cancel(int job_id);
+
+  // Parsed documents, shared with page textures.
+  DocumentCache& cache() { return cache_; }
+
+ private:
+  struct Page {
+    std::vector<uint8_t> data;
+    int width{};
+    int height{};
+  };
+
+  struct Job {
+    int id{};
+    double scale{};
+    std::atomic<bool> cancelled{};
+    std::vector<uint8_t> doc;
+    std::vector<int32_t> pages;
+  };
+
+  PageCallback on_page_;
+  EndCallback on_end_;
+  DocumentCache cache_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<Job>> queue_;
+  std::map<int, std::shared_ptr<Job>> jobs_;
+  bool exit_{};
+  std::thread thread_;
+
+  void Run();
+
+  /**
+   * @brief Render and deliver the pages of a job
+   * @param[in] job Job to work on
+   * @return std::string Error, empty on success
+   * @relation
+   * pdfium
+   */
+  std::string RunJob(Job& job);
+
+  /**
+   * @brief Render a single page
+   * @param[in] doc Document handle held by the worker
+   * @param[in] index Zero based page index
+   * @param[in] scale Pixels per PDF point
+   * @return std::optional<Page> RGBA page, empty if it could not be loaded
+   * @relation
+   * pdfium
+   */
+  static std::optional<Page> RenderPage(FPDF_DOCUMENT doc,
+                                        int index,
+                                        double scale);
+};
+
+}  // namespace plugin_pdf
+
+#endif  // FLUTTER_PLUGIN_PDF_PAGE_RASTERIZER_H_
@@ -0,0 +1,270 @@
+/*
+ * Copyright 2025 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "page_texture.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "libpdfium.h"
+#include "plugins/common/common.h"
+#include "plugins/common/egl/context_guard.h"
+
+namespace plugin_pdf {
+
+namespace {
+
+// Index of the tile holding pixel, rounding towards negative infinity.
+int TileIndex(const double pixel) {
+  return static_cast<int>(std::floor(pixel / PageTexture::kTileSize));
+}
+
+}  // namespace
+
+PageTexture::PageTexture(flutter::TextureRegistrar* texture_registrar,
+                         DocumentCache& cache,
+                         std::shared_ptr<DocumentCache::Document> document,
+                         const int page_index,
+                         const int width,
+                         const int height)
+    : texture_registrar_(texture_registrar),
+      cache_(cache),
+      document_(std::move(document)),
+      page_index_(page_index),
+      width_(width),
+      height_(height),
+      // Twice the tiles a viewport can touch, so panning back is free.
+      max_tiles_(2 * static_cast<size_t>(width / kTileSize + 2) *
+                 static_cast<size_t>(height / kTileSize + 2)),
+      blank_(static_cast<size_t>(kTileSize) * kTileSize * 4, 0xff) {
+  texture_registrar_->TextureMakeCurrent();
+  glGenTextures(1, &texture_id_);
+  glBindTexture(GL_TEXTURE_2D, texture_id_);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width_, height_, 0, GL_RGBA,
+               GL_UNSIGNED_BYTE, nullptr);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  texture_registrar_->TextureClearCurrent();
+
+  descriptor_ = {
+      .struct_size = sizeof(FlutterDesktopGpuSurfaceDescriptor),
+      .handle = &texture_id_,
+      .width = static_cast<size_t>(width_),
+      .height = static_cast<size_t>(height_),
+      .visible_width = static_cast<size_t>(width_),
+      .visible_height = static_cast<size_t>(height_),
+      .format = kFlutterDesktopPixelFormatRGBA8888,
+      .release_callback = [](void* /* release_context */) {},
+      .release_context = this,
+  };
+
+  gpu_surface_texture_ = std::make_unique<flutter::GpuSurfaceTexture>(
+      kFlutterDesktopGpuSurfaceTypeGlTexture2D,
+      [&](size_t /* width */,
+          size_t /* height */) -> const FlutterDesktopGpuSurfaceDescriptor* {
+        return ObtainDescriptor();
+      });
+
+  flutter::TextureVariant texture = *gpu_surface_texture_;
+  texture_registrar_->RegisterTexture(&texture);
+
+  thread_ = std::thread(&PageTexture::Run, this);
+}
+
+PageTexture::~PageTexture() {
+  texture_registrar_->UnregisterTexture(texture_id_);
+  {
+    std::lock_guard lock(mutex_);
+    exit_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+
+  texture_registrar_->TextureMakeCurrent();
+  glDeleteTextures(1, &texture_id_);
+  texture_registrar_->TextureClearCurrent();
+}
+
+void PageTexture::SetViewport(const double scale,
+                              const double x,
+                              const double y) {
+  {
+    std::lock_guard lock(mutex_);
+    viewport_ = {scale, x, y};
+    dirty_ = true;
+  }
+  cv_.notify_all();
+  texture_registrar_->MarkTextureFrameAvailable(texture_id_);
+}
+
+void PageTexture::Run() {
+  int page_count = 0;
+  std::string error;
+  const FPDF_DOCUMENT doc = cache_.Acquire(document_, page_count, error);
+
+  FPDF_PAGE page = nullptr;
+  double page_width{};
+  double page_height{};
+  if (doc && page_index_ >= 0 && page_index_ < page_count) {
+    std::lock_guard pdfium_lock(LibPdfium::Mutex());
+    page = LibPdfium->LoadPage(doc, page_index_);
+    if (page) {
+      page_width = LibPdfium->GetPageWidth(page);
+      page_height = LibPdfium->GetPageHeight(page);
+    }
+  }
+  if (page) {
+    std::lock_guard lock(mutex_);
+    page_width_ = page_width;
+    page_height_ = page_height;
+  } else {
+    spdlog::error("[pdf] Page {} not available: {}", page_index_, error);
+  }
+
+  while (page) {
+    Tile tile;
+    {
+      std::unique_lock lock(mutex_);
+      std::optional<Tile> next;
+      cv_.wait(lock, [&] {
+        return exit_ || (next = NextMissingTile()).has_value();
+      });
+      if (exit_) {
+        break;
+      }
+      tile = std::move(next.value());
+    }
+
+    RenderTile(page, tile);
+
+    {
+      std::lock_guard lock(mutex_);
+      tiles_.push_front(std::move(tile));
+      if (tiles_.size() > max_tiles_) {
+        tiles_.pop_back();
+      }
+      dirty_ = true;
+    }
+    texture_registrar_->MarkTextureFrameAvailable(texture_id_);
+  }
+
+  if (page) {
+    std::lock_guard pdfium_lock(LibPdfium::Mutex());
+    LibPdfium->ClosePage(page);
+  }
+  if (doc) {
+    cache_.Release(document_, doc);
+  }
+}
+
+std::optional<PageTexture::Tile> PageTexture::NextMissingTile() {
+  const auto& [scale, x, y] = viewport_;
+  if (scale <= 0) {
+    return std::nullopt;
+  }
+  for (int row = TileIndex(y); row <= TileIndex(y + height_ - 1); row++) {
+    for (int col = TileIndex(x); col <= TileIndex(x + width_ - 1); col++) {
+      if (IsOnPage(col, row) && FindTile(scale, col, row) == nullptr) {
+        return Tile{scale, col, row, {}};
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+const PageTexture::Tile* PageTexture::FindTile(const double scale,
+                                               const int col,
+                                               const int row) {
+  const auto it = std::find_if(tiles_.begin(), tiles_.end(), [&](auto& tile) {
+    return tile.scale == scale && tile.col == col && tile.row == row;
+  });
+  if (it == tiles_.end()) {
+    return nullptr;
+  }
+  tiles_.splice(tiles_.begin(), tiles_, it);
+  return &tiles_.front();
+}
+
+bool PageTexture::IsOnPage(const int col, const int row) const {
+  return col >= 0 && row >= 0 &&
+         col * kTileSize < page_width_ * viewport_.scale &&
+         row * kTileSize < page_height_ * viewport_.scale;
+}
+
+void PageTexture::RenderTile(FPDF_PAGE page, Tile& tile) const {
+  tile.pixels.assign(blank_.size(), 0xff);
+
+  std::lock_guard pdfium_lock(LibPdfium::Mutex());
+  const auto bitmap =
+      LibPdfium->Bitmap_CreateEx(kTileSize, kTileSize, FPDFBitmap_BGRA,
+                                 tile.pixels.data(), kTileSize * 4);
+  if (!bitmap) {
+    return;
+  }
+  // The page is placed so that only this tile lands in the bitmap.
+  LibPdfium->RenderPageBitmap(
+      bitmap, page, -tile.col * kTileSize, -tile.row * kTileSize,
+      static_cast<int>(std::lround(page_width_ * tile.scale)),
+      static_cast<int>(std::lround(page_height_ * tile.scale)), 0,
+      FPDF_ANNOT | FPDF_LCD_TEXT | FPDF_REVERSE_BYTE_ORDER);
+  LibPdfium->Bitmap_Destroy(bitmap);
+}
+
+const FlutterDesktopGpuSurfaceDescriptor* PageTexture::ObtainDescriptor() {
+  std::lock_guard lock(mutex_);
+  if (!dirty_) {
+    return &descriptor_;
+  }
+  dirty_ = false;
+
+  const auto x0 = static_cast<int>(std::floor(viewport_.x));
+  const auto y0 = static_cast<int>(std::floor(viewport_.y));
+
+  // Raster thread: rebind the engine's context once the upload is done.
+  const plugin_common_egl::ContextGuard context_guard;
+  texture_registrar_->TextureMakeCurrent();
+  glBindTexture(GL_TEXTURE_2D, texture_id_);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, kTileSize);
+
+  // Copy the visible part of every tile slot, blank where nothing is cached.
+  for (int row = TileIndex(y0); row * kTileSize < y0 + height_; row++) {
+    for (int col = TileIndex(x0); col * kTileSize < x0 + width_; col++) {
+      const int left = std::max(col * kTileSize, x0);
+      const int top = std::max(row * kTileSize, y0);
+      const int right = std::min((col + 1) * kTileSize, x0 + width_);
+      const int bottom = std::min((row + 1) * kTileSize, y0 + height_);
+
+      const Tile* tile =
+          IsOnPage(col, row) ? FindTile(viewport_.scale, col, row) : nullptr;
+      glPixelStorei(GL_UNPACK_SKIP_PIXELS, left - col * kTileSize);
+      glPixelStorei(GL_UNPACK_SKIP_ROWS, top - row * kTileSize);
+      glTexSubImage2D(GL_TEXTURE_2D, 0, left - x0, top - y0, right - left,
+                      bottom - top, GL_RGBA, GL_UNSIGNED_BYTE,
+                      tile ? tile->pixels.data() : blank_.data());
+    }
+  }
+
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+  glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  return &descriptor_;
+}
+
+}  // namespace plugin_pdf
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2025 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLUTTER_PLUGIN_PDF_PAGE_TEXTURE_H_
+#define FLUTTER_PLUGIN_PDF_PAGE_TEXTURE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <GLES3/gl3.h>
+
+#include <flutter/texture_registrar.h>
+
+#include "document_cache.h"
+
+namespace plugin_pdf {
+
+/**
+ * @brief Shows a viewport onto one PDF page in a Flutter texture.
+ *
+ * The page is rasterized in square tiles at the viewport scale on a
+ * dedicated thread.  Only visible tiles that are not cached are rendered, so
+ * panning re-uploads cached tiles and a zoom renders only what is on screen.
+ */
+class PageTexture {
+ public:
+  static constexpr int kTileSize = 256;
+
+  /**
+   * @brief Create and register the texture, and start loading the page
+   * @param[in] texture_registrar Registrar of the texture
+   * @param[in] cache Cache the document is held in
+   * @param[in] document Document from the cache
+   * @param[in] page_index Zero based page index
+   * @param[in] width Texture width in pixels
+   * @param[in] height Texture height in pixels
+   * @relation
+   * flutter, pdfium
+   */
+  PageTexture(flutter::TextureRegistrar* texture_registrar,
+              DocumentCache& cache,
+              std::shared_ptr<DocumentCache::Document> document,
+              int page_index,
+              int width,
+              int height);
+  ~PageTexture();
+
+  // Disallow copy and assign.
+  PageTexture(const PageTexture&) = delete;
+  PageTexture& operator=(const PageTexture&) = delete;
+
+  [[nodiscard]] int64_t textureId() const { return texture_id_; }
+
+  /**
+   * @brief Move the viewport.  Tiles of the new viewport are rendered in the
+   * background and shown as they complete.
+   * @param[in] scale Pixels per PDF point
+   * @param[in] x Left edge of the viewport in pixels of the scaled page
+   * @param[in] y Top edge of the viewport in pixels of the scaled page
+   * @return void
+   * @relation
+   * flutter
+   */
+  void SetViewport(double scale, double x, double y);
+
+ private:
+  struct Viewport {
+    double scale = 1.0;
+    double x{};
+    double y{};
+  };
+
+  struct Tile {
+    double scale{};
+    int col{};
+    int row{};
+    // kTileSize square RGBA, white past the page edge.
+    std::vector<uint8_t> pixels;
+  };
+
+  flutter::TextureRegistrar* texture_registrar_;
+  DocumentCache& cache_;
+  std::shared_ptr<DocumentCache::Document> document_;
+  const int page_index_;
+  const int width_;
+  const int height_;
+  const size_t max_tiles_;
+  // Shown where no tile has been rendered yet.
+  const std::vector<uint8_t> blank_;
+
+  GLuint texture_id_{};
+  std::unique_ptr<flutter::GpuSurfaceTexture> gpu_surface_texture_;
+  FlutterDesktopGpuSurfaceDescriptor descriptor_{};
+
+  // Guarded by mutex_.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  Viewport viewport_;
+  double page_width_{};
+  double page_height_{};
+  // Most recently used first.
+  std::list<Tile> tiles_;
+  bool dirty_ = true;
+  bool exit_{};
+
+  std::thread thread_;
+
+  void Run();
+
+  /**
+   * @brief Find the next visible tile that is not cached.  Called with mutex_
+   * held.
+   * @return std::optional<Tile> Tile to render, without pixels
+   * @relation
+   * internal
+   */
+  std::optional<Tile> NextMissingTile();
+
+  /**
+   * @brief Look up a cached tile and mark it as recently used.  Called with
+   * mutex_ held.
+   * @param[in] scale Viewport scale
+   * @param[in] col Tile column
+   * @param[in] row Tile row
+   * @return const Tile* nullptr if not cached
+   * @relation
+   * internal
+   */
+  const Tile* FindTile(double scale, int col, int row);
+
+  /**
+   * @brief Returns true if the tile overlaps the page.  Called with mutex_
+   * held.
+   * @param[in] col Tile column
+   * @param[in] row Tile row
+   * @return bool
+   * @relation
+   * internal
+   */
+  [[nodiscard]] bool IsOnPage(int col, int row) const;
+
+  /**
+   * @brief Rasterize a tile
+   * @param[in] page Page held by the render thread
+   * @param[in,out] tile Tile to fill
+   * @return void
+   * @relation
+   * pdfium
+   */
+  void RenderTile(FPDF_PAGE page, Tile& tile) const;
+
+  /**
+   * @brief Texture callback: upload the visible tiles if anything changed
+   * @return const FlutterDesktopGpuSurfaceDescriptor*
+   * @relation
+   * flutter
+   */
+  const FlutterDesktopGpuSurfaceDescriptor* ObtainDescriptor();
+};
+
+}  // namespace plugin_pdf
+
+#endif  // FLUTTER_PLUGIN_PDF_PAGE_TEXTURE_H_
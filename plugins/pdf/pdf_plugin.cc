@@ -19,12 +19,12 @@
 #include <sys/wait.h>
 #include <unistd.h>
 #include <memory>
-#include <numeric>
 
 #include <flutter/plugin_registrar.h>
 
 #include "libpdfium.h"
 #include "messages.h"
+#include "page_rasterizer.h"
 #include "plugins/common/common.h"
 
 namespace plugin_pdf {
@@ -33,18 +33,19 @@ std::unique_ptr<flutter::MethodChannel<>> channel;
 
 // static
 void PdfPlugin::RegisterWithRegistrar(flutter::PluginRegistrar* registrar) {
-  auto plugin = std::make_unique<PdfPlugin>();
+  auto plugin = std::make_unique<PdfPlugin>(registrar->texture_registrar());
 
   SetUp(registrar->messenger(), plugin.get());
 
   registrar->AddPlugin(std::move(plugin));
 }
 
-PdfPlugin::PdfPlugin() = default;
+PdfPlugin::PdfPlugin(flutter::TextureRegistrar* texture_registrar)
+    : texture_registrar_(texture_registrar) {}
 
 PdfPlugin::~PdfPlugin() = default;
 
-std::optional<FlutterError> PdfPlugin::RasterPdf(const std::vector<uint8_t> doc,
+std::optional<FlutterError> PdfPlugin::RasterPdf(std::vector<uint8_t> doc,
                                                  std::vector<int32_t> pages,
                                                  double scale,
                                                  int job_id) {
@@ -52,105 +53,74 @@ std::optional<FlutterError> PdfPlugin::RasterPdf(const std::vector<uint8_t> doc,
   SPDLOG_DEBUG("\tpages_count: {}", pages.size());
   SPDLOG_DEBUG("\tscale: {}", scale);
   SPDLOG_DEBUG("\tjob: {}", job_id);
-  FPDF_LIBRARY_CONFIG config{};
-  config.version = 2;
-  // requires a PDFium build with skia enabled
-  config.m_RendererType = FPDF_RENDERERTYPE_SKIA;
-
-  LibPdfium->InitLibraryWithConfig(&config);
-
-  const auto pdf_doc =
-      LibPdfium->LoadMemDocument64(doc.data(), doc.size(), nullptr);
-  if (!pdf_doc) {
-    const unsigned long err = LibPdfium->GetLastError();
-    SPDLOG_DEBUG("[pdf] Load unsuccessful: job: {}", job_id);
-    switch (err) {
-      case FPDF_ERR_SUCCESS:
-        on_page_raster_end(job_id, "Success");
-        break;
-      case FPDF_ERR_UNKNOWN:
-        on_page_raster_end(job_id, "Unknown error");
-        break;
-      case FPDF_ERR_FILE:
-        on_page_raster_end(job_id, "File not found or could not be opened");
-        break;
-      case FPDF_ERR_FORMAT:
-        on_page_raster_end(job_id, "File not in PDF format or corrupted");
-        break;
-      case FPDF_ERR_PASSWORD:
-        on_page_raster_end(job_id, "Password required or incorrect password");
-        break;
-      case FPDF_ERR_SECURITY:
-        on_page_raster_end(job_id, "Unsupported security scheme");
-        break;
-      case FPDF_ERR_PAGE:
-        on_page_raster_end(job_id, "Page not found or content error");
-        break;
-      default:
-        on_page_raster_end(job_id, "Unknown error " + std::to_string(err));
-    }
-    LibPdfium->DestroyLibrary();
+  if (!LibPdfium::IsPresent()) {
+    on_page_raster_end(job_id, "libpdfium.so is not available");
     return std::nullopt;
   }
 
-  const auto pageCount = LibPdfium->GetPageCount(pdf_doc);
-
-  if (pages.empty()) {
-    // Use all pages
-    pages.resize(static_cast<size_t>(pageCount));
-    std::iota(std::begin(pages), std::end(pages), 0);
-  }
-
-  for (const auto n : pages) {
-    if (n >= pageCount) {
-      continue;
-    }
-
-    const auto page = LibPdfium->LoadPage(pdf_doc, n);
-    if (!page) {
-      continue;
-    }
-
-    const auto width = LibPdfium->GetPageWidth(page);
-    const auto height = LibPdfium->GetPageHeight(page);
-
-    const auto bWidth = static_cast<int>(width * scale);
-    const auto bHeight = static_cast<int>(height * scale);
-
-    const auto bitmap = LibPdfium->Bitmap_Create(bWidth, bHeight, 1);
-    LibPdfium->Bitmap_FillRect(bitmap, 0, 0, bWidth, bHeight, 0x00ffffff);
-
-    LibPdfium->RenderPageBitmap(bitmap, page, 0, 0, bWidth, bHeight, 0,
-                                FPDF_ANNOT | FPDF_LCD_TEXT);
+  // Pages are rendered and sent back from the worker threads.
+  Rasterizer().Raster(std::move(doc), std::move(pages), scale, job_id);
+  return std::nullopt;
+}
 
-    auto* p = static_cast<uint8_t*>(LibPdfium->Bitmap_GetBuffer(bitmap));
-    const auto stride = LibPdfium->Bitmap_GetStride(bitmap);
-    const auto l = bHeight * stride;
+bool PdfPlugin::CancelJob(const int job_id) {
+  SPDLOG_DEBUG("\tjob: {}", job_id);
+  return rasterizer_ && rasterizer_->Cancel(job_id);
+}
 
-    // BGRA to RGBA conversion
-    for (auto y = 0; y < bHeight; y++) {
-      auto offset = y * stride;
-      for (auto x = 0; x < bWidth; x++) {
-        const auto t = p[offset];
-        p[offset] = p[offset + 2];
-        p[offset + 2] = t;
-        offset += 4;
-      }
-    }
+ErrorOr<int64_t> PdfPlugin::CreatePageTexture(std::vector<uint8_t> doc,
+                                              const int page,
+                                              const int width,
+                                              const int height) {
+  SPDLOG_DEBUG("\tpage: {}, size: {}x{}", page, width, height);
+  if (!LibPdfium::IsPresent()) {
+    return ErrorOr<int64_t>(FlutterError("pdfium_unavailable",
+                                         "libpdfium.so is not available"));
+  }
+  if (width <= 0 || height <= 0) {
+    return ErrorOr<int64_t>(
+        FlutterError("invalid_argument", "Texture size must be positive"));
+  }
 
-    on_page_rasterized(std::vector<uint8_t>{p, p + l}, bWidth, bHeight, job_id);
+  auto& cache = Rasterizer().cache();
+  auto texture = std::make_unique<PageTexture>(
+      texture_registrar_, cache, cache.Find(std::move(doc)), page, width,
+      height);
+  const auto texture_id = texture->textureId();
+  textures_[texture_id] = std::move(texture);
+  return ErrorOr<int64_t>(texture_id);
+}
 
-    LibPdfium->Bitmap_Destroy(bitmap);
-    LibPdfium->ClosePage(page);
+std::optional<FlutterError> PdfPlugin::UpdatePageTexture(
+    const int64_t texture_id,
+    const double scale,
+    const double x,
+    const double y) {
+  const auto it = textures_.find(texture_id);
+  if (it == textures_.end()) {
+    return FlutterError("invalid_texture", "Unknown page texture");
   }
+  it->second->SetViewport(scale, x, y);
+  return std::nullopt;
+}
 
-  LibPdfium->CloseDocument(pdf_doc);
-  LibPdfium->DestroyLibrary();
-
-  on_page_raster_end(job_id, "");
+std::optional<FlutterError> PdfPlugin::DisposePageTexture(
+    const int64_t texture_id) {
+  SPDLOG_DEBUG("\ttexture: {}", texture_id);
+  if (textures_.erase(texture_id) == 0) {
+    return FlutterError("invalid_texture", "Unknown page texture");
+  }
   return std::nullopt;
 }
 
+PageRasterizer& PdfPlugin::Rasterizer() {
+  if (!rasterizer_) {
+    rasterizer_ = std::make_unique<PageRasterizer>(on_page_rasterized,
+                                                   on_page_raster_end);
+  }
+  return *rasterizer_;
+}
+
 bool PdfPlugin::SharePdf(const std::vector<uint8_t> buffer,
                          const std::string& name) {
   SPDLOG_DEBUG("\t{}", name);
@@ -17,10 +17,14 @@
 #ifndef FLUTTER_PLUGIN_PDF_PLUGIN_H_
 #define FLUTTER_PLUGIN_PDF_PLUGIN_H_
 
+#include <map>
+
 #include <flutter/method_channel.h>
 #include <flutter/plugin_registrar.h>
 
 #include "messages.h"
+#include "page_rasterizer.h"
+#include "page_texture.h"
 
 namespace plugin_pdf {
 
@@ -28,7 +32,7 @@ class PdfPlugin final : public flutter::Plugin, public PrintingApi {
  public:
   static void RegisterWithRegistrar(flutter::PluginRegistrar* registrar);
 
-  PdfPlugin();
+  explicit PdfPlugin(flutter::TextureRegistrar* texture_registrar);
 
   ~PdfPlugin() override;
 
@@ -49,7 +53,38 @@ class PdfPlugin final : public flutter::Plugin, public PrintingApi {
                                         double scale,
                                         int job_id) override;
 
+  bool CancelJob(int job_id) override;
+
+  ErrorOr<int64_t> CreatePageTexture(std::vector<uint8_t> doc,
+                                     int page,
+                                     int width,
+                                     int height) override;
+
+  std::optional<FlutterError> UpdatePageTexture(int64_t texture_id,
+                                                double scale,
+                                                double x,
+                                                double y) override;
+
+  std::optional<FlutterError> DisposePageTexture(int64_t texture_id) override;
+
   bool SharePdf(std::vector<uint8_t> buffer, const std::string& name) override;
+
+ private:
+  flutter::TextureRegistrar* texture_registrar_;
+
+  // Created on the first raster job or page texture.
+  std::unique_ptr<PageRasterizer> rasterizer_;
+
+  // Destroyed before the rasterizer, which owns the document cache.
+  std::map<int64_t, std::unique_ptr<PageTexture>> textures_;
+
+  /**
+   * @brief Returns the rasterizer, initializing PDFium on first use
+   * @return PageRasterizer&
+   * @relation
+   * pdfium
+   */
+  PageRasterizer& Rasterizer();
 };
 
 }  // namespace plugin_pdf
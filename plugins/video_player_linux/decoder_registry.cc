@@ -0,0 +1,210 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "decoder_registry.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <plugins/common/common.h>
+
+namespace video_player_linux {
+
+namespace {
+
+// Codecs probed when the plugin starts.
+constexpr AVCodecID kProbedCodecs[] = {
+    AV_CODEC_ID_H264, AV_CODEC_ID_HEVC,       AV_CODEC_ID_VP8,
+    AV_CODEC_ID_VP9,  AV_CODEC_ID_AV1,        AV_CODEC_ID_MPEG2VIDEO,
+    AV_CODEC_ID_MPEG4};
+
+enum DecoderTier {
+  kTierV4l2Stateless = 0,
+  kTierV4l2,
+  kTierVaapi,
+  kTierHardware,
+  kTierSoftware,
+};
+
+}  // namespace
+
+DecoderRegistry::~DecoderRegistry() {
+  for (auto& [codec_id, factories] : cache_) {
+    for (const auto factory : factories) {
+      gst_object_unref(factory);
+    }
+  }
+}
+
+void DecoderRegistry::Probe(const char* (*software_fallback)(AVCodecID)) {
+  for (const auto codec_id : kProbedCodecs) {
+    GetDecoders(codec_id, software_fallback(codec_id));
+  }
+}
+
+std::vector<GstElementFactory*> DecoderRegistry::GetDecoders(
+    const AVCodecID codec_id,
+    const char* software_fallback) {
+  std::lock_guard lock(mutex_);
+  if (const auto it = cache_.find(codec_id); it != cache_.end()) {
+    return it->second;
+  }
+  auto decoders = Rank(codec_id, software_fallback);
+  cache_[codec_id] = decoders;
+  return decoders;
+}
+
+std::vector<GstElementFactory*> DecoderRegistry::Rank(
+    const AVCodecID codec_id,
+    const char* software_fallback) {
+  std::vector<GstElementFactory*> ranked;
+
+  if (const char* caps_str = CodecCaps(codec_id)) {
+    GstCaps* caps = gst_caps_from_string(caps_str);
+    GList* all = gst_element_factory_list_get_elements(
+        GST_ELEMENT_FACTORY_TYPE_DECODER | GST_ELEMENT_FACTORY_TYPE_MEDIA_VIDEO,
+        GST_RANK_NONE);
+    GList* matching =
+        gst_element_factory_list_filter(all, caps, GST_PAD_SINK, FALSE);
+    gst_plugin_feature_list_free(all);
+    gst_caps_unref(caps);
+
+    for (auto l = matching; l != nullptr; l = l->next) {
+      auto factory = static_cast<GstElementFactory*>(l->data);
+      if (IsUsable(factory)) {
+        ranked.push_back(
+            static_cast<GstElementFactory*>(gst_object_ref(factory)));
+      }
+    }
+    gst_plugin_feature_list_free(matching);
+
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](GstElementFactory* a, GstElementFactory* b) {
+                       const int tier_a = Tier(a);
+                       const int tier_b = Tier(b);
+                       if (tier_a != tier_b) {
+                         return tier_a < tier_b;
+                       }
+                       return gst_plugin_feature_get_rank(
+                                  GST_PLUGIN_FEATURE(a)) >
+                              gst_plugin_feature_get_rank(
+                                  GST_PLUGIN_FEATURE(b));
+                     });
+  }
+
+  if (software_fallback && software_fallback[0]) {
+    if (GstElementFactory* factory =
+            gst_element_factory_find(software_fallback)) {
+      if (std::find(ranked.begin(), ranked.end(), factory) == ranked.end()) {
+        ranked.push_back(factory);
+      } else {
+        gst_object_unref(factory);
+      }
+    }
+  }
+
+  for (const auto factory : ranked) {
+    SPDLOG_DEBUG("[VideoPlayer] codec {}: {} (tier {})",
+                 static_cast<int>(codec_id),
+                 gst_plugin_feature_get_name(GST_PLUGIN_FEATURE(factory)),
+                 Tier(factory));
+  }
+  if (ranked.empty()) {
+    spdlog::error(
+        "[VideoPlayer] No usable decoder for codec {}.  May be a missing "
+        "runtime package",
+        static_cast<int>(codec_id));
+  }
+  return ranked;
+}
+
+const char* DecoderRegistry::CodecCaps(const AVCodecID codec_id) {
+  switch (codec_id) {
+    case AV_CODEC_ID_H264:
+      return "video/x-h264";
+    case AV_CODEC_ID_HEVC:
+      return "video/x-h265";
+    case AV_CODEC_ID_VP8:
+      return "video/x-vp8";
+    case AV_CODEC_ID_VP9:
+      return "video/x-vp9";
+    case AV_CODEC_ID_AV1:
+      return "video/x-av1";
+    case AV_CODEC_ID_MPEG2VIDEO:
+      return "video/mpeg, mpegversion=(int)2, systemstream=(boolean)false";
+    case AV_CODEC_ID_MPEG4:
+      return "video/mpeg, mpegversion=(int)4, systemstream=(boolean)false";
+    case AV_CODEC_ID_MJPEG:
+      return "image/jpeg";
+    default:
+      return nullptr;
+  }
+}
+
+int DecoderRegistry::Tier(GstElementFactory* factory) {
+  const gchar* name = gst_plugin_feature_get_name(GST_PLUGIN_FEATURE(factory));
+  if (g_str_has_prefix(name, "v4l2sl")) {
+    return kTierV4l2Stateless;
+  }
+  if (g_str_has_prefix(name, "v4l2")) {
+    return kTierV4l2;
+  }
+  if (g_str_has_prefix(name, "va")) {
+    return kTierVaapi;
+  }
+  if (const gchar* klass = gst_element_factory_get_metadata(
+          factory, GST_ELEMENT_METADATA_KLASS);
+      klass && std::strstr(klass, "Hardware")) {
+    return kTierHardware;
+  }
+  return kTierSoftware;
+}
+
+bool DecoderRegistry::IsUsable(GstElementFactory* factory) {
+  GstElement* element = gst_element_factory_create(factory, nullptr);
+  if (element == nullptr) {
+    return false;
+  }
+  const bool usable =
+      gst_element_set_state(element, GST_STATE_READY) !=
+      GST_STATE_CHANGE_FAILURE;
+  gst_element_set_state(element, GST_STATE_NULL);
+  gst_object_unref(element);
+  if (!usable) {
+    SPDLOG_DEBUG("[VideoPlayer] Decoder {} not usable",
+                 gst_plugin_feature_get_name(GST_PLUGIN_FEATURE(factory)));
+  }
+  return usable;
+}
+
+bool DecoderRegistry::OutputsNV12(GstElementFactory* factory) {
+  GstCaps* nv12 = gst_caps_from_string("video/x-raw, format=(string)NV12");
+  bool result = false;
+  for (auto l = gst_element_factory_get_static_pad_templates(factory);
+       l != nullptr && !result; l = l->next) {
+    auto templ = static_cast<GstStaticPadTemplate*>(l->data);
+    if (templ->direction != GST_PAD_SRC) {
+      continue;
+    }
+    GstCaps* caps = gst_static_pad_template_get_caps(templ);
+    result = !gst_caps_is_any(caps) && gst_caps_can_intersect(caps, nv12);
+    gst_caps_unref(caps);
+  }
+  gst_caps_unref(nv12);
+  return result;
+}
+
+}  // namespace video_player_linux
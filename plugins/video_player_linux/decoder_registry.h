@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLUGINS_VIDEO_PLAYER_LINUX_DECODER_REGISTRY_H_
+#define PLUGINS_VIDEO_PLAYER_LINUX_DECODER_REGISTRY_H_
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include <gst/gst.h>
+#include <libavformat/avformat.h>
+}
+
+namespace video_player_linux {
+
+/**
+ * @brief Ranked, cached list of usable GStreamer decoders per codec.
+ *
+ * Stateless V4L2 decoders are preferred, followed by stateful V4L2, VA-API,
+ * other hardware decoders and finally software decoders.  Each candidate is
+ * probed once by bringing it to READY, so decoders whose device is missing
+ * are never handed to a player.
+ */
+class DecoderRegistry {
+ public:
+  DecoderRegistry() = default;
+  ~DecoderRegistry();
+
+  // Disallow copy and assign.
+  DecoderRegistry(const DecoderRegistry&) = delete;
+  DecoderRegistry& operator=(const DecoderRegistry&) = delete;
+
+  /**
+   * @brief Probe the decoders of commonly used codecs
+   * @param[in] software_fallback Maps a codec to its libav decoder name
+   * @return void
+   * @relation
+   * gstreamer
+   */
+  void Probe(const char* (*software_fallback)(AVCodecID));
+
+  /**
+   * @brief Get the ranked decoders for a codec, probing on first use
+   * @param[in] codec_id Codec ID
+   * @param[in] software_fallback libav decoder name, appended if not ranked
+   * @return std::vector<GstElementFactory*> Borrowed factories, best first
+   * @relation
+   * gstreamer
+   */
+  std::vector<GstElementFactory*> GetDecoders(AVCodecID codec_id,
+                                              const char* software_fallback);
+
+  /**
+   * @brief Returns true if the decoder can output NV12 in system memory
+   * @param[in] factory Decoder element factory
+   * @return bool
+   * @relation
+   * gstreamer
+   */
+  static bool OutputsNV12(GstElementFactory* factory);
+
+ private:
+  std::mutex mutex_;
+  std::map<AVCodecID, std::vector<GstElementFactory*>> cache_;
+
+  /**
+   * @brief Return the compressed caps of a codec
+   * @param[in] codec_id Codec ID
+   * @return const char* Caps string, nullptr if unknown
+   * @relation
+   * gstreamer
+   */
+  static const char* CodecCaps(AVCodecID codec_id);
+
+  /**
+   * @brief Return the preference tier of a decoder, lower is better
+   * @param[in] factory Decoder element factory
+   * @return int
+   * @relation
+   * gstreamer
+   */
+  static int Tier(GstElementFactory* factory);
+
+  /**
+   * @brief Check a decoder can be instantiated and brought to READY
+   * @param[in] factory Decoder element factory
+   * @return bool
+   * @relation
+   * gstreamer
+   */
+  static bool IsUsable(GstElementFactory* factory);
+
+  std::vector<GstElementFactory*> Rank(AVCodecID codec_id,
+                                       const char* software_fallback);
+};
+
+}  // namespace video_player_linux
+
+#endif  // PLUGINS_VIDEO_PLAYER_LINUX_DECODER_REGISTRY_H_
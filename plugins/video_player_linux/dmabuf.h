@@ -0,0 +1,331 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstring>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2ext.h>
+#include <GLES3/gl3.h>
+
+extern "C" {
+#include <gst/allocators/gstdmabuf.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+}
+
+#include <plugins/common/common.h>
+
+namespace video_player_linux::dmabuf {
+
+/// Caps feature advertised by decoders able to export DMA-BUF memory.
+static constexpr char kCapsFeatureMemoryDmaBuf[] = "memory:DMABuf";
+
+/// DRM fourcc codes (see drm_fourcc.h), kept local to avoid a libdrm
+/// dependency.
+static constexpr uint32_t fourcc_code(const char a,
+                                      const char b,
+                                      const char c,
+                                      const char d) {
+  return static_cast<uint32_t>(a) | static_cast<uint32_t>(b) << 8 |
+         static_cast<uint32_t>(c) << 16 | static_cast<uint32_t>(d) << 24;
+}
+static constexpr uint32_t kDrmFormatNV12 = fourcc_code('N', 'V', '1', '2');
+
+/**
+ * @brief Returns true if the decoder factory can output DMA-BUF backed frames
+ * @param[in] factory Decoder element factory
+ * @return bool
+ * @retval true Source pad template advertises memory:DMABuf
+ * @retval false Otherwise
+ * @relation
+ * gstreamer
+ */
+inline bool factory_supports_dmabuf(GstElementFactory* factory) {
+  if (factory == nullptr) {
+    return false;
+  }
+  const GList* templates =
+      gst_element_factory_get_static_pad_templates(factory);
+  for (auto l = templates; l != nullptr; l = l->next) {
+    auto templ = static_cast<GstStaticPadTemplate*>(l->data);
+    if (templ->direction != GST_PAD_SRC) {
+      continue;
+    }
+    GstCaps* caps = gst_static_pad_template_get_caps(templ);
+    const guint size = gst_caps_get_size(caps);
+    for (guint i = 0; i < size; i++) {
+      const GstCapsFeatures* features = gst_caps_get_features(caps, i);
+      if (features &&
+          gst_caps_features_contains(features, kCapsFeatureMemoryDmaBuf)) {
+        gst_caps_unref(caps);
+        return true;
+      }
+    }
+    gst_caps_unref(caps);
+  }
+  return false;
+}
+
+/**
+ * @brief Imports NV12 DMA-BUF GstBuffers as EGLImages bound to an external
+ * texture.  No pixel data is touched by the CPU; the GPU samples the decoder
+ * output directly.
+ *
+ * Must be constructed and used with the texture registrar context current.
+ */
+class Importer {
+ public:
+  Importer() {
+    display_ = eglGetCurrentDisplay();
+    if (display_ == EGL_NO_DISPLAY) {
+      spdlog::warn("[VideoPlayer] DMA-BUF import disabled: no EGL display");
+      return;
+    }
+
+    const char* extensions = eglQueryString(display_, EGL_EXTENSIONS);
+    if (extensions == nullptr ||
+        std::strstr(extensions, "EGL_EXT_image_dma_buf_import") == nullptr) {
+      spdlog::info(
+          "[VideoPlayer] DMA-BUF import disabled: "
+          "EGL_EXT_image_dma_buf_import not supported");
+      return;
+    }
+
+    const auto gl_extensions =
+        reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (gl_extensions == nullptr ||
+        std::strstr(gl_extensions, "GL_OES_EGL_image_external") == nullptr) {
+      spdlog::info(
+          "[VideoPlayer] DMA-BUF import disabled: "
+          "GL_OES_EGL_image_external not supported");
+      return;
+    }
+
+    create_image_ = reinterpret_cast<PFNEGLCREATEIMAGEKHRPROC>(
+        eglGetProcAddress("eglCreateImageKHR"));
+    destroy_image_ = reinterpret_cast<PFNEGLDESTROYIMAGEKHRPROC>(
+        eglGetProcAddress("eglDestroyImageKHR"));
+    image_target_texture_ =
+        reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
+            eglGetProcAddress("glEGLImageTargetTexture2DOES"));
+    if (!create_image_ || !destroy_image_ || !image_target_texture_) {
+      spdlog::warn("[VideoPlayer] DMA-BUF import disabled: missing EGL procs");
+      return;
+    }
+
+    glGenTextures(1, &texture_);
+    glBindTexture(GL_TEXTURE_EXTERNAL_OES, texture_);
+    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_S,
+                    GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_T,
+                    GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
+
+    supported_ = true;
+  }
+
+  ~Importer() {
+    release_image();
+    if (texture_) {
+      glDeleteTextures(1, &texture_);
+    }
+  }
+
+  Importer(const Importer&) = delete;
+  Importer& operator=(const Importer&) = delete;
+
+  [[nodiscard]] bool is_supported() const { return supported_; }
+
+  [[nodiscard]] GLuint texture() const { return texture_; }
+
+  /**
+   * @brief Returns true if every memory block of buffer is a DMA-BUF
+   * @param[in] buffer Frame buffer
+   * @return bool
+   * @relation
+   * gstreamer
+   */
+  static bool is_dmabuf(GstBuffer* buffer) {
+    const guint n_mem = gst_buffer_n_memory(buffer);
+    if (n_mem == 0) {
+      return false;
+    }
+    for (guint i = 0; i < n_mem; i++) {
+      if (!gst_is_dmabuf_memory(gst_buffer_peek_memory(buffer, i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Import a NV12 DMA-BUF frame and bind it to the external texture
+   * @param[in] buffer Frame buffer holding DMA-BUF memory
+   * @param[in] info Negotiated video info, used for the colorimetry and
+   * when no GstVideoMeta exists
+   * @return bool
+   * @retval true Texture bound to the new frame
+   * @retval false Import failed, caller should use the upload path
+   * @relation
+   * flutter
+   */
+  bool import(GstBuffer* buffer, const GstVideoInfo* info) {
+    if (!supported_) {
+      return false;
+    }
+
+    gint width = GST_VIDEO_INFO_WIDTH(info);
+    gint height = GST_VIDEO_INFO_HEIGHT(info);
+    gsize offsets[2] = {GST_VIDEO_INFO_PLANE_OFFSET(info, 0),
+                        GST_VIDEO_INFO_PLANE_OFFSET(info, 1)};
+    gint strides[2] = {GST_VIDEO_INFO_PLANE_STRIDE(info, 0),
+                       GST_VIDEO_INFO_PLANE_STRIDE(info, 1)};
+
+    // Decoders commonly pad planes; the video meta carries the real layout.
+    if (const GstVideoMeta* meta = gst_buffer_get_video_meta(buffer)) {
+      if (meta->format != GST_VIDEO_FORMAT_NV12 || meta->n_planes != 2) {
+        return false;
+      }
+      width = static_cast<gint>(meta->width);
+      height = static_cast<gint>(meta->height);
+      for (guint i = 0; i < 2; i++) {
+        offsets[i] = meta->offset[i];
+        strides[i] = meta->stride[i];
+      }
+    } else if (GST_VIDEO_INFO_FORMAT(info) != GST_VIDEO_FORMAT_NV12) {
+      return false;
+    }
+
+    gint fds[2];
+    for (guint i = 0; i < 2; i++) {
+      guint mem_idx, length;
+      gsize skip;
+      if (!gst_buffer_find_memory(buffer, offsets[i], 1, &mem_idx, &length,
+                                  &skip)) {
+        SPDLOG_ERROR("[VideoPlayer] DMA-BUF plane {} not found", i);
+        return false;
+      }
+      GstMemory* mem = gst_buffer_peek_memory(buffer, mem_idx);
+      fds[i] = gst_dmabuf_memory_get_fd(mem);
+      offsets[i] = mem->offset + skip;
+    }
+
+    const EGLint attribs[] = {
+        EGL_WIDTH,
+        width,
+        EGL_HEIGHT,
+        height,
+        EGL_LINUX_DRM_FOURCC_EXT,
+        static_cast<EGLint>(kDrmFormatNV12),
+        EGL_DMA_BUF_PLANE0_FD_EXT,
+        fds[0],
+        EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+        static_cast<EGLint>(offsets[0]),
+        EGL_DMA_BUF_PLANE0_PITCH_EXT,
+        strides[0],
+        EGL_DMA_BUF_PLANE1_FD_EXT,
+        fds[1],
+        EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+        static_cast<EGLint>(offsets[1]),
+        EGL_DMA_BUF_PLANE1_PITCH_EXT,
+        strides[1],
+        EGL_YUV_COLOR_SPACE_HINT_EXT,
+        color_space_hint(info->colorimetry),
+        EGL_SAMPLE_RANGE_HINT_EXT,
+        sample_range_hint(info->colorimetry),
+        EGL_NONE,
+    };
+
+    release_image();
+    image_ = create_image_(display_, EGL_NO_CONTEXT, EGL_LINUX_DMA_BUF_EXT,
+                           nullptr, attribs);
+    if (image_ == EGL_NO_IMAGE_KHR) {
+      SPDLOG_ERROR("[VideoPlayer] eglCreateImageKHR failed: 0x{:X}",
+                   eglGetError());
+      return false;
+    }
+
+    glBindTexture(GL_TEXTURE_EXTERNAL_OES, texture_);
+    image_target_texture_(GL_TEXTURE_EXTERNAL_OES, image_);
+    glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
+    return true;
+  }
+
+  /**
+   * @brief Release the EGLImage of the last imported frame.  Call once the
+   * frame has been drawn so the decoder can recycle the buffer.
+   * @return void
+   * @relation
+   * flutter
+   */
+  void release_image() {
+    if (image_ != EGL_NO_IMAGE_KHR) {
+      destroy_image_(display_, image_);
+      image_ = EGL_NO_IMAGE_KHR;
+    }
+  }
+
+ private:
+  /**
+   * @brief Map the stream's YUV matrix to the EGL color space hint
+   * @param[in] colorimetry Colorimetry from the negotiated caps
+   * @return EGLint
+   * @relation
+   * gstreamer
+   */
+  static EGLint color_space_hint(const GstVideoColorimetry& colorimetry) {
+    switch (colorimetry.matrix) {
+      case GST_VIDEO_COLOR_MATRIX_BT601:
+      case GST_VIDEO_COLOR_MATRIX_FCC:
+        return EGL_ITU_REC601_EXT;
+      case GST_VIDEO_COLOR_MATRIX_BT2020:
+        return EGL_ITU_REC2020_EXT;
+      default:
+        // BT.709, and SMPTE 240M which is close to it. Caps without a
+        // matrix get one from gst_video_info_from_caps.
+        return EGL_ITU_REC709_EXT;
+    }
+  }
+
+  /**
+   * @brief Map the stream's sample range to the EGL sample range hint
+   * @param[in] colorimetry Colorimetry from the negotiated caps
+   * @return EGLint
+   * @relation
+   * gstreamer
+   */
+  static EGLint sample_range_hint(const GstVideoColorimetry& colorimetry) {
+    return colorimetry.range == GST_VIDEO_COLOR_RANGE_0_255
+               ? EGL_YUV_FULL_RANGE_EXT
+               : EGL_YUV_NARROW_RANGE_EXT;
+  }
+
+  bool supported_{};
+  EGLDisplay display_ = EGL_NO_DISPLAY;
+  EGLImageKHR image_ = EGL_NO_IMAGE_KHR;
+  GLuint texture_{};
+
+  PFNEGLCREATEIMAGEKHRPROC create_image_{};
+  PFNEGLDESTROYIMAGEKHRPROC destroy_image_{};
+  PFNGLEGLIMAGETARGETTEXTURE2DOESPROC image_target_texture_{};
+};
+
+}  // namespace video_player_linux::dmabuf
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2024 Toyota Connected North America
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include <flutter/encodable_value.h>
+
+namespace video_player_linux {
+
+/**
+ * @brief Frame pacing counters for a single player.  Updated from the
+ * streaming thread, the texture callback and the bus handler; read from the
+ * platform thread.
+ */
+class FrameStats {
+ public:
+  /// Upper bounds (exclusive, in milliseconds) of the latency histogram
+  /// buckets.  A final bucket collects everything above the last bound.
+  static constexpr std::array<int64_t, 5> kLatencyBucketsMs = {4, 8, 16, 33,
+                                                               66};
+
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief A decoded frame was queued by the sink
+   * @param[in] queue_depth Queue depth after queueing
+   * @param[in] dropped Frames evicted to make room
+   * @return void
+   */
+  void RecordQueued(const size_t queue_depth, const size_t dropped) {
+    std::lock_guard lock(mutex_);
+    frames_queued_++;
+    frames_dropped_queue_ += dropped;
+    queue_depth_ = queue_depth;
+    if (queue_depth > max_queue_depth_) {
+      max_queue_depth_ = queue_depth;
+    }
+  }
+
+  /**
+   * @brief Queued frames were skipped because a newer frame was presented
+   * @param[in] skipped Number of skipped frames
+   * @return void
+   */
+  void RecordSkipped(const size_t skipped) {
+    std::lock_guard lock(mutex_);
+    frames_dropped_queue_ += skipped;
+    queue_depth_ = 0;
+  }
+
+  /**
+   * @brief A frame was converted into the Flutter texture
+   * @param[in] queued_at Time the sink queued the frame
+   * @param[in] upload_start Time conversion started
+   * @param[in] upload_end Time conversion finished
+   * @return void
+   */
+  void RecordPresented(const Clock::time_point queued_at,
+                       const Clock::time_point upload_start,
+                       const Clock::time_point upload_end) {
+    const auto latency_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(upload_end -
+                                                              queued_at)
+            .count();
+    const auto upload_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(upload_end -
+                                                              upload_start)
+            .count();
+
+    std::lock_guard lock(mutex_);
+    frames_presented_++;
+    upload_us_total_ += upload_us;
+    if (upload_us > upload_us_max_) {
+      upload_us_max_ = upload_us;
+    }
+    size_t bucket = 0;
+    while (bucket < kLatencyBucketsMs.size() &&
+           latency_us >= kLatencyBucketsMs[bucket] * 1000) {
+      bucket++;
+    }
+    latency_histogram_[bucket]++;
+  }
+
+  /**
+   * @brief Update sink QoS counters from a GST_MESSAGE_QOS
+   * @param[in] dropped Total frames dropped by the sink
+   * @param[in] late True if the reported buffer was late
+   * @return void
+   */
+  void RecordQos(const uint64_t dropped, const bool late) {
+    std::lock_guard lock(mutex_);
+    frames_dropped_sink_ = dropped;
+    if (late) {
+      frames_late_++;
+    }
+  }
+
+  /**
+   * @brief Snapshot of all counters for the method channel
+   * @return flutter::EncodableMap
+   */
+  flutter::EncodableMap ToEncodableMap() const {
+    std::lock_guard lock(mutex_);
+    flutter::EncodableList histogram;
+    for (const auto count : latency_histogram_) {
+      histogram.emplace_back(static_cast<int64_t>(count));
+    }
+    flutter::EncodableList bounds;
+    for (const auto bound : kLatencyBucketsMs) {
+      bounds.emplace_back(bound);
+    }
+    const int64_t upload_us_avg =
+        frames_presented_ ? upload_us_total_ /
+                                static_cast<int64_t>(frames_presented_)
+                          : 0;
+    return flutter::EncodableMap{
+        {flutter::EncodableValue("framesQueued"),
+         flutter::EncodableValue(static_cast<int64_t>(frames_queued_))},
+        {flutter::EncodableValue("framesPresented"),
+         flutter::EncodableValue(static_cast<int64_t>(frames_presented_))},
+        {flutter::EncodableValue("framesDroppedQueue"),
+         flutter::EncodableValue(static_cast<int64_t>(frames_dropped_queue_))},
+        {flutter::EncodableValue("framesDroppedSink"),
+         flutter::EncodableValue(static_cast<int64_t>(frames_dropped_sink_))},
+        {flutter::EncodableValue("framesLate"),
+         flutter::EncodableValue(static_cast<int64_t>(frames_late_))},
+        {flutter::EncodableValue("queueDepth"),
+         flutter::EncodableValue(static_cast<int64_t>(queue_depth_))},
+        {flutter::EncodableValue("maxQueueDepth"),
+         flutter::EncodableValue(static_cast<int64_t>(max_queue_depth_))},
+        {flutter::EncodableValue("uploadUsAvg"),
+         flutter::EncodableValue(upload_us_avg)},
+        {flutter::EncodableValue("uploadUsMax"),
+         flutter::EncodableValue(upload_us_max_)},
+        {flutter::EncodableValue("latencyBucketsMs"),
+         flutter::EncodableValue(bounds)},
+        {flutter::EncodableValue("latencyHistogram"),
+         flutter::EncodableValue(histogram)},
+    };
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  uint64_t frames_queued_{};
+  uint64_t frames_presented_{};
+  uint64_t frames_dropped_queue_{};
+  uint64_t frames_dropped_sink_{};
+  uint64_t frames_late_{};
+  size_t queue_depth_{};
+  size_t max_queue_depth_{};
+  int64_t upload_us_total_{};
+  int64_t upload_us_max_{};
+  std::array<uint64_t, kLatencyBucketsMs.size() + 1> latency_histogram_{};
+};
+
+}  // namespace video_player_linux
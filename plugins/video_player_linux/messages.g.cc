@@ -416,6 +416,40 @@ void VideoPlayerApi::SetUp(flutter::BinaryMessenger* binary_messenger,
       channel->SetMessageHandler(nullptr);
     }
   }
+  {
+    const auto channel = std::make_unique<BasicMessageChannel<>>(
+        binary_messenger,
+        "dev.flutter.pigeon.video_player_linux.LinuxVideoPlayerApi.getStats",
+        &GetCodec());
+    if (api != nullptr) {
+      channel->SetMessageHandler(
+          [api](const EncodableValue& message,
+                const flutter::MessageReply<EncodableValue>& reply) {
+            try {
+              const auto& args = std::get<EncodableList>(message);
+              const auto& encodable_texture_id_arg = args.at(0);
+              if (encodable_texture_id_arg.IsNull()) {
+                reply(WrapError("texture_id_arg unexpectedly null."));
+                return;
+              }
+              const int64_t texture_id_arg =
+                  encodable_texture_id_arg.LongValue();
+              ErrorOr<EncodableMap> output = api->GetStats(texture_id_arg);
+              if (output.has_error()) {
+                reply(WrapError(output.error()));
+                return;
+              }
+              EncodableList wrapped;
+              wrapped.emplace_back(std::move(output).TakeValue());
+              reply(EncodableValue(std::move(wrapped)));
+            } catch (const std::exception& exception) {
+              reply(WrapError(exception.what()));
+            }
+          });
+    } else {
+      channel->SetMessageHandler(nullptr);
+    }
+  }
 }
 
 EncodableValue VideoPlayerApi::WrapError(const std::string_view error_message) {
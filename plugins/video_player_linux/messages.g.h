@@ -96,6 +96,9 @@ class VideoPlayerApi {
                                              int64_t position) = 0;
   // Pauses the video in the video player with the given textureId.
   virtual std::optional<FlutterError> Pause(int64_t texture_id) = 0;
+  // Gets frame pacing statistics of the video player with the given
+  // textureId.
+  virtual ErrorOr<flutter::EncodableMap> GetStats(int64_t texture_id) = 0;
 
   // The codec used by LinuxVideoPlayerApi.
   static const flutter::StandardMessageCodec& GetCodec();
@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include <GLES2/gl2ext.h>
 #include <GLES3/gl3.h>
 #include <glib.h>
 
@@ -58,63 +63,39 @@ static const GLchar* kFragmentSource = R"glsl(
   }
 )glsl";
 
-class Shader {
+/// Samples an EGLImage imported from a DMA-BUF; YUV to RGB conversion is
+/// performed by the driver.
+static const GLchar* kExternalFragmentSource = R"glsl(
+  #version 300 es
+  #extension GL_OES_EGL_image_external_essl3 : require
+  precision highp float;
+  in vec2 Texcoord;
+  uniform samplerExternalOES textureExt;
+  layout(location = 0) out vec4 fragColor;
+  void main() {
+    fragColor = texture(textureExt, vec2(Texcoord.x, 1.0 - Texcoord.y));
+  }
+)glsl";
+
+/**
+ * @brief Program, quad geometry and vertex array shared by every player
+ * created through the same texture registrar.  Compiling and linking is done
+ * once instead of per player.
+ */
+class Program {
  public:
-  GLuint textureId{};
-  GLuint framebuffer{};
-  GLuint program;
-  GLsizei width, height;
+  GLuint program{};
   GLuint vertex_arr_id_{};
+  GLint texY{};
+  GLint texUV{};
 
-  Shader(GLsizei _width, GLsizei _height) : width(_width), height(_height) {
-    glGenFramebuffers(1, &framebuffer);
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-
+  Program() {
     glGenVertexArrays(1, &vertex_arr_id_);
     glBindVertexArray(vertex_arr_id_);
 
     program = load_shaders();
     texY = glGetUniformLocation(program, "textureY");
     texUV = glGetUniformLocation(program, "textureUV");
-    glUseProgram(program);
-
-    glGenTextures(2, &innerTexture[0]);
-    glGenTextures(1, &textureId);
-    glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    glBindTexture(GL_TEXTURE_2D, textureId);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
-                 GL_UNSIGNED_BYTE, nullptr);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
-                           textureId, 0);
-
-    auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-    if (status != GL_FRAMEBUFFER_COMPLETE) {
-      spdlog::error("FramebufferStatus: 0x{:X}", status);
-    }
-
-    auto size = static_cast<unsigned long>(width) *
-                static_cast<unsigned long>(height) * 3;
-    auto pixels = new unsigned char[size]{0};
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, static_cast<GLsizei>(width),
-                 static_cast<GLsizei>(height), 0, GL_RGB, GL_UNSIGNED_BYTE,
-                 pixels);
-    delete[] pixels;
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glGenerateMipmap(GL_TEXTURE_2D);
 
     glGenBuffers(1, &vertex_buffer_);
     glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
@@ -132,32 +113,319 @@ class Shader {
     };
     glBufferData(GL_ARRAY_BUFFER, sizeof(coord_buffer_data), coord_buffer_data,
                  GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+
+  ~Program() {
+    glDeleteBuffers(1, &coord_buffer_);
+    glDeleteBuffers(1, &vertex_buffer_);
+    glDeleteVertexArrays(1, &vertex_arr_id_);
+    glDeleteProgram(program);
+    if (program_ext_) {
+      glDeleteProgram(program_ext_);
+    }
+  }
+
+  Program(const Program&) = delete;
+  Program& operator=(const Program&) = delete;
+
+  /**
+   * @brief Program sampling an external (EGLImage) texture, built on first use
+   * @return GLuint
+   * @relation
+   * flutter
+   */
+  GLuint external_program() {
+    if (!program_ext_) {
+      program_ext_ = load_shaders(kVertexSource, kExternalFragmentSource);
+      texExt_ = glGetUniformLocation(program_ext_, "textureExt");
+    }
+    return program_ext_;
+  }
+
+  [[nodiscard]] GLint tex_ext() const { return texExt_; }
+
+  /**
+   * @brief Draw the full screen quad into the bound framebuffer
+   * @param[in] prog Program to draw with
+   * @param[in] width Framebuffer width
+   * @param[in] height Framebuffer height
+   * @return void
+   * @relation
+   * flutter
+   */
+  void draw(const GLuint prog, const GLsizei width, const GLsizei height) const {
+    SPDLOG_TRACE("[VideoPlayer] draw_core");
+    glViewport(-width / 2, -height / 2, width * 2, height * 2);
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glUseProgram(prog);
 
     glEnableVertexAttribArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+
     glEnableVertexAttribArray(1);
     glBindBuffer(GL_ARRAY_BUFFER, coord_buffer_);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
     glDrawArrays(GL_TRIANGLES, 0, 6);
+
     glDisableVertexAttribArray(0);
+    glDisableVertexAttribArray(1);
 
     glFinish();
+  }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  static GLuint load_shaders(const GLchar* vsource = kVertexSource,
+                             const GLchar* fsource = kFragmentSource) {
+    GLint result;
+    GLsizei length;
+    GLchar info[1000]{};
+
+    const GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertex_shader, 1, &vsource, nullptr);
+    glCompileShader(vertex_shader);
+    glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &result);
+    if (result == GL_FALSE) {
+      glGetShaderInfoLog(vertex_shader, sizeof(info), &length, info);
+      SPDLOG_ERROR("Failed to compile {}", info);
+      glDeleteShader(vertex_shader);
+      return 0;
+    }
+
+    const GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragment_shader, 1, &fsource, nullptr);
+    glCompileShader(fragment_shader);
+    glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &result);
+    if (result == GL_FALSE) {
+      glGetShaderInfoLog(fragment_shader, sizeof(info), &length, info);
+      SPDLOG_ERROR("Fail to compile {}", info);
+      glDeleteShader(vertex_shader);
+      glDeleteShader(fragment_shader);
+      return 0;
+    }
+
+    const GLuint shaderProgram = glCreateProgram();
+    glAttachShader(shaderProgram, vertex_shader);
+    glAttachShader(shaderProgram, fragment_shader);
+    glLinkProgram(shaderProgram);
+
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &result);
+    if (result == GL_FALSE) {
+      glGetProgramInfoLog(shaderProgram, sizeof(info), &length, info);
+      SPDLOG_ERROR("Fail to link {}", info);
+      glDeleteShader(vertex_shader);
+      glDeleteShader(fragment_shader);
+      glDeleteProgram(shaderProgram);
+      return 0;
+    }
+
+    glDetachShader(shaderProgram, vertex_shader);
+    glDetachShader(shaderProgram, fragment_shader);
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+    return shaderProgram;
   }
 
-  ~Shader() {
-    glDeleteBuffers(1, &coord_buffer_);
-    glDeleteBuffers(1, &vertex_buffer_);
-    glDeleteVertexArrays(1, &vertex_arr_id_);
-    glDeleteProgram(program);
+ private:
+  GLuint program_ext_{};
+  GLint texExt_{};
+
+  GLuint vertex_buffer_{};
+  GLuint coord_buffer_{};
+};
+
+/**
+ * @brief Per player render target: the framebuffer, the RGBA texture handed
+ * to Flutter and the Y/UV upload textures.  Instances are recycled through
+ * ShaderPool.
+ */
+struct Surface {
+  GLsizei width;
+  GLsizei height;
+  GLenum format;
+  GLuint textureId{};
+  GLuint framebuffer{};
+  GLuint innerTexture[2]{};
+
+  Surface(const GLsizei _width, const GLsizei _height, const GLenum _format)
+      : width(_width), height(_height), format(_format) {
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    glGenTextures(2, &innerTexture[0]);
+    glGenTextures(1, &textureId);
+
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(format), width, height,
+                 0, format, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           textureId, 0);
+
+    auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+      spdlog::error("FramebufferStatus: 0x{:X}", status);
+    }
+
+    clear();
+  }
+
+  ~Surface() {
     glDeleteTextures(1, &textureId);
     glDeleteTextures(2, &innerTexture[0]);
     glDeleteFramebuffers(1, &framebuffer);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
   }
 
+  Surface(const Surface&) = delete;
+  Surface& operator=(const Surface&) = delete;
+
+  /**
+   * @brief Clear the render target so a recycled surface shows no stale frame
+   * @return void
+   * @relation
+   * flutter
+   */
+  void clear() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+    glClearColor(0, 0, 0, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  }
+};
+
+/**
+ * @brief Shared GL resources for all players of one texture registrar.
+ * Holds the compiled Program and a bounded pool of idle Surfaces keyed by
+ * (width, height, format).
+ *
+ * All methods must be called with the texture registrar context current.
+ */
+class ShaderPool {
+ public:
+  /// Idle surfaces kept for reuse; older ones are freed beyond this.
+  static constexpr size_t kMaxIdleSurfaces = 4;
+
+  ShaderPool() = default;
+
+  ~ShaderPool() { Clear(); }
+
+  ShaderPool(const ShaderPool&) = delete;
+  ShaderPool& operator=(const ShaderPool&) = delete;
+
+  /**
+   * @brief Get the shared program, compiling it on first use
+   * @return std::shared_ptr<Program>
+   * @relation
+   * flutter
+   */
+  std::shared_ptr<Program> GetProgram() {
+    std::lock_guard lock(mutex_);
+    if (!program_) {
+      program_ = std::make_shared<Program>();
+    }
+    return program_;
+  }
+
+  /**
+   * @brief Borrow a surface matching the requested size and format
+   * @param[in] width Surface width
+   * @param[in] height Surface height
+   * @param[in] format Texture format
+   * @return std::unique_ptr<Surface>
+   * @relation
+   * flutter
+   */
+  std::unique_ptr<Surface> Acquire(const GLsizei width,
+                                   const GLsizei height,
+                                   const GLenum format = GL_RGBA) {
+    {
+      std::lock_guard lock(mutex_);
+      for (auto it = idle_.begin(); it != idle_.end(); ++it) {
+        if ((*it)->width == width && (*it)->height == height &&
+            (*it)->format == format) {
+          auto surface = std::move(*it);
+          idle_.erase(it);
+          surface->clear();
+          SPDLOG_DEBUG("[VideoPlayer] Reusing surface {}x{}", width, height);
+          return surface;
+        }
+      }
+    }
+    return std::make_unique<Surface>(width, height, format);
+  }
+
+  /**
+   * @brief Return a surface to the pool
+   * @param[in] surface Surface previously obtained from Acquire
+   * @return void
+   * @relation
+   * flutter
+   */
+  void Release(std::unique_ptr<Surface> surface) {
+    if (!surface) {
+      return;
+    }
+    std::lock_guard lock(mutex_);
+    idle_.push_back(std::move(surface));
+    while (idle_.size() > kMaxIdleSurfaces) {
+      idle_.pop_front();
+    }
+  }
+
+  /**
+   * @brief Free the program and all idle surfaces
+   * @return void
+   * @relation
+   * flutter
+   */
+  void Clear() {
+    std::lock_guard lock(mutex_);
+    idle_.clear();
+    program_.reset();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::shared_ptr<Program> program_;
+  std::deque<std::unique_ptr<Surface>> idle_;
+};
+
+/**
+ * @brief Converts NV12 or RGB frames into the RGBA texture presented to
+ * Flutter, using the pooled program and a borrowed surface.
+ */
+class Shader {
+ public:
+  GLuint textureId{};
+  GLuint framebuffer{};
+  GLsizei width, height;
+  GLuint vertex_arr_id_{};
+
+  Shader(std::shared_ptr<ShaderPool> pool, GLsizei _width, GLsizei _height)
+      : width(_width),
+        height(_height),
+        pool_(std::move(pool)),
+        program_(pool_->GetProgram()),
+        surface_(pool_->Acquire(_width, _height)) {
+    textureId = surface_->textureId;
+    framebuffer = surface_->framebuffer;
+    vertex_arr_id_ = program_->vertex_arr_id_;
+  }
+
+  ~Shader() { pool_->Release(std::move(surface_)); }
+
+  Shader(const Shader&) = delete;
+  Shader& operator=(const Shader&) = delete;
+
   /**
    * @brief Load pixels
    * @param[in] y_buf Pointer to image data for luminance signal
@@ -175,15 +443,16 @@ class Shader {
                    const GLsizei y_p_s,
                    const GLsizei y_s,
                    const GLsizei uv_p_s,
-                   const GLsizei uv_s) {
+                   const GLsizei uv_s) const {
     (void)y_p_s;
     (void)uv_p_s;
     SPDLOG_TRACE("[VideoPlayer] load_pixels");
     glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glUseProgram(program_->program);
 
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, innerTexture[0]);
-    glUniform1i(texY, 0);
+    glBindTexture(GL_TEXTURE_2D, surface_->innerTexture[0]);
+    glUniform1i(program_->texY, 0);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -196,9 +465,9 @@ class Shader {
     glGenerateMipmap(GL_TEXTURE_2D);
 
     glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, innerTexture[1]);
+    glBindTexture(GL_TEXTURE_2D, surface_->innerTexture[1]);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glUniform1i(texUV, 1);
+    glUniform1i(program_->texUV, 1);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -217,72 +486,25 @@ class Shader {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
   }
 
-  GLuint load_shaders(const GLchar* vsource = kVertexSource,
-                      const GLchar* fsource = kFragmentSource) {
-    GLint result;
-    GLsizei length;
-    GLchar* info{};
-
-    vertex_shader_ = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex_shader_, 1, &vsource, nullptr);
-    glCompileShader(vertex_shader_);
-    glGetShaderiv(vertex_shader_, GL_COMPILE_STATUS, &result);
-    if (result == GL_FALSE) {
-      glGetShaderInfoLog(vertex_shader_, 1000, &length, info);
-      SPDLOG_ERROR("Failed to compile {}", info);
-      return 0;
-    }
-
-    fragment_shader_ = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment_shader_, 1, &fsource, nullptr);
-    glCompileShader(fragment_shader_);
-    glGetShaderiv(fragment_shader_, GL_COMPILE_STATUS, &result);
-    if (result == GL_FALSE) {
-      glGetShaderInfoLog(fragment_shader_, 1000, &length, info);
-      SPDLOG_ERROR("Fail to compile {}", info);
-      return 0;
-    }
-
-    const GLuint shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertex_shader_);
-    glAttachShader(shaderProgram, fragment_shader_);
-    glLinkProgram(shaderProgram);
-
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &result);
-    if (result == GL_FALSE) {
-      glGetProgramInfoLog(shaderProgram, 1000, &length, info);
-      SPDLOG_ERROR("Fail to link {}", info);
-      return 0;
-    }
-
-    glDetachShader(shaderProgram, vertex_shader_);
-    glDetachShader(shaderProgram, fragment_shader_);
-    glDeleteShader(vertex_shader_);
-    glDeleteShader(fragment_shader_);
-    return shaderProgram;
-  }
-
-  void draw_core() const {
-    SPDLOG_TRACE("[VideoPlayer] draw_core");
-    glViewport(-width / 2, -height / 2, width * 2, height * 2);
-    glClearColor(0, 0, 0, 0);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glUseProgram(program);
-
-    glEnableVertexAttribArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-    glEnableVertexAttribArray(1);
-    glBindBuffer(GL_ARRAY_BUFFER, coord_buffer_);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    glDisableVertexAttribArray(0);
-    glDisableVertexAttribArray(1);
+  void draw_core() const { program_->draw(program_->program, width, height); }
 
-    glFinish();
+  /**
+   * @brief Draw an external texture bound to an EGLImage into the framebuffer
+   * @param[in] texture GL_TEXTURE_EXTERNAL_OES texture name
+   * @return void
+   * @relation
+   * flutter
+   */
+  void draw_external(const GLuint texture) const {
+    const GLuint prog = program_->external_program();
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glUseProgram(prog);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_EXTERNAL_OES, texture);
+    glUniform1i(program_->tex_ext(), 0);
+    program_->draw(prog, width, height);
+    glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
   }
 
   void load_rgb_pixels(gpointer data) const {
@@ -302,15 +524,9 @@ class Shader {
   }
 
  private:
-  GLint texY{};
-  GLint texUV{};
-  GLuint innerTexture[2]{};
-
-  GLuint vertex_shader_{};
-  GLuint fragment_shader_{};
-
-  GLuint vertex_buffer_{};
-  GLuint coord_buffer_{};
+  std::shared_ptr<ShaderPool> pool_;
+  std::shared_ptr<Program> program_;
+  std::unique_ptr<Surface> surface_;
 };
 
 }  // namespace video_player_linux::nv12
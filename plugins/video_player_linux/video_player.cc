@@ -24,6 +24,7 @@
 
 #include <backend/backend.h>
 #include <plugins/common/common.h>
+#include <plugins/common/egl/context_guard.h>
 #include <utility>
 
 #define GSTREAMER_DEBUG 0
@@ -42,28 +43,36 @@ VideoPlayer::VideoPlayer(flutter::PluginRegistrarDesktop* registrar,
                          const GLsizei width,
                          const GLsizei height,
                          const gint64 duration,
-                         GstElementFactory* decoder_factory)
+                         std::vector<GstElementFactory*> decoder_factories,
+                         std::shared_ptr<nv12::ShaderPool> shader_pool)
     : m_registrar(registrar),
       uri_(std::move(uri)),
       http_headers_(std::move(http_headers)),
       width_(width),
       height_(height),
       duration_(duration),
-      decoder_factory_(decoder_factory),
+      decoder_factories_(std::move(decoder_factories)),
+      shader_pool_(std::move(shader_pool)),
       media_state_(GST_STATE_VOID_PENDING),
       event_channel_(nullptr) {
   SPDLOG_DEBUG(
       "[VideoPlayer] uri: {}, http_headers: {}, size: {} x {}, duration: {}",
       uri.c_str(), http_headers_.size(), width, height, duration);
 
+  for (const auto factory : decoder_factories_) {
+    gst_object_ref(factory);
+  }
+
   std::lock_guard buffer_lock(buffer_mutex_);
 
   /// Setup OpenGL
 
   m_registrar->texture_registrar()->TextureMakeCurrent();
-  shader_ = std::make_unique<nv12::Shader>(width_, height_);
+  shader_ = std::make_unique<nv12::Shader>(shader_pool_, width_, height_);
   m_texture_id = shader_->textureId;
 
+  dmabuf_importer_ = std::make_unique<dmabuf::Importer>();
+
   /// Setup GL Texture 2D
 
   m_descriptor.struct_size = sizeof(FlutterDesktopGpuSurfaceDescriptor);
@@ -80,7 +89,7 @@ VideoPlayer::VideoPlayer(flutter::PluginRegistrarDesktop* registrar,
       kFlutterDesktopGpuSurfaceTypeGlTexture2D,
       [&](size_t /* width */,
           size_t /* height */) -> const FlutterDesktopGpuSurfaceDescriptor* {
-        return &m_descriptor;
+        return ObtainDescriptor();
       });
 
   flutter::TextureVariant texture = *gpu_surface_texture_;
@@ -115,75 +124,291 @@ VideoPlayer::VideoPlayer(flutter::PluginRegistrarDesktop* registrar,
   g_object_set(playbin_, "flags", flags, nullptr);
   g_object_set(playbin_, "connection-speed", 56, nullptr);
 
-  sink_ = gst_element_factory_make("fakesink", nullptr);
+  if (!BuildVideoSink()) {
+    spdlog::error("[VideoPlayer] Failed to build video sink");
+  }
+
+  bus_ = gst_element_get_bus(playbin_);
+  GSource* bus_source = gst_bus_create_watch(bus_);
+  g_source_set_callback(
+      bus_source, reinterpret_cast<GSourceFunc>(gst_bus_async_signal_func),
+      nullptr, nullptr);
+  g_source_attach(bus_source, context_);
+  g_source_unref(bus_source);
+  on_bus_msg_id_ = g_signal_connect(
+      bus_, "message", reinterpret_cast<GCallback>(OnBusMessage), this);
+
+  m_registrar->texture_registrar()->TextureClearCurrent();
+}
+
+bool VideoPlayer::BuildVideoSink() {
+  if (decoder_index_ >= decoder_factories_.size()) {
+    return false;
+  }
+  GstElementFactory* factory = decoder_factories_[decoder_index_];
+  SPDLOG_DEBUG("[VideoPlayer] decoder: {}",
+               gst_plugin_feature_get_name(GST_PLUGIN_FEATURE(factory)));
+
+  sink_ = gst_element_factory_make("appsink", nullptr);
   assert(sink_);
   g_object_set(sink_, "sync", TRUE, nullptr);
-  g_object_set(sink_, "signal-handoffs", TRUE, nullptr);
-  g_object_set(sink_, "can-activate-pull", TRUE, nullptr);
-  handoff_handler_id_ = g_signal_connect(
-      sink_, "handoff", reinterpret_cast<GCallback>(handoff_handler), this);
+  g_object_set(sink_, "qos", TRUE, nullptr);
+  // Let appsink drop the oldest buffer instead of blocking the decoder when
+  // the compositor falls behind.
+  gst_app_sink_set_max_buffers(GST_APP_SINK(sink_), kFrameQueueDepth);
+  gst_app_sink_set_drop(GST_APP_SINK(sink_), TRUE);
+  GstAppSinkCallbacks callbacks{};
+  callbacks.new_sample = OnNewSample;
+  gst_app_sink_set_callbacks(GST_APP_SINK(sink_), &callbacks, this, nullptr);
+
+  decoder_ = gst_element_factory_create(factory, "decoder");
+  if (decoder_ == nullptr) {
+    SPDLOG_ERROR("[VideoPlayer] Failed to create decoder");
+    gst_object_unref(sink_);
+    sink_ = nullptr;
+    return false;
+  }
 
-  decoder_ = gst_element_factory_create(decoder_factory, "decoder");
-  assert(decoder_);
+  pipeline_ = gst_bin_new(nullptr);
+  gst_bin_add_many(reinterpret_cast<GstBin*>(pipeline_), decoder_, sink_,
+                   nullptr);
+  video_convert_ = nullptr;
+  video_scale_ = nullptr;
+
+  bool use_dmabuf = !force_convert_ && dmabuf_importer_ &&
+                    dmabuf_importer_->is_supported() &&
+                    dmabuf::factory_supports_dmabuf(factory);
+  if (use_dmabuf) {
+    // Decoder output is handed to the sink untouched and imported as an
+    // EGLImage.  Scaling to the texture size happens when drawing to the FBO.
+    GstCaps* dmabuf_caps = gst_caps_new_simple("video/x-raw", "format",
+                                               G_TYPE_STRING, "NV12", nullptr);
+    gst_caps_set_features(
+        dmabuf_caps, 0,
+        gst_caps_features_new(dmabuf::kCapsFeatureMemoryDmaBuf, nullptr));
+    if (!gst_element_link_filtered(decoder_, sink_, dmabuf_caps)) {
+      SPDLOG_ERROR(
+          "[VideoPlayer] Failed to link decoder with appsink using DMA-BUF "
+          "filter");
+      use_dmabuf = false;
+    }
+    gst_caps_unref(dmabuf_caps);
+  }
 
-  video_convert_ = gst_element_factory_make("videoconvert", nullptr);
-  assert(video_convert_);
+  GstCaps* target =
+      gst_caps_new_simple("video/x-raw", "format", G_TYPE_STRING, "NV12",
+                          "width", G_TYPE_INT, width_, "height", G_TYPE_INT,
+                          height_, nullptr);
+  converting_ = false;
+  if (!use_dmabuf && !force_convert_ && DecoderRegistry::OutputsNV12(factory)) {
+    // The decoder already produces NV12 at the stream size, so conversion
+    // and scaling would be pass-through.
+    if (!gst_element_link_filtered(decoder_, sink_, target)) {
+      SPDLOG_DEBUG("[VideoPlayer] Decoder cannot link NV12 directly");
+      converting_ = true;
+    }
+  } else if (!use_dmabuf) {
+    converting_ = true;
+  }
 
-  GstCaps* caps = gst_caps_new_simple("video/x-raw", "format", G_TYPE_STRING,
-                                      "NV12", nullptr);
+  if (converting_) {
+    video_convert_ = gst_element_factory_make("videoconvert", nullptr);
+    assert(video_convert_);
 
-  video_scale_ = gst_element_factory_make("videoscale", nullptr);
-  assert(video_scale_);
+    GstCaps* caps = gst_caps_new_simple("video/x-raw", "format", G_TYPE_STRING,
+                                        "NV12", nullptr);
 
-  GstCaps* scale =
-      gst_caps_new_simple("video/x-raw", "width", G_TYPE_INT, width_, "height",
-                          G_TYPE_INT, height_, nullptr);
+    video_scale_ = gst_element_factory_make("videoscale", nullptr);
+    assert(video_scale_);
 
-  pipeline_ = gst_bin_new(nullptr);
+    gst_bin_add_many(reinterpret_cast<GstBin*>(pipeline_), video_convert_,
+                     video_scale_, nullptr);
+    if (!gst_element_link(decoder_, video_convert_)) {
+      SPDLOG_ERROR("[VideoPlayer] Failed to link decoder with videoconvert");
+    }
 
-  gst_bin_add_many(reinterpret_cast<GstBin*>(pipeline_), decoder_,
-                   video_convert_, video_scale_, sink_, nullptr);
-  if (!gst_element_link(decoder_, video_convert_)) {
-    SPDLOG_ERROR("[VideoPlayer] Failed to link decoder with videoconvert");
-  }
+    if (!gst_element_link_filtered(video_convert_, video_scale_, caps)) {
+      SPDLOG_ERROR(
+          "[VideoPlayer] Failed to link videoconvert with videoscale using "
+          "filter");
+    }
+    gst_caps_unref(caps);
 
-  if (!gst_element_link_filtered(video_convert_, video_scale_, caps)) {
-    SPDLOG_ERROR(
-        "[VideoPlayer] Failed to link videoconvert with videoscale using "
-        "filter");
+    if (!gst_element_link_filtered(video_scale_, sink_, target)) {
+      SPDLOG_ERROR(
+          "[VideoPlayer] Failed to link videoscale with appsink using "
+          "filter");
+    }
   }
+  gst_caps_unref(target);
+  SPDLOG_DEBUG("[VideoPlayer] DMA-BUF import: {}, convert: {}", use_dmabuf,
+               converting_);
 
-  gst_caps_unref(caps);
+  {
+    std::lock_guard lock(gst_mutex_);
+    use_dmabuf_ = use_dmabuf;
+  }
 
   GstPad* pad = gst_element_get_static_pad(decoder_, "sink");
   if (gst_pad_is_linked(pad)) {
     SPDLOG_ERROR("[VideoPlayer] already linked, ignore");
-    return;
+    gst_object_unref(pad);
+    return false;
   }
   GstPad* ghost_pad = gst_ghost_pad_new("sink", pad);
   gst_pad_set_active(ghost_pad, TRUE);
   gst_element_add_pad(pipeline_, ghost_pad);
   gst_object_unref(pad);
 
-  if (!gst_element_link_filtered(video_scale_, sink_, scale)) {
-    SPDLOG_ERROR(
-        "[VideoPlayer] Failed to link videoscale with fakesink using filter");
+  g_object_set(playbin_, "video-sink", pipeline_, nullptr);
+  return true;
+}
+
+bool VideoPlayer::FeedsDecoder(GstPad* pad,
+                               GstElement* decoder,
+                               const int depth) {
+  GstPad* peer = gst_pad_get_peer(pad);
+  if (peer == nullptr) {
+    return false;
+  }
+  bool feeds = false;
+  if (GstElement* parent = gst_pad_get_parent_element(peer)) {
+    feeds = parent == decoder;
+    gst_object_unref(parent);
+  }
+  if (!feeds && depth > 0) {
+    GstIterator* it = gst_pad_iterate_internal_links(peer);
+    GValue item = G_VALUE_INIT;
+    bool done = it == nullptr;
+    while (!done && !feeds) {
+      switch (gst_iterator_next(it, &item)) {
+        case GST_ITERATOR_OK:
+          feeds = FeedsDecoder(GST_PAD(g_value_get_object(&item)), decoder,
+                               depth - 1);
+          g_value_reset(&item);
+          break;
+        case GST_ITERATOR_RESYNC:
+          gst_iterator_resync(it);
+          break;
+        default:
+          done = true;
+          break;
+      }
+    }
+    g_value_unset(&item);
+    if (it != nullptr) {
+      gst_iterator_free(it);
+    }
   }
-  gst_caps_unref(scale);
+  gst_object_unref(peer);
+  return feeds;
+}
 
-  g_object_set(playbin_, "video-sink", pipeline_, nullptr);
+bool VideoPlayer::IsDecodeError(GstMessage* msg) {
+  GError* err;
+  gchar* debug_info;
+  gst_message_parse_error(msg, &err, &debug_info);
+  bool decode_error =
+      g_error_matches(err, GST_CORE_ERROR, GST_CORE_ERROR_NEGOTIATION) ||
+      g_error_matches(err, GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE) ||
+      g_error_matches(err, GST_STREAM_ERROR, GST_STREAM_ERROR_FORMAT) ||
+      g_error_matches(err, GST_STREAM_ERROR,
+                      GST_STREAM_ERROR_CODEC_NOT_FOUND);
+  // "Internal data stream error" from a demuxer or parser whose push was
+  // refused downstream.
+  if (!decode_error &&
+      g_error_matches(err, GST_STREAM_ERROR, GST_STREAM_ERROR_FAILED)) {
+    const GstStructure* details = nullptr;
+    gint flow_return;
+    gst_message_parse_error_details(msg, &details);
+    if (details != nullptr &&
+        gst_structure_get_int(details, "flow-return", &flow_return)) {
+      decode_error = flow_return == GST_FLOW_NOT_NEGOTIATED;
+    } else {
+      decode_error = debug_info != nullptr &&
+                     g_strrstr(debug_info, "not-negotiated") != nullptr;
+    }
+  }
+  g_clear_error(&err);
+  g_free(debug_info);
+  return decode_error;
+}
 
-  bus_ = gst_element_get_bus(playbin_);
-  GSource* bus_source = gst_bus_create_watch(bus_);
-  g_source_set_callback(
-      bus_source, reinterpret_cast<GSourceFunc>(gst_bus_async_signal_func),
-      nullptr, nullptr);
-  g_source_attach(bus_source, context_);
-  g_source_unref(bus_source);
-  on_bus_msg_id_ = g_signal_connect(
-      bus_, "message", reinterpret_cast<GCallback>(OnBusMessage), this);
+bool VideoPlayer::TryNextDecoder(GstMessage* msg) {
+  // Another decoder only helps with the decoder's own errors, which wrapper
+  // decoders such as decodebin post from their children, and with decode or
+  // negotiation errors posted by the demuxers and parsers feeding it.
+  // Sources, network and the audio branch are not the decoder's fault.
+  static constexpr int kMaxUpstreamDepth = 32;
+  GstObject* src = GST_MESSAGE_SRC(msg);
+  if (decoder_ == nullptr || src == nullptr) {
+    return false;
+  }
+  if (src != GST_OBJECT(decoder_) &&
+      !gst_object_has_as_ancestor(src, GST_OBJECT(decoder_))) {
+    if (!GST_IS_ELEMENT(src) || !IsDecodeError(msg)) {
+      return false;
+    }
+    bool upstream = false;
+    GstIterator* it = gst_element_iterate_src_pads(GST_ELEMENT(src));
+    GValue item = G_VALUE_INIT;
+    bool done = false;
+    while (!done && !upstream) {
+      switch (gst_iterator_next(it, &item)) {
+        case GST_ITERATOR_OK:
+          upstream = FeedsDecoder(GST_PAD(g_value_get_object(&item)),
+                                  decoder_, kMaxUpstreamDepth);
+          g_value_reset(&item);
+          break;
+        case GST_ITERATOR_RESYNC:
+          gst_iterator_resync(it);
+          break;
+        default:
+          done = true;
+          break;
+      }
+    }
+    g_value_unset(&item);
+    gst_iterator_free(it);
+    if (!upstream) {
+      return false;
+    }
+  }
 
-  m_registrar->texture_registrar()->TextureClearCurrent();
+  if (!converting_) {
+    // Retry the same decoder with the conversion path first.
+    force_convert_ = true;
+  } else if (decoder_index_ + 1 < decoder_factories_.size()) {
+    decoder_index_++;
+    force_convert_ = false;
+  } else {
+    return false;
+  }
+  spdlog::warn("[VideoPlayer] Falling back to {}{}",
+               gst_plugin_feature_get_name(
+                   GST_PLUGIN_FEATURE(decoder_factories_[decoder_index_])),
+               force_convert_ ? " with conversion" : "");
+
+  // Resumed from here once the rebuilt pipeline has prerolled.
+  gint64 position;
+  if (gst_element_query_position(playbin_, GST_FORMAT_TIME, &position) &&
+      position > 0) {
+    resume_position_ = position;
+  }
+
+  gst_element_set_state(playbin_, GST_STATE_NULL);
+  GstAppSinkCallbacks callbacks{};
+  gst_app_sink_set_callbacks(GST_APP_SINK(sink_), &callbacks, nullptr,
+                             nullptr);
+  {
+    std::lock_guard lock(frame_queue_mutex_);
+    ClearFrameQueue();
+  }
+  if (!BuildVideoSink()) {
+    return false;
+  }
+  gst_element_set_state(playbin_, target_state_);
+  return true;
 }
 
 void VideoPlayer::OnMediaError(GstMessage* msg) {
@@ -199,6 +424,26 @@ void VideoPlayer::OnMediaError(GstMessage* msg) {
   g_clear_error(&err);
 }
 
+void VideoPlayer::OnQos(GstMessage* msg) {
+  // The audio sink and the decoders post QoS as well.
+  if (GST_MESSAGE_SRC(msg) != GST_OBJECT(sink_)) {
+    return;
+  }
+  GstFormat format;
+  guint64 processed;
+  guint64 dropped;
+  gst_message_parse_qos_stats(msg, &format, &processed, &dropped);
+  gint64 jitter;
+  gdouble proportion;
+  gint quality;
+  gst_message_parse_qos_values(msg, &jitter, &proportion, &quality);
+  if (format == GST_FORMAT_BUFFERS || format == GST_FORMAT_DEFAULT) {
+    stats_.RecordQos(dropped, jitter > 0);
+  }
+  SPDLOG_TRACE("[VideoPlayer] QoS processed: {}, dropped: {}, jitter: {}",
+               processed, dropped, jitter);
+}
+
 void VideoPlayer::OnMediaDurationChange() {
   GstQuery* query = gst_query_new_duration(GST_FORMAT_TIME);
   if (gst_element_query(playbin_, query)) {
@@ -214,6 +459,9 @@ gboolean VideoPlayer::OnBusMessage(GstBus* bus,
   switch (GST_MESSAGE_TYPE(msg)) {
     case GST_MESSAGE_ERROR:
       OnMediaError(msg);
+      if (obj->TryNextDecoder(msg)) {
+        break;
+      }
       gst_object_unref(bus);
       return FALSE;
     case GST_MESSAGE_EOS: {
@@ -252,6 +500,10 @@ gboolean VideoPlayer::OnBusMessage(GstBus* bus,
       break;
     }
 #endif
+    case GST_MESSAGE_QOS: {
+      obj->OnQos(msg);
+      break;
+    }
     case GST_MESSAGE_WARNING: {
       spdlog::warn("[VideoPlayer] Warning");
       break;
@@ -259,6 +511,17 @@ gboolean VideoPlayer::OnBusMessage(GstBus* bus,
     case GST_MESSAGE_ASYNC_DONE: {
       SPDLOG_DEBUG("[VideoPlayer] Async Done");
       // bufferingEnd
+      if (obj->resume_position_ > 0) {
+        const gint64 position = obj->resume_position_;
+        obj->resume_position_ = 0;
+        if (!gst_element_seek_simple(
+                obj->playbin_, GST_FORMAT_TIME,
+                static_cast<GstSeekFlags>(GST_SEEK_FLAG_FLUSH |
+                                          GST_SEEK_FLAG_ACCURATE),
+                position)) {
+          SPDLOG_ERROR("[VideoPlayer] Resume after decoder fallback failed");
+        }
+      }
       break;
     }
     case GST_MESSAGE_NEW_CLOCK: {
@@ -411,43 +674,108 @@ void VideoPlayer::OnTag(const GstTagList* list,
   }
 }
 
-void VideoPlayer::handoff_handler(GstElement* /* fakesink */,
-                                  GstBuffer* buffer,
-                                  GstPad* /* pad */,
-                                  void* user_data) {
+GstFlowReturn VideoPlayer::OnNewSample(GstAppSink* appsink,
+                                       gpointer user_data) {
   const auto obj = static_cast<VideoPlayer*>(user_data);
-  if (!obj->is_initialized_ || obj->info_.finfo == nullptr) {
+  GstSample* sample = gst_app_sink_pull_sample(appsink);
+  if (sample == nullptr) {
+    return GST_FLOW_EOS;
+  }
+  if (!obj->is_initialized_) {
+    gst_sample_unref(sample);
+    return GST_FLOW_OK;
+  }
+
+  {
+    std::lock_guard lock(obj->frame_queue_mutex_);
+    size_t dropped = 0;
+    while (obj->frame_queue_.size() >= kFrameQueueDepth) {
+      gst_sample_unref(obj->frame_queue_.front().sample);
+      obj->frame_queue_.pop_front();
+      dropped++;
+    }
+    obj->frame_queue_.push_back({sample, FrameStats::Clock::now()});
+    obj->stats_.RecordQueued(obj->frame_queue_.size(), dropped);
+  }
+
+  // Conversion is deferred until Flutter asks for the texture.
+  obj->m_registrar->texture_registrar()->MarkTextureFrameAvailable(
+      obj->m_texture_id);
+  return GST_FLOW_OK;
+}
+
+const FlutterDesktopGpuSurfaceDescriptor* VideoPlayer::ObtainDescriptor() {
+  QueuedFrame frame{};
+  {
+    // Latest frame wins; anything older would never be presented.
+    std::lock_guard lock(frame_queue_mutex_);
+    if (!frame_queue_.empty()) {
+      frame = frame_queue_.back();
+      frame_queue_.pop_back();
+      stats_.RecordSkipped(frame_queue_.size());
+      ClearFrameQueue();
+    }
+  }
+
+  if (frame.sample != nullptr) {
+    std::lock_guard lock(gst_mutex_);
+    if (shader_ && info_.finfo != nullptr) {
+      const auto upload_start = FrameStats::Clock::now();
+      RenderFrame(gst_sample_get_buffer(frame.sample));
+      stats_.RecordPresented(frame.queued_at, upload_start,
+                             FrameStats::Clock::now());
+    }
+    gst_sample_unref(frame.sample);
+  }
+  return &m_descriptor;
+}
+
+void VideoPlayer::ClearFrameQueue() {
+  for (const auto& [sample, queued_at] : frame_queue_) {
+    gst_sample_unref(sample);
+  }
+  frame_queue_.clear();
+}
+
+void VideoPlayer::RenderFrame(GstBuffer* buffer) {
+  // Runs on the raster thread; hand the engine's context back when done.
+  const plugin_common_egl::ContextGuard context_guard;
+  m_registrar->texture_registrar()->TextureMakeCurrent();
+  glBindVertexArray(shader_->vertex_arr_id_);
+
+  if (use_dmabuf_) {
+    if (dmabuf::Importer::is_dmabuf(buffer) &&
+        dmabuf_importer_->import(buffer, &info_)) {
+      shader_->draw_external(dmabuf_importer_->texture());
+      dmabuf_importer_->release_image();
+      SPDLOG_TRACE("[VideoPlayer] dmabuf frame");
+    } else {
+      SPDLOG_ERROR("[VideoPlayer] Cannot import DMA-BUF video frame");
+    }
     return;
   }
 
-  std::lock_guard lock(obj->gst_mutex_);
   GstVideoFrame frame;
-  if (gst_video_frame_map(&frame, &obj->info_, buffer, GST_MAP_READ)) {
-    obj->m_registrar->texture_registrar()->TextureMakeCurrent();
-    glBindVertexArray(obj->shader_->vertex_arr_id_);
+  if (gst_video_frame_map(&frame, &info_, buffer, GST_MAP_READ)) {
     glClear(GL_COLOR_BUFFER_BIT);
 
-    if (const guint n_planes = GST_VIDEO_INFO_N_PLANES(&obj->info_);
+    if (const guint n_planes = GST_VIDEO_INFO_N_PLANES(&info_);
         n_planes == 2) {
       // Assume NV12
-      obj->shader_->load_pixels(GST_VIDEO_FRAME_PLANE_DATA(&frame, 0),
-                                GST_VIDEO_FRAME_PLANE_DATA(&frame, 1),
-                                GST_VIDEO_FRAME_COMP_PSTRIDE(&frame, 0),
-                                GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 0),
-                                GST_VIDEO_FRAME_COMP_PSTRIDE(&frame, 1),
-                                GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 1));
+      shader_->load_pixels(GST_VIDEO_FRAME_PLANE_DATA(&frame, 0),
+                           GST_VIDEO_FRAME_PLANE_DATA(&frame, 1),
+                           GST_VIDEO_FRAME_COMP_PSTRIDE(&frame, 0),
+                           GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 0),
+                           GST_VIDEO_FRAME_COMP_PSTRIDE(&frame, 1),
+                           GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 1));
     } else {
       // Assume RGB
-      obj->shader_->load_rgb_pixels(GST_VIDEO_FRAME_PLANE_DATA(&frame, 0));
+      shader_->load_rgb_pixels(GST_VIDEO_FRAME_PLANE_DATA(&frame, 0));
     }
     gst_video_frame_unmap(&frame);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, obj->shader_->framebuffer);
-    obj->shader_->draw_core();
-
-    obj->m_registrar->texture_registrar()->TextureClearCurrent();
-    obj->m_registrar->texture_registrar()->MarkTextureFrameAvailable(
-        obj->m_texture_id);
+    glBindFramebuffer(GL_FRAMEBUFFER, shader_->framebuffer);
+    shader_->draw_core();
     SPDLOG_TRACE("[VideoPlayer] frame");
   } else {
     SPDLOG_ERROR("[VideoPlayer] Cannot read video frame out from buffer");
@@ -483,6 +811,9 @@ void VideoPlayer::Init(flutter::BinaryMessenger* messenger) {
 
 VideoPlayer::~VideoPlayer() {
   m_valid = false;
+  for (const auto factory : decoder_factories_) {
+    gst_object_unref(factory);
+  }
 }
 
 bool VideoPlayer::IsValid() {
@@ -558,11 +889,21 @@ void VideoPlayer::Dispose() {
   }
 
   g_signal_handler_disconnect(G_OBJECT(bus_), on_bus_msg_id_);
-  g_signal_handler_disconnect(G_OBJECT(sink_), handoff_handler_id_);
+  GstAppSinkCallbacks callbacks{};
+  gst_app_sink_set_callbacks(GST_APP_SINK(sink_), &callbacks, nullptr,
+                             nullptr);
+  {
+    std::lock_guard lock(frame_queue_mutex_);
+    ClearFrameQueue();
+  }
 
-  m_registrar->texture_registrar()->TextureMakeCurrent();
-  shader_.reset();
-  m_registrar->texture_registrar()->TextureClearCurrent();
+  {
+    std::lock_guard lock(gst_mutex_);
+    m_registrar->texture_registrar()->TextureMakeCurrent();
+    dmabuf_importer_.reset();
+    shader_.reset();
+    m_registrar->texture_registrar()->TextureClearCurrent();
+  }
 
   m_registrar->texture_registrar()->UnregisterTexture(m_texture_id);
 
@@ -692,10 +1033,21 @@ void VideoPlayer::prepare(VideoPlayer* user_data) {
   }
   SPDLOG_DEBUG("[VideoPlayer] original video width: {}, height: {}",
                user_data->info_.width, user_data->info_.height);
-  // set to the target
-  if (!gst_video_info_set_format(&user_data->info_, GST_VIDEO_FORMAT_NV12,
-                                 static_cast<guint>(user_data->width_),
-                                 static_cast<guint>(user_data->height_))) {
+  if (user_data->use_dmabuf_) {
+    // The decoder output is imported as is; use the negotiated layout.
+    GstPad* sink_pad = gst_element_get_static_pad(user_data->sink_, "sink");
+    if (GstCaps* sink_caps = gst_pad_get_current_caps(sink_pad)) {
+      if (!gst_video_info_from_caps(&user_data->info_, sink_caps)) {
+        SPDLOG_ERROR("[VideoPlayer] Fail to get video info from sink caps");
+      }
+      gst_caps_unref(sink_caps);
+    }
+    gst_object_unref(sink_pad);
+  } else if (!gst_video_info_set_format(
+                 &user_data->info_, GST_VIDEO_FORMAT_NV12,
+                 static_cast<guint>(user_data->width_),
+                 static_cast<guint>(user_data->height_))) {
+    // set to the target
     SPDLOG_ERROR("[VideoPlayer] Failed to set the video info to target NV12");
   }
   user_data->is_initialized_ = true;
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <deque>
 #include <functional>
 #include <future>
 #include <map>
@@ -23,6 +24,7 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <flutter/event_channel.h>
 #include <flutter/event_stream_handler.h>
@@ -30,9 +32,12 @@
 #include <flutter/plugin_registrar_homescreen.h>
 #include <flutter/standard_method_codec.h>
 
+#include "dmabuf.h"
+#include "frame_stats.h"
 #include "nv12.h"
 
 extern "C" {
+#include <gst/app/gstappsink.h>
 #include <gst/gst.h>
 #include <gst/video/video.h>
 #include <libavformat/avformat.h>
@@ -52,7 +57,8 @@ class VideoPlayer {
               GLsizei width,
               GLsizei height,
               gint64 duration,
-              GstElementFactory* decoder_factory);
+              std::vector<GstElementFactory*> decoder_factories,
+              std::shared_ptr<nv12::ShaderPool> shader_pool);
   ~VideoPlayer();
 
   void Dispose();
@@ -66,6 +72,7 @@ class VideoPlayer {
   void SeekTo(int64_t seek);
   int64_t GetTextureId() const { return m_texture_id; };
   bool IsValid();
+  flutter::EncodableMap GetStats() const { return stats_.ToEncodableMap(); }
 
   // Initializes the video player.
   void Init(flutter::BinaryMessenger* messenger);
@@ -77,7 +84,14 @@ class VideoPlayer {
   GLsizei width_{};
   GLsizei height_{};
   gint64 duration_{};
-  GstElementFactory* decoder_factory_;
+  // Candidate decoders, best first.  A reference is held on each.
+  std::vector<GstElementFactory*> decoder_factories_;
+  size_t decoder_index_{};
+  bool force_convert_{};
+  // Playback position to seek back to after a decoder fallback, 0 if none.
+  gint64 resume_position_{};
+  bool converting_{};
+  std::shared_ptr<nv12::ShaderPool> shader_pool_;
 
   GLuint m_texture_id{};
   std::atomic<bool> m_valid = true;
@@ -101,7 +115,6 @@ class VideoPlayer {
   gdouble rate_ = 0.0;
   GstBus* bus_{};
 
-  gulong handoff_handler_id_;
   gulong on_bus_msg_id_;
 
   GstState target_state_ = GST_STATE_PAUSED;
@@ -111,6 +124,8 @@ class VideoPlayer {
   gint n_video_{};
   gint current_video_{};
   std::unique_ptr<nv12::Shader> shader_;
+  std::unique_ptr<dmabuf::Importer> dmabuf_importer_;
+  bool use_dmabuf_{};
   bool is_looping_{};
   bool is_buffering_{};
   gboolean is_live_{};
@@ -119,6 +134,20 @@ class VideoPlayer {
 
   std::mutex gst_mutex_;
 
+  // Maximum number of decoded frames held between the streaming thread and
+  // the texture callback.  Older frames are dropped first.
+  static constexpr guint kFrameQueueDepth = 2;
+
+  struct QueuedFrame {
+    GstSample* sample;
+    FrameStats::Clock::time_point queued_at;
+  };
+
+  std::mutex frame_queue_mutex_;
+  std::deque<QueuedFrame> frame_queue_;
+
+  FrameStats stats_;
+
   bool is_initialized_ = false;
   void SetBuffering(bool buffering) const;
 
@@ -158,19 +187,99 @@ class VideoPlayer {
   bool EnsureTextureCreated(uint32_t width, uint32_t height);
 
   /**
-   * @brief Callback called when fakesink receives new frame data
-   * @param[in] fakesink No use
-   * @param[in] buffer Pointer to New frame data
-   * @param[in] pad No use
-   * @param[in,out] _data Pointer to User data
+   * @brief Callback called when appsink receives new frame data.  Queues the
+   * sample and signals Flutter; no GL work is done on the streaming thread.
+   * @param[in] appsink Sink holding the new sample
+   * @param[in,out] user_data Pointer to User data
+   * @return GstFlowReturn
+   * @relation
+   * gstreamer
+   */
+  static GstFlowReturn OnNewSample(GstAppSink* appsink, gpointer user_data);
+
+  /**
+   * @brief Texture callback.  Converts the most recent queued frame, if any,
+   * and discards the older ones.
+   * @return const FlutterDesktopGpuSurfaceDescriptor*
+   * @relation
+   * flutter
+   */
+  const FlutterDesktopGpuSurfaceDescriptor* ObtainDescriptor();
+
+  /**
+   * @brief Release all queued samples.  frame_queue_mutex_ must be held.
+   * @return void
+   * @relation
+   * gstreamer
+   */
+  void ClearFrameQueue();
+
+  /**
+   * @brief Convert a decoded frame into the Flutter texture
+   * @param[in] buffer Frame buffer
    * @return void
    * @relation
    * flutter
    */
-  static void handoff_handler(GstElement* fakesink,
-                              GstBuffer* buffer,
-                              GstPad* pad,
-                              void* user_data);
+  void RenderFrame(GstBuffer* buffer);
+
+  /**
+   * @brief Record sink QoS statistics.  Messages from elements other than
+   * the video appsink are ignored.
+   * @param[in] msg QoS message
+   * @return void
+   * @relation
+   * gstreamer
+   */
+  void OnQos(GstMessage* msg);
+
+  /**
+   * @brief Build the video sink bin for the current decoder candidate and
+   * set it on playbin.  videoconvert/videoscale are only added when the
+   * decoder cannot output NV12 at the target size itself.
+   * @return bool
+   * @retval true Normal end
+   * @retval false Abnormal end
+   * @relation
+   * gstreamer
+   */
+  bool BuildVideoSink();
+
+  /**
+   * @brief Rebuild the video sink with the next candidate after an error
+   * posted by the current decoder or one of its children, or a decode or
+   * negotiation error posted upstream of it.  Playback resumes from the
+   * position it failed at.
+   * @param[in] msg Error message
+   * @return bool
+   * @retval true Pipeline restarted with a fallback
+   * @retval false No fallback left or error not caused by the decoder
+   * @relation
+   * gstreamer
+   */
+  bool TryNextDecoder(GstMessage* msg);
+
+  /**
+   * @brief Whether data leaving pad reaches decoder, following ghost pads
+   * and the internal links of elements such as multiqueue
+   * @param[in] pad Source pad
+   * @param[in] decoder Current video decoder
+   * @param[in] depth Elements left to walk
+   * @return bool
+   * @relation
+   * gstreamer
+   */
+  static bool FeedsDecoder(GstPad* pad, GstElement* decoder, int depth);
+
+  /**
+   * @brief Whether an error is one a different decoder could avoid: caps
+   * negotiation or undecodable data
+   * @param[in] msg Error message
+   * @return bool
+   * @relation
+   * gstreamer
+   */
+  static bool IsDecodeError(GstMessage* msg);
 
   static gboolean OnBusMessage(GstBus* bus, GstMessage* msg, void* user_data);
 
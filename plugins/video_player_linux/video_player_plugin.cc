@@ -39,10 +39,17 @@ void VideoPlayerPlugin::RegisterWithRegistrar(
   registrar->AddPlugin(std::move(plugin));
 }
 
-VideoPlayerPlugin::~VideoPlayerPlugin() = default;
+VideoPlayerPlugin::~VideoPlayerPlugin() {
+  // Players return their surfaces to the pool; free everything in context.
+  registrar_->texture_registrar()->TextureMakeCurrent();
+  videoPlayers.clear();
+  shader_pool_.reset();
+  registrar_->texture_registrar()->TextureClearCurrent();
+}
 
 VideoPlayerPlugin::VideoPlayerPlugin(flutter::PluginRegistrarDesktop* registrar)
-    : registrar_(registrar) {
+    : registrar_(registrar),
+      shader_pool_(std::make_shared<nv12::ShaderPool>()) {
   // GStreamer lib only needs to be initialized once.  Calling it multiple times
   // is fine.
   gst_init(nullptr, nullptr);
@@ -50,6 +57,8 @@ VideoPlayerPlugin::VideoPlayerPlugin(flutter::PluginRegistrarDesktop* registrar)
   // start the main loop if not already running
   plugin_common_glib::MainLoop::GetInstance();
 
+  decoder_registry_.Probe(map_ffmpeg_plugin);
+
   // supress libavformat logging
   av_log_set_callback([](void* /* avcl */, int /* level */,
                          const char* /* fmt */, va_list /* vl */) {});
@@ -107,27 +116,23 @@ ErrorOr<int64_t> VideoPlayerPlugin::Create(
     // Get stream information
     int width, height;
     gint64 duration;
-    AVCodecID codec_id;
+    AVCodecID codec_id = AV_CODEC_ID_NONE;
     if (!get_video_info(asset_to_load.c_str(), width, height, duration,
                         codec_id)) {
       spdlog::error("Failed to get video info");
     }
 
-    const auto gst_codec = map_ffmpeg_plugin(codec_id);
-    if (!gst_codec[0]) {
-      spdlog::critical("[VideoPlayer] Failed to find codec: {}", gst_codec);
-    }
-    const auto decoder_factory = gst_element_factory_find(gst_codec);
-    if (decoder_factory == nullptr) {
-      spdlog::error(
-          "[VideoPlayer] Failed to find decoder: {}.  May be a missing "
-          "runtime package",
-          gst_codec);
+    auto decoders =
+        decoder_registry_.GetDecoders(codec_id, map_ffmpeg_plugin(codec_id));
+    if (decoders.empty()) {
+      return FlutterError("decoder_not_found",
+                          "No usable decoder.  May be a missing runtime "
+                          "package");
     }
 
-    player = std::make_unique<VideoPlayer>(registrar_, asset_to_load.c_str(),
-                                           std::move(http_headers_), width,
-                                           height, duration, decoder_factory);
+    player = std::make_unique<VideoPlayer>(
+        registrar_, asset_to_load.c_str(), std::move(http_headers_), width,
+        height, duration, std::move(decoders), shader_pool_);
 
   } catch (std::exception& e) {
     return FlutterError("uri_load_failed", e.what());
@@ -248,6 +253,15 @@ std::optional<FlutterError> VideoPlayerPlugin::Pause(const int64_t texture_id) {
   return std::nullopt;
 }
 
+ErrorOr<flutter::EncodableMap> VideoPlayerPlugin::GetStats(
+    const int64_t texture_id) {
+  const auto searchPlayer = videoPlayers.find(texture_id);
+  if (searchPlayer == videoPlayers.end()) {
+    return FlutterError("player_not_found", "This player ID was not found");
+  }
+  return searchPlayer->second->GetStats();
+}
+
 bool VideoPlayerPlugin::get_video_info(const char* url,
                                        int& width,
                                        int& height,
@@ -21,6 +21,7 @@
 #include <flutter/plugin_registrar_homescreen.h>
 
 #include "flutter_desktop_plugin_registrar.h"
+#include "decoder_registry.h"
 #include "messages.g.h"
 #include "video_player.h"
 
@@ -57,6 +58,7 @@ class VideoPlayerPlugin final : public flutter::Plugin, public VideoPlayerApi {
   std::optional<FlutterError> SeekTo(int64_t texture_id,
                                      int64_t position) override;
   std::optional<FlutterError> Pause(int64_t texture_id) override;
+  ErrorOr<flutter::EncodableMap> GetStats(int64_t texture_id) override;
 
  private:
   // A list of all the video players instantiated by this plugin.
@@ -64,6 +66,12 @@ class VideoPlayerPlugin final : public flutter::Plugin, public VideoPlayerApi {
 
   flutter::PluginRegistrarDesktop* registrar_{};
 
+  // Ranked decoders per codec, probed once.
+  DecoderRegistry decoder_registry_;
+
+  // GL program and surfaces shared by all players of this registrar.
+  std::shared_ptr<nv12::ShaderPool> shader_pool_;
+
   /**
    * @brief Get video info
    * @param[in] url URL of the stream